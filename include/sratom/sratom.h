@@ -13,7 +13,9 @@
 #include <sord/sord.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #if defined(_WIN32) && !defined(SRATOM_STATIC) && defined(SRATOM_INTERNAL)
 #  define SRATOM_API __declspec(dllexport)
@@ -34,9 +36,30 @@ extern "C" {
    @{
 */
 
-/// Atom serializer
+/**
+   Atom serializer.
+
+   Once configured, a serializer may be shared between threads, and used by
+   several of them at once to read or write, provided that the URID map and
+   unmap and the sink are thread-safe.  The functions that configure the
+   serializer, including sratom_bind_world(), are not thread-safe and must
+   not be called while it is in use.
+
+   Reading from a model changes some internal state of the model and its
+   world, which the serializer protects with a lock.  So, threads may read
+   from the same model at once only if they share a serializer, and nothing
+   else may use the model or its world while they do.
+*/
 typedef struct SratomImpl Sratom;
 
+/**
+   Reader for atoms in Turtle strings.
+
+   A reader may only be used by one thread at a time, but several readers may
+   use the same serializer concurrently.
+*/
+typedef struct SratomReaderImpl SratomReader;
+
 /**
    Mode for reading resources to LV2 Objects.
 
@@ -62,6 +85,72 @@ typedef enum {
   SRATOM_OBJECT_MODE_BLANK_SUBJECT
 } SratomObjectMode;
 
+/**
+   Encoding for writing the elements of vectors.
+
+   Vectors are written as an RDF collection by default, which is the most
+   readable, but verbose for large vectors.  The other encodings write the
+   elements as a single literal, which is much smaller and faster to read.
+   These are only used for vectors of numbers or booleans, other vectors are
+   always written as collections.  All encodings are supported when reading.
+*/
+typedef enum {
+  /// Write elements as an RDF collection with a literal for each element
+  SRATOM_VECTOR_ENCODING_LIST,
+
+  /// Write elements as a single literal with space-separated values
+  SRATOM_VECTOR_ENCODING_TEXT,
+
+  /**
+     Write elements as a single base64Binary literal of the raw body.
+
+     This is the most compact and always exact, but elements are written in
+     native byte order, so the result is only portable between machines with
+     the same endianness.
+  */
+  SRATOM_VECTOR_ENCODING_BASE64
+} SratomVectorEncoding;
+
+/**
+   Encoding for writing the events of sequences.
+
+   Sequences are written as an RDF collection of event nodes by default.  The
+   compact encoding writes all events as a single literal of alternating times
+   and values, which is many times smaller for MIDI recordings and faster to
+   read.  Frame times are written as the difference from the previous event,
+   and beat times are written as is, so they are always read exactly.  It is
+   only used for non-empty sequences where every event is a MIDI event, or
+   every event is a number or boolean of the same type, other sequences are
+   always written as collections.  All encodings are supported when reading.
+*/
+typedef enum {
+  /// Write events as an RDF collection with a node for each event
+  SRATOM_SEQUENCE_ENCODING_LIST,
+
+  /**
+     Write events as a single literal of space-separated times and values.
+
+     The sequence has an atom:childType property with the type of every
+     event, an atom:timeUnit property of units:frame or units:beat, and an
+     rdf:value with the events.  MIDI events are written in hexadecimal, and
+     other values as in SRATOM_VECTOR_ENCODING_TEXT.
+  */
+  SRATOM_SEQUENCE_ENCODING_COMPACT
+} SratomSequenceEncoding;
+
+/**
+   Statistics for the cache of mapped URIs used by sratom_read().
+
+   Every distinct URI node and literal language is mapped to a URID once per
+   call to sratom_read(), and later occurrences are found in the cache.  Calls
+   made while another thread is using the serializer use a temporary cache,
+   and aren't counted.
+*/
+typedef struct {
+  size_t hits;   ///< Number of URIs found in the cache
+  size_t misses; ///< Number of URIs mapped with the URID map
+} SratomCacheStats;
+
 /// Create a new Atom serializer
 SRATOM_API Sratom* SERD_ALLOCATED
 sratom_new(LV2_URID_Map* SERD_NONNULL map);
@@ -73,8 +162,9 @@ sratom_free(Sratom* SERD_NULLABLE sratom);
 /**
    Set the environment for reading or writing Turtle.
 
-   This can be used to set namespace prefixes and a base URI for
-   sratom_to_turtle() and sratom_from_turtle().
+   This can be used to set namespace prefixes for sratom_to_turtle() and
+   sratom_from_turtle().  The environment is only read by those functions and
+   readers, which copy it, so prefixes defined in documents aren't added to it.
 */
 SRATOM_API void
 sratom_set_env(Sratom* SERD_NONNULL sratom, SerdEnv* SERD_NULLABLE env);
@@ -106,11 +196,26 @@ SRATOM_API void
 sratom_set_object_mode(Sratom* SERD_NONNULL sratom,
                        SratomObjectMode     object_mode);
 
+/// Configure how vector elements will be written (a list by default)
+SRATOM_API void
+sratom_set_vector_encoding(Sratom* SERD_NONNULL sratom,
+                           SratomVectorEncoding vector_encoding);
+
+/// Configure how sequence events will be written (a list by default)
+SRATOM_API void
+sratom_set_sequence_encoding(Sratom* SERD_NONNULL   sratom,
+                             SratomSequenceEncoding sequence_encoding);
+
 /**
    Write an Atom to RDF.
 
    The serialized atom is written to the sink set by sratom_set_sink().
 
+   URIs returned by `unmap` are cached between calls without being copied, so
+   they must remain valid until the serializer is freed, or until
+   sratom_clear_unmap_cache() is called.  The cache is also cleared when a
+   different unmap handle or function is used.
+
    @return 0 on success, or a non-zero error code otherwise.
 */
 SRATOM_API int
@@ -135,10 +240,51 @@ sratom_read(Sratom* SERD_NONNULL         sratom,
             SordModel* SERD_NONNULL      model,
             const SordNode* SERD_NONNULL node);
 
+/**
+   Bind vocabulary nodes to a world for reading.
+
+   The nodes used by sratom_read() are interned in `world` once, rather than
+   on every call.  Reading from other worlds still works, but is slower.  The
+   world must not be freed while it is bound, so sratom_unbind_world() must be
+   called first.  Any previously bound world is unbound.
+*/
+SRATOM_API void
+sratom_bind_world(Sratom* SERD_NONNULL sratom, SordWorld* SERD_NONNULL world);
+
+/**
+   Unbind vocabulary nodes from the bound world, if any.
+
+   This is called by sratom_free(), which must be called while the world still
+   exists if it hasn't been unbound explicitly.
+*/
+SRATOM_API void
+sratom_unbind_world(Sratom* SERD_NONNULL sratom);
+
+/**
+   Clear the cache of URIs returned by unmap when writing.
+
+   This must be called before any URI returned by the unmap used for writing
+   is freed or changed, for example when the URID map is freed or reset.  The
+   cache is flushed at the start of the next write, so this may be called while
+   other threads are writing, but those writes must not use the freed URIs.
+*/
+SRATOM_API void
+sratom_clear_unmap_cache(Sratom* SERD_NONNULL sratom);
+
+/**
+   Return statistics for the URID cache since the serializer was created.
+
+   This is not thread-safe, and must not be called while another thread is
+   reading with the serializer.
+*/
+SRATOM_API SratomCacheStats
+sratom_urid_cache_stats(const Sratom* SERD_NONNULL sratom);
+
 /**
    Serialize an Atom to a Turtle string.
 
-   The returned string must be free()'d by the caller.
+   URIs returned by `unmap` are cached as for sratom_write().  The returned
+   string must be free()'d by the caller.
 */
 SRATOM_API char* SERD_ALLOCATED
 sratom_to_turtle(Sratom* SERD_NONNULL             sratom,
@@ -150,9 +296,146 @@ sratom_to_turtle(Sratom* SERD_NONNULL             sratom,
                  uint32_t                         size,
                  const void* SERD_NONNULL         body);
 
+/**
+   Serialize an Atom to a string in any syntax.
+
+   This is like sratom_to_turtle(), which writes abbreviated Turtle that uses
+   prefixes from the environment, but can also write N-Triples or N-Quads.
+   These are written a statement per line with no abbreviation, which is
+   faster, and the output can be split into lines to parse in parallel.
+   N-Triples output can be read with sratom_from_turtle().
+
+   The returned string must be free()'d by the caller.
+
+   @param sratom The serializer.
+   @param unmap The URID unmap.
+   @param base_uri The base URI, as for sratom_to_turtle().
+   @param subject The subject, as for sratom_to_turtle().
+   @param predicate The predicate, as for sratom_to_turtle().
+   @param type The type of the atom.
+   @param size The size of the atom body in bytes.
+   @param body The atom body.
+   @param syntax The output syntax, which may be SERD_TURTLE, SERD_TRIG,
+   SERD_NTRIPLES, or SERD_NQUADS.
+   @param style The output style.  For Turtle and TriG, statements are written
+   a line at a time without SERD_STYLE_ABBREVIATED, and prefixes are only used
+   with SERD_STYLE_CURIED.  Other flags and syntaxes ignore the style.
+   @return The output string, or null if the syntax isn't supported or
+   serialization failed.
+*/
+SRATOM_API char* SERD_ALLOCATED
+sratom_to_string(Sratom* SERD_NONNULL             sratom,
+                 LV2_URID_Unmap* SERD_UNSPECIFIED unmap,
+                 const char* SERD_NONNULL         base_uri,
+                 const SerdNode* SERD_UNSPECIFIED subject,
+                 const SerdNode* SERD_UNSPECIFIED predicate,
+                 uint32_t                         type,
+                 uint32_t                         size,
+                 const void* SERD_NONNULL         body,
+                 SerdSyntax                       syntax,
+                 SerdStyle                        style);
+
+/**
+   Serialize an Atom to Turtle, writing it to a sink as it goes.
+
+   The output is the same as sratom_to_turtle(), but is written through a
+   small fixed-size buffer rather than built in memory, so the memory used
+   for output doesn't depend on the size of the atom.  Output may have been
+   written to the sink if this fails.
+
+   @param sratom The serializer.
+   @param unmap The URID unmap.
+   @param base_uri The base URI, as for sratom_to_turtle().
+   @param subject The subject, as for sratom_to_turtle().
+   @param predicate The predicate, as for sratom_to_turtle().
+   @param type The type of the atom.
+   @param size The size of the atom body in bytes.
+   @param body The atom body.
+   @param sink Function called to write output, which must return `len` on
+   success.
+   @param stream Handle passed to `sink`.
+   @return 0 on success, or non-zero if serialization or writing failed.
+*/
+SRATOM_API int
+sratom_write_to_stream(Sratom* SERD_NONNULL             sratom,
+                       LV2_URID_Unmap* SERD_UNSPECIFIED unmap,
+                       const char* SERD_NONNULL         base_uri,
+                       const SerdNode* SERD_UNSPECIFIED subject,
+                       const SerdNode* SERD_UNSPECIFIED predicate,
+                       uint32_t                         type,
+                       uint32_t                         size,
+                       const void* SERD_NONNULL         body,
+                       SerdSink SERD_NONNULL            sink,
+                       void* SERD_UNSPECIFIED           stream);
+
+/**
+   Serialize an Atom to Turtle, writing it to a file as it goes.
+
+   This is like sratom_write_to_stream() with a sink that writes to `file`,
+   which is flushed afterwards.  To write to a file descriptor, use
+   sratom_write_to_stream() with a sink that calls write().
+
+   @return 0 on success, or non-zero if serialization or writing failed.
+*/
+SRATOM_API int
+sratom_write_to_file(Sratom* SERD_NONNULL             sratom,
+                     LV2_URID_Unmap* SERD_UNSPECIFIED unmap,
+                     const char* SERD_NONNULL         base_uri,
+                     const SerdNode* SERD_UNSPECIFIED subject,
+                     const SerdNode* SERD_UNSPECIFIED predicate,
+                     uint32_t                         type,
+                     uint32_t                         size,
+                     const void* SERD_NONNULL         body,
+                     FILE* SERD_NONNULL               file);
+
+/// An atom to serialize with sratom_write_batch()
+typedef struct {
+  const SerdNode* SERD_NULLABLE subject;   ///< Subject to write atom with
+  const SerdNode* SERD_NULLABLE predicate; ///< Predicate to write atom with
+  const LV2_Atom* SERD_NONNULL  atom;      ///< Atom to serialize
+  char* SERD_NULLABLE           turtle;    ///< Output, set when written
+} SratomBatchEntry;
+
+/**
+   Serialize many Atoms to Turtle strings in parallel.
+
+   Each entry is serialized as with sratom_to_turtle(), on one of `n_threads`
+   threads, one of which is the calling thread.  The output doesn't depend on
+   the number of threads.
+
+   If `document` is null, the Turtle for each entry is stored in its `turtle`
+   field, which must be free()'d by the caller, and is null if the entry
+   failed to serialize.  Otherwise, the Turtle for every entry is concatenated
+   in order into a single document stored in `document`, which must be
+   free()'d by the caller, and the `turtle` fields are left null.
+
+   @param sratom The serializer, which must not be reconfigured until this
+   returns.
+   @param unmap The URID unmap, which must be thread-safe.
+   @param base_uri The base URI, as for sratom_to_turtle().
+   @param n_threads The maximum number of threads to use.
+   @param n_entries The number of entries.
+   @param entries The entries to serialize.
+   @param document If not null, set to the whole document, or null on error.
+   @return 0 on success, or non-zero if any entry failed to serialize.
+*/
+SRATOM_API int
+sratom_write_batch(Sratom* SERD_NONNULL               sratom,
+                   LV2_URID_Unmap* SERD_UNSPECIFIED   unmap,
+                   const char* SERD_NONNULL           base_uri,
+                   unsigned                           n_threads,
+                   size_t                             n_entries,
+                   SratomBatchEntry* SERD_NONNULL     entries,
+                   char* SERD_NULLABLE* SERD_NULLABLE document);
+
 /**
    Read an Atom from a Turtle string.
 
+   Documents shaped like those written by sratom_to_turtle(), where every
+   blank node is anonymous, are read in a single pass as they are parsed.
+   Other documents are loaded into a model first, which is slower.  File URIs
+   are read as paths relative to `base_uri`.
+
    The returned atom must be free()'d by the caller.
 */
 SRATOM_API LV2_Atom* SERD_ALLOCATED
@@ -162,6 +445,217 @@ sratom_from_turtle(Sratom* SERD_NONNULL             sratom,
                    const SerdNode* SERD_UNSPECIFIED predicate,
                    const char* SERD_NONNULL         str);
 
+/// Statistics for reading a Turtle file
+typedef struct {
+  size_t n_bytes; ///< Number of bytes parsed
+  double seconds; ///< Time taken to read the atom
+} SratomReadStats;
+
+/**
+   Read an Atom from a Turtle file.
+
+   This is like sratom_from_turtle(), but parses the file in pages as it is
+   read, rather than requiring the whole text in memory.  Documents that
+   need a model are parsed twice, and both passes are counted in `stats`.
+
+   The returned atom must be free()'d by the caller.
+
+   @param sratom The serializer.
+   @param base_uri The base URI, as for sratom_from_turtle().
+   @param subject The subject, as for sratom_from_turtle().
+   @param predicate The predicate, as for sratom_from_turtle().
+   @param path The path of the file to read.
+   @param stats If not null, set to statistics for the read, even on error.
+   @return The atom, or null on error.
+*/
+SRATOM_API LV2_Atom* SERD_ALLOCATED
+sratom_from_turtle_file(Sratom* SERD_NONNULL             sratom,
+                        const char* SERD_NONNULL         base_uri,
+                        const SerdNode* SERD_UNSPECIFIED subject,
+                        const SerdNode* SERD_UNSPECIFIED predicate,
+                        const char* SERD_NONNULL         path,
+                        SratomReadStats* SERD_NULLABLE   stats);
+
+/**
+   Create a reader for atoms in Turtle strings.
+
+   A reader keeps everything needed for parsing between documents, so it's
+   much faster than calling sratom_from_turtle() repeatedly when reading many
+   small documents.  The reader has its own copy of the environment set with
+   sratom_set_env(), if any, at the time it is created.  Prefixes defined in a
+   document are added to this copy, so they remain defined for later documents
+   read with the same reader, but aren't added to the environment of the
+   serializer.
+
+   The reader uses `sratom` for reading, so must be freed before it.
+*/
+SRATOM_API SratomReader* SERD_ALLOCATED
+sratom_reader_new(Sratom* SERD_NONNULL sratom);
+
+/// Free a reader created with sratom_reader_new()
+SRATOM_API void
+sratom_reader_free(SratomReader* SERD_NULLABLE reader);
+
+/**
+   Read an Atom from a Turtle string with a reader.
+
+   This is equivalent to sratom_from_turtle(), but reuses the reader's state.
+
+   The returned atom must be free()'d by the caller.
+*/
+SRATOM_API LV2_Atom* SERD_ALLOCATED
+sratom_reader_read_string(SratomReader* SERD_NONNULL       reader,
+                          const char* SERD_NONNULL         base_uri,
+                          const SerdNode* SERD_UNSPECIFIED subject,
+                          const SerdNode* SERD_UNSPECIFIED predicate,
+                          const char* SERD_NONNULL         str);
+
+/**
+   Write an Atom to a binary archive.
+
+   An archive stores the atom verbatim, except that every URID in it is
+   replaced by an index into a table of the distinct URIs it uses, so it can
+   be loaded with a different URID map.  Archives are much smaller and faster
+   than Turtle, but are in native byte order and not meant to be read by
+   humans.  URIDs are found in the same types that sratom_write() supports,
+   and the bodies of other types are stored as opaque data.
+
+   @param sratom The serializer.
+   @param unmap The URID unmap for every URID in the atom.
+   @param atom The atom to write.
+   @param size Set to the size of the archive in bytes, or zero on error.
+   @return A new archive that must be free()'d by the caller, or null on
+   error.
+*/
+SRATOM_API void* SERD_ALLOCATED
+sratom_to_archive(Sratom* SERD_NONNULL         sratom,
+                  LV2_URID_Unmap* SERD_NONNULL unmap,
+                  const LV2_Atom* SERD_NONNULL atom,
+                  size_t* SERD_NONNULL         size);
+
+/**
+   Load an Atom from a binary archive in place.
+
+   Each distinct URI in the archive is mapped once with the serializer's map,
+   then every URID in the atom is replaced in a single pass.  The archive is
+   modified, so it can only be loaded once, but can be a private
+   (copy-on-write) memory mapping of a file.
+
+   @param sratom The serializer.
+   @param archive The archive, which must be aligned to 8 bytes.
+   @param size The size of the archive in bytes.
+   @return A pointer to the atom within `archive`, or null if the archive is
+   invalid, in which case its contents are unspecified.
+*/
+SRATOM_API LV2_Atom* SERD_NULLABLE
+sratom_from_archive(Sratom* SERD_NONNULL sratom,
+                    void* SERD_NONNULL   archive,
+                    size_t               size);
+
+/**
+   Convert a Turtle string to a binary archive.
+
+   The atom is read as with sratom_from_turtle(), and written as with
+   sratom_to_archive().
+
+   @return A new archive that must be free()'d by the caller, or null on
+   error.
+*/
+SRATOM_API void* SERD_ALLOCATED
+sratom_turtle_to_archive(Sratom* SERD_NONNULL             sratom,
+                         LV2_URID_Unmap* SERD_NONNULL     unmap,
+                         const char* SERD_NONNULL         base_uri,
+                         const SerdNode* SERD_UNSPECIFIED subject,
+                         const SerdNode* SERD_UNSPECIFIED predicate,
+                         const char* SERD_NONNULL         str,
+                         size_t* SERD_NONNULL             size);
+
+/**
+   Convert a binary archive to a Turtle string.
+
+   The atom is loaded from a copy of the archive as with
+   sratom_from_archive(), and written as with sratom_to_turtle().
+
+   The returned string must be free()'d by the caller.
+*/
+SRATOM_API char* SERD_ALLOCATED
+sratom_archive_to_turtle(Sratom* SERD_NONNULL             sratom,
+                         LV2_URID_Unmap* SERD_NONNULL     unmap,
+                         const char* SERD_NONNULL         base_uri,
+                         const SerdNode* SERD_UNSPECIFIED subject,
+                         const SerdNode* SERD_UNSPECIFIED predicate,
+                         const void* SERD_NONNULL         archive,
+                         size_t                           size);
+
+/**
+   Forge a patch that changes one object into another.
+
+   The patch is a patch:Patch with a patch:remove object that has the
+   properties that are only in `old_object`, and a patch:add object that has
+   the properties that are only in `new_object`, so it is proportional to the
+   size of the change rather than the size of the objects.  A property is
+   unchanged only if its key, context, and value are all equal, so a changed
+   value is both removed and added, and nested objects are compared whole.
+   If the object type changed, the old and new types are the types of the
+   remove and add objects, and if `new_object` has an ID, it is the
+   patch:subject.
+
+   Swapping `old_object` and `new_object` gives the inverse patch, which can
+   be used for undo.
+
+   @param sratom The serializer.
+   @param forge The forge to write the patch to, which must not write to the
+   memory of either object.
+   @param old_object The previous object.
+   @param new_object The current object.
+   @return A reference to the patch, or zero on error.
+*/
+SRATOM_API LV2_Atom_Forge_Ref
+sratom_forge_delta(Sratom* SERD_NONNULL                sratom,
+                   LV2_Atom_Forge* SERD_NONNULL        forge,
+                   const LV2_Atom_Object* SERD_NONNULL old_object,
+                   const LV2_Atom_Object* SERD_NONNULL new_object);
+
+/**
+   Write a patch that changes one object into another to RDF.
+
+   The patch is made as with sratom_forge_delta(), and written as with
+   sratom_write().
+
+   @return 0 on success, or a non-zero error code otherwise.
+*/
+SRATOM_API int
+sratom_write_delta(Sratom* SERD_NONNULL                sratom,
+                   LV2_URID_Unmap* SERD_UNSPECIFIED    unmap,
+                   uint32_t                            flags,
+                   const SerdNode* SERD_NULLABLE       subject,
+                   const SerdNode* SERD_NULLABLE       predicate,
+                   const LV2_Atom_Object* SERD_NONNULL old_object,
+                   const LV2_Atom_Object* SERD_NONNULL new_object);
+
+/**
+   Forge an object with a patch applied to it.
+
+   Each property in the patch:remove object of `delta` removes one equal
+   property, or every property with the same key if its value is
+   patch:wildcard, then the properties in the patch:add object are appended.
+   This applies patches made by sratom_forge_delta(), or read back from RDF
+   written by sratom_write_delta().
+
+   @param sratom The serializer.
+   @param forge The forge to write the result to, which must not write to the
+   memory of either object.
+   @param object The object to patch.
+   @param delta The patch:Patch to apply.
+   @return A reference to the patched object, or zero if the patch is invalid
+   or an error occurred.
+*/
+SRATOM_API LV2_Atom_Forge_Ref
+sratom_apply_delta(Sratom* SERD_NONNULL                sratom,
+                   LV2_Atom_Forge* SERD_NONNULL        forge,
+                   const LV2_Atom_Object* SERD_NONNULL object,
+                   const LV2_Atom_Object* SERD_NONNULL delta);
+
 /**
    A convenient resizing sink for LV2_Atom_Forge.
 
@@ -177,6 +671,81 @@ SRATOM_API LV2_Atom* SERD_NULLABLE
 sratom_forge_deref(LV2_Atom_Forge_Sink_Handle SERD_UNSPECIFIED handle,
                    LV2_Atom_Forge_Ref                          ref);
 
+/**
+   A growable buffer for LV2_Atom_Forge.
+
+   Unlike with sratom_forge_sink(), which reallocates on every write, space is
+   reserved geometrically, so forging a large atom only takes a few
+   allocations.  The buffer isn't trimmed to fit, and can be cleared and
+   reused for several atoms without freeing it.
+*/
+typedef struct {
+  uint8_t* SERD_NULLABLE buf; ///< Forged atom data
+  size_t                 len; ///< Length of atom data in bytes
+  size_t                 cap; ///< Allocated size of buf in bytes
+} SratomForgeBuffer;
+
+/**
+   Initialize a forge buffer.
+
+   @param buffer The buffer to initialize.
+   @param capacity The number of bytes to reserve, which may be zero.
+   @return Zero on success, or non-zero if allocation failed.
+*/
+SRATOM_API int
+sratom_forge_buffer_init(SratomForgeBuffer* SERD_NONNULL buffer,
+                         size_t                          capacity);
+
+/// Clear a forge buffer for reuse, keeping the allocated memory
+SRATOM_API void
+sratom_forge_buffer_clear(SratomForgeBuffer* SERD_NONNULL buffer);
+
+/// Free the memory allocated by a forge buffer, leaving it empty
+SRATOM_API void
+sratom_forge_buffer_cleanup(SratomForgeBuffer* SERD_NONNULL buffer);
+
+/**
+   A geometrically growing sink for LV2_Atom_Forge.
+
+   The handle must point to an initialized SratomForgeBuffer.
+*/
+SRATOM_API LV2_Atom_Forge_Ref
+sratom_forge_buffer_sink(LV2_Atom_Forge_Sink_Handle SERD_NONNULL handle,
+                         const void* SERD_NONNULL               buf,
+                         uint32_t                               size);
+
+/// The corresponding deref function for sratom_forge_buffer_sink
+SRATOM_API LV2_Atom* SERD_NULLABLE
+sratom_forge_buffer_deref(LV2_Atom_Forge_Sink_Handle SERD_NONNULL handle,
+                          LV2_Atom_Forge_Ref                     ref);
+
+/**
+   Read many Atoms from a model in parallel.
+
+   Each subject is read as with sratom_read(), into the buffer at the same
+   index, on one of `n_threads` threads, one of which is the calling thread.
+   The model is only read, and must not be modified until this returns.
+
+   @param sratom The serializer, which must not be reconfigured until this
+   returns.  Its URID map must be thread-safe.
+   @param world The world of the model.
+   @param model The model to read from.
+   @param n_threads The maximum number of threads to use.
+   @param n_subjects The number of subjects to read.
+   @param subjects The nodes to read an atom for.
+   @param buffers Initialized buffers, which are cleared before reading.
+   @return 0 on success, or non-zero if any atom failed to read, including if
+   it was truncated because a buffer couldn't grow.
+*/
+SRATOM_API int
+sratom_read_many(Sratom* SERD_NONNULL                             sratom,
+                 SordWorld* SERD_NONNULL                          world,
+                 SordModel* SERD_NONNULL                          model,
+                 unsigned                                         n_threads,
+                 size_t                                           n_subjects,
+                 const SordNode* SERD_NONNULL const* SERD_NONNULL subjects,
+                 SratomForgeBuffer* SERD_NONNULL                  buffers);
+
 /**
    @}
 */
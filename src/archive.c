@@ -0,0 +1,466 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "archive.h"
+
+#include <lv2/atom/atom.h>
+#include <lv2/urid/urid.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Maximum depth of nested atoms, which limits recursion on bad input
+#define MAX_DEPTH 512U
+
+/// A function that replaces a non-zero URID, returning false on error
+typedef bool (*RemapFunc)(void* handle, uint32_t* urid);
+
+/// A pass over an atom that replaces every URID in it
+typedef struct {
+  const ArchiveTypes* types;
+  RemapFunc           func;
+  void*               handle;
+  bool                to_archive; ///< True if replacing URIDs with indices
+} Remapper;
+
+/// An entry in the hash table of URIs found while writing
+typedef struct {
+  LV2_URID urid;  ///< URID, or zero if the slot is empty
+  uint32_t index; ///< Index of the URI in the table
+} UriSlot;
+
+/// A table of the distinct URIs in an atom
+typedef struct {
+  LV2_URID_Unmap* unmap;
+  UriSlot*        slots;       ///< Hash table from URID to index
+  size_t          slots_cap;   ///< Number of slots, a power of two
+  uint32_t        n_uris;      ///< Number of URIs in the table
+  uint32_t*       offsets;     ///< Offset of each URI in strings
+  char*           strings;     ///< Null-terminated URI strings
+  size_t          strings_len; ///< Length of strings in bytes
+  size_t          strings_cap; ///< Allocated size of strings in bytes
+} UriTable;
+
+/// URIDs for the URIs in an archive being loaded
+typedef struct {
+  const LV2_URID* urids;
+  uint32_t        n_urids;
+} UridTable;
+
+static size_t
+pad_size(const size_t size)
+{
+  return (size + 7U) & ~(size_t)7U;
+}
+
+static size_t
+slot_index(const LV2_URID urid, const size_t cap)
+{
+  return ((size_t)urid * 2654435761U) & (cap - 1U);
+}
+
+static bool
+remap(const Remapper* const r, uint32_t* const urid)
+{
+  return !*urid || r->func(r->handle, urid);
+}
+
+/// Remap a type, and set `type` to its URID in the map
+static bool
+remap_type(const Remapper* const r,
+           uint32_t* const       field,
+           uint32_t* const       type)
+{
+  const uint32_t original = *field;
+  if (!remap(r, field)) {
+    return false;
+  }
+
+  *type = r->to_archive ? original : *field;
+  return true;
+}
+
+static bool
+remap_atom(const Remapper* r, LV2_Atom* atom, size_t avail, unsigned depth);
+
+static bool
+remap_object(const Remapper* const r,
+             const uint32_t        type,
+             const size_t          size,
+             uint8_t* const        body,
+             const unsigned        depth)
+{
+  LV2_Atom_Object_Body* const obj = (LV2_Atom_Object_Body*)body;
+  if (size < sizeof(LV2_Atom_Object_Body) ||
+      (type != r->types->Blank && !remap(r, &obj->id)) ||
+      !remap(r, &obj->otype)) {
+    return false;
+  }
+
+  for (size_t offset = sizeof(LV2_Atom_Object_Body); offset < size;) {
+    LV2_Atom_Property_Body* const prop =
+      (LV2_Atom_Property_Body*)(body + offset);
+
+    const size_t avail = size - offset;
+    if (avail < sizeof(LV2_Atom_Property_Body) || !remap(r, &prop->key) ||
+        !remap(r, &prop->context) ||
+        !remap_atom(r, &prop->value, avail - (2U * sizeof(uint32_t)), depth)) {
+      return false;
+    }
+
+    offset += pad_size(sizeof(LV2_Atom_Property_Body) + prop->value.size);
+  }
+
+  return true;
+}
+
+static bool
+remap_tuple(const Remapper* const r,
+            const size_t          size,
+            uint8_t* const        body,
+            const unsigned        depth)
+{
+  for (size_t offset = 0U; offset < size;) {
+    LV2_Atom* const elem = (LV2_Atom*)(body + offset);
+    if (!remap_atom(r, elem, size - offset, depth)) {
+      return false;
+    }
+
+    offset += pad_size(sizeof(LV2_Atom) + elem->size);
+  }
+
+  return true;
+}
+
+static bool
+remap_vector(const Remapper* const r, const size_t size, uint8_t* const body)
+{
+  LV2_Atom_Vector_Body* const vec        = (LV2_Atom_Vector_Body*)body;
+  uint32_t                    child_type = 0U;
+  if (size < sizeof(LV2_Atom_Vector_Body) ||
+      !remap_type(r, &vec->child_type, &child_type)) {
+    return false;
+  }
+
+  if (child_type == r->types->URID && vec->child_size == sizeof(uint32_t)) {
+    const size_t n_bytes = size - sizeof(LV2_Atom_Vector_Body);
+    uint32_t*    elems   = (uint32_t*)(vec + 1);
+    const size_t n       = n_bytes / sizeof(uint32_t);
+    for (size_t i = 0U; i < n; ++i) {
+      if (!remap(r, &elems[i])) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static bool
+remap_sequence(const Remapper* const r,
+               const size_t          size,
+               uint8_t* const        body,
+               const unsigned        depth)
+{
+  LV2_Atom_Sequence_Body* const seq = (LV2_Atom_Sequence_Body*)body;
+  if (size < sizeof(LV2_Atom_Sequence_Body) || !remap(r, &seq->unit)) {
+    return false;
+  }
+
+  for (size_t offset = sizeof(LV2_Atom_Sequence_Body); offset < size;) {
+    LV2_Atom_Event* const ev    = (LV2_Atom_Event*)(body + offset);
+    const size_t          avail = size - offset;
+    if (avail < sizeof(LV2_Atom_Event) ||
+        !remap_atom(r, &ev->body, avail - sizeof(int64_t), depth)) {
+      return false;
+    }
+
+    offset += pad_size(sizeof(LV2_Atom_Event) + ev->body.size);
+  }
+
+  return true;
+}
+
+static bool
+remap_body(const Remapper* const r,
+           const uint32_t        type,
+           const size_t          size,
+           uint8_t* const        body,
+           const unsigned        depth)
+{
+  const ArchiveTypes* const types = r->types;
+
+  if (type == types->URID) {
+    return size >= sizeof(uint32_t) && remap(r, (uint32_t*)body);
+  }
+
+  if (type == types->Literal) {
+    LV2_Atom_Literal_Body* const lit = (LV2_Atom_Literal_Body*)body;
+    return size >= sizeof(LV2_Atom_Literal_Body) &&
+           remap(r, &lit->datatype) && remap(r, &lit->lang);
+  }
+
+  if (type == types->Object || type == types->Resource ||
+      type == types->Blank) {
+    return remap_object(r, type, size, body, depth);
+  }
+
+  if (type == types->Tuple) {
+    return remap_tuple(r, size, body, depth);
+  }
+
+  if (type == types->Vector) {
+    return remap_vector(r, size, body);
+  }
+
+  if (type == types->Sequence) {
+    return remap_sequence(r, size, body, depth);
+  }
+
+  return true; // Opaque body with no URIDs
+}
+
+static bool
+remap_atom(const Remapper* const r,
+           LV2_Atom* const       atom,
+           const size_t          avail,
+           const unsigned        depth)
+{
+  uint32_t type = 0U;
+  return depth < MAX_DEPTH && avail >= sizeof(LV2_Atom) &&
+         atom->size <= avail - sizeof(LV2_Atom) &&
+         remap_type(r, &atom->type, &type) &&
+         remap_body(r, type, atom->size, (uint8_t*)(atom + 1), depth + 1U);
+}
+
+static bool
+grow_uri_table(UriTable* const table)
+{
+  const size_t    cap   = table->slots_cap ? table->slots_cap * 2U : 64U;
+  UriSlot* const  slots = (UriSlot*)calloc(cap, sizeof(UriSlot));
+  uint32_t* const offsets =
+    (uint32_t*)realloc(table->offsets, (cap / 2U) * sizeof(uint32_t));
+  if (!slots || !offsets) {
+    free(slots);
+    table->offsets = offsets ? offsets : table->offsets;
+    return false;
+  }
+
+  for (size_t i = 0U; i < table->slots_cap; ++i) {
+    const UriSlot* const slot = &table->slots[i];
+    if (slot->urid) {
+      size_t j = slot_index(slot->urid, cap);
+      while (slots[j].urid) {
+        j = (j + 1U) & (cap - 1U);
+      }
+
+      slots[j] = *slot;
+    }
+  }
+
+  free(table->slots);
+  table->slots     = slots;
+  table->slots_cap = cap;
+  table->offsets   = offsets;
+  return true;
+}
+
+static UriSlot*
+find_uri(const UriTable* const table, const LV2_URID urid)
+{
+  if (!table->slots_cap) {
+    return NULL;
+  }
+
+  size_t i = slot_index(urid, table->slots_cap);
+  for (; table->slots[i].urid; i = (i + 1U) & (table->slots_cap - 1U)) {
+    if (table->slots[i].urid == urid) {
+      return &table->slots[i];
+    }
+  }
+
+  return NULL;
+}
+
+/// Add the URI of a URID to the table if it isn't already there
+static bool
+collect_uri(void* const handle, uint32_t* const urid)
+{
+  UriTable* const table = (UriTable*)handle;
+  if (find_uri(table, *urid)) {
+    return true;
+  }
+
+  const char* const uri =
+    table->unmap->unmap(table->unmap->handle, (LV2_URID)*urid);
+  if (!uri || ((table->n_uris + 1U) * 2U > table->slots_cap &&
+               !grow_uri_table(table))) {
+    return false;
+  }
+
+  const size_t len = strlen(uri) + 1U;
+  if (table->strings_len + len > table->strings_cap) {
+    size_t cap = table->strings_cap ? table->strings_cap : 1024U;
+    while (cap < table->strings_len + len) {
+      cap *= 2U;
+    }
+
+    char* const strings = (char*)realloc(table->strings, cap);
+    if (!strings) {
+      return false;
+    }
+
+    table->strings     = strings;
+    table->strings_cap = cap;
+  }
+
+  size_t i = slot_index(*urid, table->slots_cap);
+  while (table->slots[i].urid) {
+    i = (i + 1U) & (table->slots_cap - 1U);
+  }
+
+  table->slots[i].urid  = *urid;
+  table->slots[i].index = table->n_uris;
+
+  table->offsets[table->n_uris++] = (uint32_t)table->strings_len;
+  memcpy(table->strings + table->strings_len, uri, len);
+  table->strings_len += len;
+  return true;
+}
+
+/// Replace a URID with one plus the index of its URI in the table
+static bool
+encode_uri(void* const handle, uint32_t* const urid)
+{
+  const UriSlot* const slot = find_uri((const UriTable*)handle, *urid);
+  if (!slot) {
+    return false;
+  }
+
+  *urid = slot->index + 1U;
+  return true;
+}
+
+/// Replace one plus the index of a URI in the table with its URID
+static bool
+decode_uri(void* const handle, uint32_t* const urid)
+{
+  const UridTable* const table = (const UridTable*)handle;
+  if (*urid > table->n_urids) {
+    return false;
+  }
+
+  *urid = table->urids[*urid - 1U];
+  return true;
+}
+
+void*
+archive_write(const ArchiveTypes* const types,
+              LV2_URID_Unmap* const     unmap,
+              const LV2_Atom* const     atom,
+              size_t* const             size)
+{
+  const size_t atom_size = sizeof(LV2_Atom) + atom->size;
+  UriTable     table     = {unmap, NULL, 0U, 0U, NULL, NULL, 0U, 0U};
+  Remapper     remapper  = {types, collect_uri, &table, true};
+  uint8_t*     archive   = NULL;
+
+  // Find every distinct URI, which doesn't modify the atom
+  if (remap_atom(&remapper, (LV2_Atom*)atom, atom_size, 0U) &&
+      table.strings_len <= UINT32_MAX - 7U) {
+    const size_t offsets_size = pad_size(table.n_uris * sizeof(uint32_t));
+    const size_t uris_size    = pad_size(table.strings_len);
+    const size_t atom_offset =
+      sizeof(ArchiveHeader) + offsets_size + uris_size;
+
+    *size   = atom_offset + pad_size(atom_size);
+    archive = (uint8_t*)calloc(1U, *size);
+    if (archive) {
+      ArchiveHeader header = {
+        {0, 0, 0, 0}, ARCHIVE_VERSION, table.n_uris, (uint32_t)uris_size};
+
+      memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+      memcpy(archive, &header, sizeof(header));
+      if (table.n_uris) {
+        memcpy(archive + sizeof(header),
+               table.offsets,
+               table.n_uris * sizeof(uint32_t));
+        memcpy(archive + sizeof(header) + offsets_size,
+               table.strings,
+               table.strings_len);
+      }
+
+      // Copy the atom and replace the URIDs in it with indices
+      memcpy(archive + atom_offset, atom, atom_size);
+      remapper.func = encode_uri;
+      remap_atom(&remapper, (LV2_Atom*)(archive + atom_offset), atom_size, 0U);
+    }
+  }
+
+  free(table.strings);
+  free(table.offsets);
+  free(table.slots);
+  return archive;
+}
+
+LV2_Atom*
+archive_load(const ArchiveTypes* const types,
+             LV2_URID_Map* const       map,
+             void* const               archive,
+             const size_t              size)
+{
+  uint8_t* const data   = (uint8_t*)archive;
+  ArchiveHeader  header = {{0, 0, 0, 0}, 0U, 0U, 0U};
+  if (size < sizeof(ArchiveHeader)) {
+    return NULL;
+  }
+
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, ARCHIVE_MAGIC, sizeof(header.magic)) ||
+      header.version != ARCHIVE_VERSION) {
+    return NULL;
+  }
+
+  // Check that the sections are within the archive
+  const size_t offsets_size = pad_size(header.n_uris * sizeof(uint32_t));
+  const size_t uris_offset  = sizeof(ArchiveHeader) + offsets_size;
+  if (offsets_size > size - sizeof(ArchiveHeader) ||
+      header.uris_size > size - uris_offset || (header.uris_size & 7U) ||
+      (header.n_uris && !header.uris_size) ||
+      (header.uris_size && data[uris_offset + header.uris_size - 1U])) {
+    return NULL;
+  }
+
+  // Map every URI once
+  const size_t    n_uris = header.n_uris;
+  LV2_URID* const urids =
+    n_uris ? (LV2_URID*)malloc(n_uris * sizeof(LV2_URID)) : NULL;
+  if (n_uris && !urids) {
+    return NULL;
+  }
+
+  const uint32_t* const offsets = (const uint32_t*)(data + sizeof(header));
+
+  bool success = true;
+  for (size_t i = 0U; success && i < n_uris; ++i) {
+    const char* const uri = (const char*)(data + uris_offset + offsets[i]);
+
+    success  = offsets[i] < header.uris_size;
+    urids[i] = success ? map->map(map->handle, uri) : 0U;
+    success  = success && urids[i];
+  }
+
+  // Replace the indices in the atom with URIDs
+  const size_t    atom_offset = uris_offset + header.uris_size;
+  LV2_Atom* const atom        = (LV2_Atom*)(data + atom_offset);
+  UridTable       table       = {urids, header.n_uris};
+  Remapper        remapper    = {types, decode_uri, &table, false};
+
+  success = success && remap_atom(&remapper, atom, size - atom_offset, 0U);
+
+  free(urids);
+  return success ? atom : NULL;
+}
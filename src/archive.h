@@ -0,0 +1,77 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_ARCHIVE_H
+#define SRATOM_SRC_ARCHIVE_H
+
+#include <lv2/atom/atom.h>
+#include <lv2/urid/urid.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+   A binary atom archive.
+
+   An archive is a header, followed by a table of URI offsets, the URI
+   strings, and the atom, each starting at a multiple of 8 bytes.  The atom is
+   stored verbatim, except that every URID in it is replaced by one plus the
+   index of its URI in the table, so zero is still zero.  Everything is in
+   native byte order, and the version doubles as a byte order mark.
+*/
+typedef struct {
+  char     magic[4];  ///< ARCHIVE_MAGIC
+  uint32_t version;   ///< ARCHIVE_VERSION
+  uint32_t n_uris;    ///< Number of URIs in the table
+  uint32_t uris_size; ///< Size of the URI strings, including padding
+} ArchiveHeader;
+
+#define ARCHIVE_MAGIC "SRAA"
+#define ARCHIVE_VERSION 1U
+
+/// URIDs of the atom types that contain URIDs in their bodies
+typedef struct {
+  LV2_URID Blank;
+  LV2_URID Literal;
+  LV2_URID Object;
+  LV2_URID Resource;
+  LV2_URID Sequence;
+  LV2_URID Tuple;
+  LV2_URID URID;
+  LV2_URID Vector;
+} ArchiveTypes;
+
+/**
+   Write an atom to a new archive.
+
+   @param types URIDs of the types that contain URIDs.
+   @param unmap URID unmap for every URID in the atom.
+   @param atom Well-formed atom to write.
+   @param size Set to the size of the archive in bytes.
+   @return A new archive that must be freed with free(), or null on error.
+*/
+void*
+archive_write(const ArchiveTypes* types,
+              LV2_URID_Unmap*     unmap,
+              const LV2_Atom*     atom,
+              size_t*             size);
+
+/**
+   Map the URIs in an archive and return the atom it contains.
+
+   Each URI in the table is mapped once, then the URIDs in the atom are
+   replaced in place in a single pass.
+
+   @param types URIDs of the types that contain URIDs.
+   @param map URID map for the URIs in the archive.
+   @param archive Archive to modify, which must be aligned to 8 bytes.
+   @param size Size of `archive` in bytes.
+   @return A pointer to the atom in `archive`, or null if it is invalid.
+*/
+LV2_Atom*
+archive_load(const ArchiveTypes* types,
+             LV2_URID_Map*       map,
+             void*               archive,
+             size_t              size);
+
+#endif /* SRATOM_SRC_ARCHIVE_H */
@@ -0,0 +1,130 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "arena.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// The minimum size of a block, which is enough for most atoms
+#define ARENA_MIN_BLOCK_SIZE 4096U
+
+/// The maximum size of the block kept when the arena is reset
+#define ARENA_MAX_KEPT_SIZE 1048576U
+
+/// The header of a block of memory, followed by aligned data
+struct ArenaBlockImpl {
+  ArenaBlock* prev; ///< Previous full block
+  size_t      size; ///< Size of data in bytes
+};
+
+static size_t
+align_size(const size_t size)
+{
+  const size_t align = sizeof(double) > sizeof(void*) ? sizeof(double)
+                                                      : sizeof(void*);
+
+  return (size + align - 1U) & ~(align - 1U);
+}
+
+static char*
+block_data(ArenaBlock* const block)
+{
+  return (char*)block + align_size(sizeof(ArenaBlock));
+}
+
+static ArenaBlock*
+new_block(ArenaBlock* const prev, const size_t size)
+{
+  ArenaBlock* const block =
+    (ArenaBlock*)malloc(align_size(sizeof(ArenaBlock)) + size);
+
+  if (block) {
+    block->prev = prev;
+    block->size = size;
+  }
+
+  return block;
+}
+
+void
+arena_init(Arena* const arena)
+{
+  arena->block = NULL;
+  arena->used  = 0U;
+}
+
+void*
+arena_alloc(Arena* const arena, const size_t size)
+{
+  const size_t aligned = align_size(size);
+  ArenaBlock*  block   = arena->block;
+
+  if (!block || block->size - arena->used < aligned) {
+    const size_t prev_size = block ? block->size : 0U;
+    size_t       new_size  = prev_size ? prev_size * 2U : ARENA_MIN_BLOCK_SIZE;
+    if (new_size < aligned) {
+      new_size = aligned;
+    }
+
+    if (!(block = new_block(arena->block, new_size))) {
+      return NULL;
+    }
+
+    arena->block = block;
+    arena->used  = 0U;
+  }
+
+  void* const ptr = block_data(block) + arena->used;
+  arena->used += aligned;
+  return ptr;
+}
+
+char*
+arena_strndup(Arena* const arena, const char* const str, const size_t len)
+{
+  char* const copy = (char*)arena_alloc(arena, len + 1U);
+  if (copy) {
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+  }
+
+  return copy;
+}
+
+void
+arena_reset(Arena* const arena)
+{
+  ArenaBlock* const block = arena->block;
+
+  arena->used = 0U;
+  if (!block || (!block->prev && block->size <= ARENA_MAX_KEPT_SIZE)) {
+    return;
+  }
+
+  /* Replace all the blocks with a single one that is large enough for them,
+     up to a limit, so memory used for a huge atom is given back. */
+  size_t total = 0U;
+  for (ArenaBlock* b = block; b;) {
+    ArenaBlock* const prev = b->prev;
+    total += b->size;
+    free(b);
+    b = prev;
+  }
+
+  arena->block =
+    new_block(NULL, total < ARENA_MAX_KEPT_SIZE ? total : ARENA_MAX_KEPT_SIZE);
+}
+
+void
+arena_cleanup(Arena* const arena)
+{
+  for (ArenaBlock* b = arena->block; b;) {
+    ArenaBlock* const prev = b->prev;
+    free(b);
+    b = prev;
+  }
+
+  arena_init(arena);
+}
@@ -0,0 +1,52 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_ARENA_H
+#define SRATOM_SRC_ARENA_H
+
+#include <stddef.h>
+
+typedef struct ArenaBlockImpl ArenaBlock;
+
+/**
+   A bump allocator for temporary data which is all freed at once.
+
+   Allocations are made from a block, and when it is full, a larger block is
+   added.  When the arena is reset, several blocks are replaced by one large
+   enough for them all, so after warming up, the arena doesn't allocate.  The
+   kept block is at most 1 MiB, so memory used for a single huge atom isn't
+   held until the arena is cleaned up.
+*/
+typedef struct {
+  ArenaBlock* block; ///< Current block, linked to previous full blocks
+  size_t      used;  ///< Number of bytes used in the current block
+} Arena;
+
+/// Initialize an empty arena
+void
+arena_init(Arena* arena);
+
+/**
+   Allocate memory from an arena.
+
+   The memory is suitably aligned for any type, and remains valid until the
+   arena is reset or cleaned up.
+
+   @return A pointer to `size` bytes, or null if allocation failed.
+*/
+void*
+arena_alloc(Arena* arena, size_t size);
+
+/// Allocate a null-terminated copy of a string in an arena
+char*
+arena_strndup(Arena* arena, const char* str, size_t len);
+
+/// Free everything allocated in an arena, keeping the memory for reuse
+void
+arena_reset(Arena* arena);
+
+/// Free all memory used by an arena, leaving it empty
+void
+arena_cleanup(Arena* arena);
+
+#endif /* SRATOM_SRC_ARENA_H */
@@ -0,0 +1,282 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "base64.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  define BASE64_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+static const char base64_chars[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// Return the value of a base64 character, or a value above 63 if invalid
+static inline unsigned
+base64_char_value(const char c)
+{
+  const unsigned u = (unsigned)(uint8_t)c;
+
+  if (u - 'A' < 26U) {
+    return u - 'A';
+  }
+
+  if (u - 'a' < 26U) {
+    return u - 'a' + 26U;
+  }
+
+  if (u - '0' < 10U) {
+    return u - '0' + 52U;
+  }
+
+  return (u == '+') ? 62U : (u == '/') ? 63U : 64U;
+}
+
+/// Encode 1 to 3 bytes as 4 characters with padding
+static inline void
+encode_chunk(char* const dst, const uint8_t* const src, const size_t n_in)
+{
+  const uint32_t b0 = src[0];
+  const uint32_t b1 = (n_in > 1U) ? src[1] : 0U;
+  const uint32_t b2 = (n_in > 2U) ? src[2] : 0U;
+  const uint32_t x  = (b0 << 16U) | (b1 << 8U) | b2;
+
+  dst[0] = base64_chars[(x >> 18U) & 0x3FU];
+  dst[1] = base64_chars[(x >> 12U) & 0x3FU];
+  dst[2] = (n_in > 1U) ? base64_chars[(x >> 6U) & 0x3FU] : '=';
+  dst[3] = (n_in > 2U) ? base64_chars[x & 0x3FU] : '=';
+}
+
+#ifdef BASE64_SSE2
+
+/// Return a mask of the lanes where `lo <= c <= hi`
+static inline __m128i
+in_range(const __m128i c, const char lo, const char hi)
+{
+  return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8((char)(lo - 1))),
+                       _mm_cmplt_epi8(c, _mm_set1_epi8((char)(hi + 1))));
+}
+
+/// Return `offset` in the lanes where `idx > threshold`, and zero elsewhere
+static inline __m128i
+offset_above(const __m128i idx, const char threshold, const char offset)
+{
+  return _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(threshold)),
+                       _mm_set1_epi8(offset));
+}
+
+/// Encode 12 bytes to 16 characters
+static inline void
+encode_block(char* const dst, const uint8_t* const src)
+{
+  uint32_t groups[4];
+  for (unsigned i = 0U; i < 4U; ++i) {
+    const uint8_t* const g = src + (3U * i);
+
+    groups[i] = ((uint32_t)g[0] << 16U) | ((uint32_t)g[1] << 8U) | g[2];
+  }
+
+  // Split each group into 4 indices, with the first in the lowest byte
+  const __m128i x    = _mm_loadu_si128((const __m128i*)groups);
+  const __m128i mask = _mm_set1_epi32(0x3F);
+  const __m128i i0   = _mm_and_si128(_mm_srli_epi32(x, 18), mask);
+  const __m128i i1   = _mm_and_si128(_mm_srli_epi32(x, 12), mask);
+  const __m128i i2   = _mm_and_si128(_mm_srli_epi32(x, 6), mask);
+  const __m128i i3   = _mm_and_si128(x, mask);
+  const __m128i idx  = _mm_or_si128(
+    _mm_or_si128(i0, _mm_slli_epi32(i1, 8)),
+    _mm_or_si128(_mm_slli_epi32(i2, 16), _mm_slli_epi32(i3, 24)));
+
+  // Add the offset from each index to its character, range by range
+  const __m128i lower = offset_above(idx, 25, 'a' - 26 - 'A');
+  const __m128i digit = offset_above(idx, 51, ('0' - 52) - ('a' - 26));
+  const __m128i plus  = offset_above(idx, 61, ('+' - 62) - ('0' - 52));
+  const __m128i slash = offset_above(idx, 62, ('/' - 63) - ('+' - 62));
+  const __m128i chars = _mm_add_epi8(
+    _mm_add_epi8(idx, _mm_set1_epi8('A')),
+    _mm_add_epi8(_mm_add_epi8(lower, digit), _mm_add_epi8(plus, slash)));
+
+  _mm_storeu_si128((__m128i*)dst, chars);
+}
+
+/// Return the values of 16 base64 characters, and set `valid` to a lane mask
+static inline __m128i
+base64_to_values(const __m128i chars, int* const valid)
+{
+  const __m128i is_upper = in_range(chars, 'A', 'Z');
+  const __m128i is_lower = in_range(chars, 'a', 'z');
+  const __m128i is_digit = in_range(chars, '0', '9');
+  const __m128i is_plus  = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+  const __m128i is_slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+
+  *valid = _mm_movemask_epi8(
+    _mm_or_si128(_mm_or_si128(is_upper, is_lower),
+                 _mm_or_si128(_mm_or_si128(is_digit, is_plus), is_slash)));
+
+  const __m128i upper =
+    _mm_and_si128(is_upper, _mm_sub_epi8(chars, _mm_set1_epi8('A')));
+  const __m128i lower =
+    _mm_and_si128(is_lower, _mm_sub_epi8(chars, _mm_set1_epi8('a' - 26)));
+  const __m128i digit =
+    _mm_and_si128(is_digit, _mm_add_epi8(chars, _mm_set1_epi8(52 - '0')));
+  const __m128i plus  = _mm_and_si128(is_plus, _mm_set1_epi8(62));
+  const __m128i slash = _mm_and_si128(is_slash, _mm_set1_epi8(63));
+
+  return _mm_or_si128(_mm_or_si128(upper, lower),
+                      _mm_or_si128(_mm_or_si128(digit, plus), slash));
+}
+
+/// Decode 16 characters to 12 bytes, returning false if any are invalid
+static inline bool
+decode_block(uint8_t* const dst, const char* const src)
+{
+  int           valid  = 0;
+  const __m128i values = base64_to_values(
+    _mm_loadu_si128((const __m128i*)src), &valid);
+
+  if (valid != 0xFFFF) {
+    return false;
+  }
+
+  // Combine pairs of 6-bit values, then pairs of those, into 24-bit groups
+  const __m128i pairs =
+    _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0xFF)), 6),
+                 _mm_srli_epi16(values, 8));
+  const __m128i groups = _mm_or_si128(
+    _mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0xFFFF)), 12),
+    _mm_srli_epi32(pairs, 16));
+
+  uint32_t words[4];
+  _mm_storeu_si128((__m128i*)words, groups);
+  for (unsigned i = 0U; i < 4U; ++i) {
+    dst[3U * i]        = (uint8_t)(words[i] >> 16U);
+    dst[(3U * i) + 1U] = (uint8_t)(words[i] >> 8U);
+    dst[(3U * i) + 2U] = (uint8_t)words[i];
+  }
+
+  return true;
+}
+
+#endif
+
+size_t
+base64_encoded_length(const size_t size, const bool wrap_lines)
+{
+  const size_t n_newlines =
+    (wrap_lines && size) ? (size - 1U) / BASE64_LINE_BYTES : 0U;
+
+  return ((size + 2U) / 3U * 4U) + n_newlines;
+}
+
+bool
+base64_encode(char* const          dst,
+              const uint8_t* const src,
+              const size_t         size,
+              const bool           wrap_lines)
+{
+  const size_t line_bytes = wrap_lines ? BASE64_LINE_BYTES : size;
+  bool         newline    = false;
+  size_t       i          = 0U;
+  size_t       j          = 0U;
+
+  while (i < size) {
+    if (i > 0U) {
+      dst[j++] = '\n';
+      newline  = true;
+    }
+
+    const size_t line_end = (size - i > line_bytes) ? i + line_bytes : size;
+
+#ifdef BASE64_SSE2
+    for (; i + 12U <= line_end; i += 12U, j += 16U) {
+      encode_block(dst + j, src + i);
+    }
+#endif
+
+    for (; i < line_end; i += 3U, j += 4U) {
+      encode_chunk(dst + j, src + i, (line_end - i < 3U) ? line_end - i : 3U);
+    }
+  }
+
+  return newline;
+}
+
+size_t
+base64_decoded_size(const char* const str, const size_t len)
+{
+  size_t n_chars = 0U;
+  size_t i       = 0U;
+
+#ifdef BASE64_SSE2
+  for (; i + 16U <= len; i += 16U) {
+    int valid = 0;
+    base64_to_values(_mm_loadu_si128((const __m128i*)(str + i)), &valid);
+    for (; valid; valid &= valid - 1) {
+      ++n_chars;
+    }
+  }
+#endif
+
+  for (; i < len; ++i) {
+    n_chars += base64_char_value(str[i]) < 64U;
+  }
+
+  return n_chars / 4U * 3U + ((n_chars % 4U) * 3U / 4U);
+}
+
+size_t
+base64_decode(uint8_t* const    dst,
+              const size_t      size,
+              const char* const str,
+              const size_t      len)
+{
+  uint32_t group   = 0U;
+  unsigned n_chars = 0U;
+  size_t   n_out   = 0U;
+  size_t   i       = 0U;
+
+  while (i < len && n_out + 3U <= size) {
+#ifdef BASE64_SSE2
+    if (!n_chars && i + 16U <= len && n_out + 12U <= size &&
+        decode_block(dst + n_out, str + i)) {
+      i += 16U;
+      n_out += 12U;
+      continue;
+    }
+#endif
+
+    const unsigned value = base64_char_value(str[i++]);
+    if (value < 64U) {
+      group = (group << 6U) | value;
+      if (++n_chars == 4U) {
+        dst[n_out++] = (uint8_t)(group >> 16U);
+        dst[n_out++] = (uint8_t)(group >> 8U);
+        dst[n_out++] = (uint8_t)group;
+        group        = 0U;
+        n_chars      = 0U;
+      }
+    }
+  }
+
+  // Decode the last group, which may be partial or only fit in part
+  for (; i < len && n_chars < 4U; ++i) {
+    const unsigned value = base64_char_value(str[i]);
+    if (value < 64U) {
+      group = (group << 6U) | value;
+      ++n_chars;
+    }
+  }
+
+  group <<= 6U * (4U - n_chars);
+
+  const size_t n_tail = (n_chars * 3U) / 4U;
+  for (size_t k = 0U; k < n_tail && n_out < size; ++k) {
+    dst[n_out++] = (uint8_t)(group >> (16U - (8U * k)));
+  }
+
+  return n_out;
+}
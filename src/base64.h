@@ -0,0 +1,58 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_BASE64_H
+#define SRATOM_SRC_BASE64_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// Number of input bytes per line when wrapping (76 characters)
+#define BASE64_LINE_BYTES 57U
+
+/// Return the length of the base64 encoding of `size` bytes
+size_t
+base64_encoded_length(size_t size, bool wrap_lines);
+
+/**
+   Encode bytes as base64.
+
+   The output is the same as serd_base64_encode(), with padding, and a newline
+   after every 76 characters if `wrap_lines` is true.
+
+   @param dst Output buffer of at least base64_encoded_length() characters,
+   which is not null-terminated.
+   @param src Bytes to encode.
+   @param size Number of bytes to encode.
+   @param wrap_lines Wrap lines at 76 characters.
+   @return True if a newline was written.
+*/
+bool
+base64_encode(char* dst, const uint8_t* src, size_t size, bool wrap_lines);
+
+/**
+   Return the number of bytes encoded by base64 text.
+
+   Characters outside the base64 alphabet, like whitespace and padding, are
+   ignored.
+*/
+size_t
+base64_decoded_size(const char* str, size_t len);
+
+/**
+   Decode base64 text.
+
+   Characters outside the base64 alphabet are skipped, as with
+   serd_base64_decode().
+
+   @param dst Output buffer.
+   @param size Size of `dst`, at most base64_decoded_size() bytes are written.
+   @param str Base64 text to decode.
+   @param len Length of `str` in bytes.
+   @return The number of bytes written to `dst`.
+*/
+size_t
+base64_decode(uint8_t* dst, size_t size, const char* str, size_t len);
+
+#endif /* SRATOM_SRC_BASE64_H */
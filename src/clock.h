@@ -0,0 +1,11 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_CLOCK_H
+#define SRATOM_SRC_CLOCK_H
+
+/// Return the time in seconds since some arbitrary point, which never jumps
+double
+clock_now(void);
+
+#endif /* SRATOM_SRC_CLOCK_H */
@@ -0,0 +1,304 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "delta.h"
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/atom/util.h>
+#include <lv2/urid/urid.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/// An entry in the hash table of properties
+typedef struct {
+  const LV2_Atom_Property_Body* prop;    ///< Property, or null if empty
+  uint32_t                      hash;    ///< Hash of the whole property
+  bool                          matched; ///< True if matched by another
+} PropSlot;
+
+/// A hash table that matches properties by key, context, and value
+typedef struct {
+  PropSlot* slots;
+  size_t    cap; ///< Number of slots, a power of two
+} PropTable;
+
+static uint32_t
+hash_bytes(uint32_t hash, const void* const data, const size_t size)
+{
+  const uint8_t* const bytes = (const uint8_t*)data;
+  for (size_t i = 0U; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 16777619U; // FNV-1a
+  }
+
+  return hash;
+}
+
+static uint32_t
+hash_property(const LV2_URID        key,
+              const LV2_URID        context,
+              const LV2_Atom* const value)
+{
+  uint32_t hash = 2166136261U;
+  hash          = hash_bytes(hash, &key, sizeof(key));
+  hash          = hash_bytes(hash, &context, sizeof(context));
+  return hash_bytes(hash, value, sizeof(LV2_Atom) + value->size);
+}
+
+static size_t
+count_properties(const LV2_Atom_Object* const object)
+{
+  size_t n = 0U;
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(&object->body);
+       !lv2_atom_object_is_end(&object->body, object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    ++n;
+  }
+
+  return n;
+}
+
+/// Build a table of the properties of an object, which may be null
+static bool
+prop_table_init(PropTable* const table, const LV2_Atom_Object* const object)
+{
+  const size_t n_props = object ? count_properties(object) : 0U;
+
+  table->cap = 8U;
+  while (table->cap < n_props * 2U) {
+    table->cap *= 2U;
+  }
+
+  if (!(table->slots = (PropSlot*)calloc(table->cap, sizeof(PropSlot)))) {
+    return false;
+  }
+
+  for (const LV2_Atom_Property_Body* p =
+         object ? lv2_atom_object_begin(&object->body) : NULL;
+       p && !lv2_atom_object_is_end(&object->body, object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    const uint32_t hash = hash_property(p->key, p->context, &p->value);
+
+    size_t i = hash & (table->cap - 1U);
+    while (table->slots[i].prop) {
+      i = (i + 1U) & (table->cap - 1U);
+    }
+
+    table->slots[i].prop = p;
+    table->slots[i].hash = hash;
+  }
+
+  return true;
+}
+
+/**
+   Find an equal property in the table.
+
+   If `unmatched` is true, only a property that hasn't been matched yet is
+   found, and it is marked as matched, so each property matches at most once.
+*/
+static PropSlot*
+prop_table_match(const PropTable* const table,
+                 const LV2_URID         key,
+                 const LV2_URID         context,
+                 const LV2_Atom* const  value,
+                 const bool             unmatched)
+{
+  const uint32_t hash = hash_property(key, context, value);
+
+  size_t i = hash & (table->cap - 1U);
+  for (; table->slots[i].prop; i = (i + 1U) & (table->cap - 1U)) {
+    PropSlot* const                     slot = &table->slots[i];
+    const LV2_Atom_Property_Body* const p    = slot->prop;
+    if (slot->hash == hash && p->key == key && p->context == context &&
+        lv2_atom_equals(&p->value, value) && !(unmatched && slot->matched)) {
+      slot->matched = slot->matched || unmatched;
+      return slot;
+    }
+  }
+
+  return NULL;
+}
+
+/// Return true if a property in the table was matched by another
+static bool
+prop_table_matched(const PropTable* const              table,
+                   const LV2_Atom_Property_Body* const prop)
+{
+  const uint32_t hash = hash_property(prop->key, prop->context, &prop->value);
+
+  size_t i = hash & (table->cap - 1U);
+  for (; table->slots[i].prop; i = (i + 1U) & (table->cap - 1U)) {
+    if (table->slots[i].prop == prop) {
+      return table->slots[i].matched;
+    }
+  }
+
+  return false;
+}
+
+static LV2_Atom_Forge_Ref
+forge_property(LV2_Atom_Forge* const forge, const LV2_Atom_Property_Body* p)
+{
+  return lv2_atom_forge_property_head(forge, p->key, p->context)
+           ? lv2_atom_forge_write(
+               forge, &p->value, (uint32_t)sizeof(LV2_Atom) + p->value.size)
+           : 0;
+}
+
+LV2_Atom_Forge_Ref
+delta_forge(LV2_Atom_Forge* const        forge,
+            const DeltaUris* const       uris,
+            const LV2_Atom_Object* const old_object,
+            const LV2_Atom_Object* const new_object)
+{
+  if (!lv2_atom_forge_is_object_type(forge, old_object->atom.type) ||
+      !lv2_atom_forge_is_object_type(forge, new_object->atom.type)) {
+    return 0;
+  }
+
+  // Match every old property with an equal new one
+  PropTable table = {NULL, 0U};
+  if (!prop_table_init(&table, new_object)) {
+    return 0;
+  }
+
+  const LV2_Atom_Object_Body* const old_body = &old_object->body;
+  const LV2_Atom_Object_Body* const new_body = &new_object->body;
+
+  const bool changed_type = old_body->otype != new_body->otype;
+
+  LV2_Atom_Forge_Frame     patch_frame;
+  LV2_Atom_Forge_Frame     remove_frame = {NULL, 0};
+  LV2_Atom_Forge_Frame     add_frame    = {NULL, 0};
+  const LV2_Atom_Forge_Ref ref =
+    lv2_atom_forge_object(forge, &patch_frame, 0U, uris->Patch);
+
+  bool ok = ref;
+
+  if (ok && new_body->id) {
+    ok = lv2_atom_forge_key(forge, uris->subject) &&
+         lv2_atom_forge_urid(forge, new_body->id);
+  }
+
+  // Remove old properties that aren't in the new object
+  ok = ok && lv2_atom_forge_key(forge, uris->remove) &&
+       lv2_atom_forge_object(
+         forge, &remove_frame, 0U, changed_type ? old_body->otype : 0U);
+
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(old_body);
+       ok && !lv2_atom_object_is_end(old_body, old_object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    if (!prop_table_match(&table, p->key, p->context, &p->value, true)) {
+      ok = forge_property(forge, p);
+    }
+  }
+
+  // Frames are popped even after an overflow, so none are left on the stack
+  lv2_atom_forge_pop(forge, &remove_frame);
+
+  // Add new properties that weren't matched by an old one
+  ok = ok && lv2_atom_forge_key(forge, uris->add) &&
+       lv2_atom_forge_object(
+         forge, &add_frame, 0U, changed_type ? new_body->otype : 0U);
+
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(new_body);
+       ok && !lv2_atom_object_is_end(new_body, new_object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    if (!prop_table_matched(&table, p)) {
+      ok = forge_property(forge, p);
+    }
+  }
+
+  lv2_atom_forge_pop(forge, &add_frame);
+  lv2_atom_forge_pop(forge, &patch_frame);
+
+  free(table.slots);
+  return ok ? ref : 0;
+}
+
+/// Return the object value of a patch property, or null if it is missing
+static const LV2_Atom_Object*
+patch_object(const LV2_Atom_Forge* const  forge,
+             const LV2_Atom_Object* const patch,
+             const LV2_URID               key,
+             bool* const                  valid)
+{
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(&patch->body);
+       !lv2_atom_object_is_end(&patch->body, patch->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    if (p->key == key) {
+      *valid = lv2_atom_forge_is_object_type(forge, p->value.type);
+      return *valid ? (const LV2_Atom_Object*)&p->value : NULL;
+    }
+  }
+
+  return NULL;
+}
+
+LV2_Atom_Forge_Ref
+delta_apply(LV2_Atom_Forge* const        forge,
+            const DeltaUris* const       uris,
+            const LV2_Atom_Object* const object,
+            const LV2_Atom_Object* const patch)
+{
+  bool valid = lv2_atom_forge_is_object_type(forge, object->atom.type) &&
+               lv2_atom_forge_is_object_type(forge, patch->atom.type) &&
+               patch->body.otype == uris->Patch;
+
+  const LV2_Atom_Object* const remove =
+    valid ? patch_object(forge, patch, uris->remove, &valid) : NULL;
+  const LV2_Atom_Object* const add =
+    valid ? patch_object(forge, patch, uris->add, &valid) : NULL;
+
+  PropTable table = {NULL, 0U};
+  if (!valid || !prop_table_init(&table, remove)) {
+    return 0;
+  }
+
+  const LV2_Atom_Object_Body* const body = &object->body;
+
+  LV2_URID otype = body->otype;
+  if (remove && remove->body.otype == otype) {
+    otype = 0U;
+  }
+
+  if (add && add->body.otype) {
+    otype = add->body.otype;
+  }
+
+  const LV2_Atom_URID wildcard = {{sizeof(LV2_URID), forge->URID},
+                                  uris->wildcard};
+
+  // Copy the properties that aren't removed
+  LV2_Atom_Forge_Frame     frame;
+  const LV2_Atom_Forge_Ref ref =
+    lv2_atom_forge_object(forge, &frame, body->id, otype);
+
+  bool ok = ref;
+
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(body);
+       ok && !lv2_atom_object_is_end(body, object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    if (!prop_table_match(&table, p->key, p->context, &p->value, true) &&
+        !prop_table_match(&table, p->key, p->context, &wildcard.atom, false)) {
+      ok = forge_property(forge, p);
+    }
+  }
+
+  // Append the added properties
+  for (const LV2_Atom_Property_Body* p =
+         add ? lv2_atom_object_begin(&add->body) : NULL;
+       ok && p && !lv2_atom_object_is_end(&add->body, add->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    ok = forge_property(forge, p);
+  }
+
+  lv2_atom_forge_pop(forge, &frame);
+
+  free(table.slots);
+  return ok ? ref : 0;
+}
@@ -0,0 +1,54 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_DELTA_H
+#define SRATOM_SRC_DELTA_H
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/urid/urid.h>
+
+/// URIDs of the patch vocabulary used for deltas
+typedef struct {
+  LV2_URID Patch;
+  LV2_URID add;
+  LV2_URID remove;
+  LV2_URID subject;
+  LV2_URID wildcard;
+} DeltaUris;
+
+/**
+   Forge a patch that changes one object into another.
+
+   The patch is a patch:Patch with a patch:remove object that has the
+   properties only in `old_object`, and a patch:add object that has the
+   properties only in `new_object`.  Properties are compared by key, context,
+   and value, so a changed value is removed and added, and several values
+   for the same key are handled like any others.  A changed object type is
+   the type of the remove and add objects.
+
+   @return A reference to the patch, or zero if the forge overflowed or
+   allocation failed.
+*/
+LV2_Atom_Forge_Ref
+delta_forge(LV2_Atom_Forge*        forge,
+            const DeltaUris*       uris,
+            const LV2_Atom_Object* old_object,
+            const LV2_Atom_Object* new_object);
+
+/**
+   Forge an object with a patch applied to it.
+
+   Removed properties are matched exactly, or by key and context if the value
+   is patch:wildcard, then the added properties are appended.
+
+   @return A reference to the patched object, or zero if the patch is
+   invalid, the forge overflowed, or allocation failed.
+*/
+LV2_Atom_Forge_Ref
+delta_apply(LV2_Atom_Forge*        forge,
+            const DeltaUris*       uris,
+            const LV2_Atom_Object* object,
+            const LV2_Atom_Object* patch);
+
+#endif /* SRATOM_SRC_DELTA_H */
@@ -0,0 +1,158 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "hex.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  define HEX_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+static const char hex_chars[] = "0123456789ABCDEF";
+
+/// Return the value of a hex digit, or a value above 15 if it is invalid
+static inline unsigned
+hex_digit_value(const char c)
+{
+  const unsigned digit = (unsigned)(uint8_t)c - '0';
+  if (digit < 10U) {
+    return digit;
+  }
+
+  const unsigned letter = ((unsigned)(uint8_t)c | 0x20U) - 'a';
+  return (letter < 6U) ? letter + 10U : 16U;
+}
+
+#ifdef HEX_SSE2
+
+/// Convert 16 nibbles to hex characters
+static inline __m128i
+nibbles_to_hex(const __m128i nibbles)
+{
+  const __m128i is_letter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+  const __m128i gap_width = _mm_set1_epi8('A' - '9' - 1);
+  const __m128i gap       = _mm_and_si128(is_letter, gap_width);
+
+  return _mm_add_epi8(nibbles, _mm_add_epi8(_mm_set1_epi8('0'), gap));
+}
+
+/// Encode 16 bytes to 32 hex characters
+static inline void
+encode_block(char* const dst, const uint8_t* const src)
+{
+  const __m128i mask  = _mm_set1_epi8(0x0F);
+  const __m128i bytes = _mm_loadu_si128((const __m128i*)src);
+  const __m128i hi    = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+  const __m128i lo    = _mm_and_si128(bytes, mask);
+  const __m128i first = nibbles_to_hex(_mm_unpacklo_epi8(hi, lo));
+  const __m128i last  = nibbles_to_hex(_mm_unpackhi_epi8(hi, lo));
+
+  _mm_storeu_si128((__m128i*)dst, first);
+  _mm_storeu_si128((__m128i*)(dst + 16), last);
+}
+
+/// Return the values of 16 hex characters, and set `valid` to a lane mask
+static inline __m128i
+hex_to_nibbles(const __m128i chars, __m128i* const valid)
+{
+  const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+  const __m128i is_digit =
+    _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                  _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+  const __m128i is_letter =
+    _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                  _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+  *valid = _mm_or_si128(is_digit, is_letter);
+
+  const __m128i digits =
+    _mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+  const __m128i letters =
+    _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+
+  return _mm_or_si128(digits, letters);
+}
+
+/// Combine pairs of nibbles in 8 16-bit lanes into bytes in 16-bit lanes
+static inline __m128i
+pack_nibbles(const __m128i nibbles)
+{
+  const __m128i mask = _mm_set1_epi16(0xFF);
+  const __m128i hi   = _mm_slli_epi16(_mm_and_si128(nibbles, mask), 4);
+  const __m128i lo   = _mm_srli_epi16(nibbles, 8);
+
+  return _mm_or_si128(hi, lo);
+}
+
+/// Decode 32 hex characters to 16 bytes, returning false if any are invalid
+static inline bool
+decode_block(uint8_t* const dst, const char* const src)
+{
+  __m128i valid_first = _mm_setzero_si128();
+  __m128i valid_last  = _mm_setzero_si128();
+
+  const __m128i first = hex_to_nibbles(
+    _mm_loadu_si128((const __m128i*)src), &valid_first);
+  const __m128i last = hex_to_nibbles(
+    _mm_loadu_si128((const __m128i*)(src + 16)), &valid_last);
+
+  if (_mm_movemask_epi8(_mm_and_si128(valid_first, valid_last)) != 0xFFFF) {
+    return false;
+  }
+
+  _mm_storeu_si128(
+    (__m128i*)dst,
+    _mm_packus_epi16(pack_nibbles(first), pack_nibbles(last)));
+
+  return true;
+}
+
+#endif
+
+void
+hex_encode(char* const dst, const uint8_t* const src, const size_t size)
+{
+  size_t i = 0U;
+
+#ifdef HEX_SSE2
+  for (; i + 16U <= size; i += 16U) {
+    encode_block(dst + (2U * i), src + i);
+  }
+#endif
+
+  for (; i < size; ++i) {
+    dst[2U * i]        = hex_chars[src[i] >> 4U];
+    dst[(2U * i) + 1U] = hex_chars[src[i] & 0x0FU];
+  }
+}
+
+bool
+hex_decode(uint8_t* const dst, const char* const src, const size_t len)
+{
+  const size_t size = len / 2U;
+  size_t       i    = 0U;
+
+#ifdef HEX_SSE2
+  for (; i + 16U <= size; i += 16U) {
+    if (!decode_block(dst + i, src + (2U * i))) {
+      return false;
+    }
+  }
+#endif
+
+  for (; i < size; ++i) {
+    const unsigned hi = hex_digit_value(src[2U * i]);
+    const unsigned lo = hex_digit_value(src[(2U * i) + 1U]);
+    if (hi > 15U || lo > 15U) {
+      return false;
+    }
+
+    dst[i] = (uint8_t)((hi << 4U) | lo);
+  }
+
+  return true;
+}
@@ -0,0 +1,35 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_HEX_H
+#define SRATOM_SRC_HEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+   Encode bytes as upper-case hexadecimal digits.
+
+   @param dst Output buffer of at least `size * 2` characters, which is not
+   null-terminated.
+   @param src Bytes to encode.
+   @param size Number of bytes to encode.
+*/
+void
+hex_encode(char* dst, const uint8_t* src, size_t size);
+
+/**
+   Decode hexadecimal digits to bytes.
+
+   Both upper and lower case digits are accepted.
+
+   @param dst Output buffer of at least `len / 2` bytes.
+   @param src Hexadecimal digits to decode.
+   @param len Number of digits, which must be even.
+   @return True on success, or false if `src` contains a non-hex character.
+*/
+bool
+hex_decode(uint8_t* dst, const char* src, size_t len);
+
+#endif /* SRATOM_SRC_HEX_H */
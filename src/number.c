@@ -0,0 +1,724 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "number.h"
+
+#include <locale.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+  Floating point numbers are formatted with Grisu2 (Florian Loitsch, "Printing
+  Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010),
+  which always produces digits that read back exactly, and nearly always the
+  fewest such digits.
+*/
+
+/// A "do-it-yourself" floating point number, f * 2^e
+typedef struct {
+  uint64_t f;
+  int      e;
+} DiyFp;
+
+/// Normalized powers of ten from 1e-348 to 1e340 in steps of 8
+static const DiyFp cached_powers[] = {
+  {0xFA8FD5A0081C0288U, -1220}, // 1e-348
+  {0xBAAEE17FA23EBF76U, -1193}, // 1e-340
+  {0x8B16FB203055AC76U, -1166}, // 1e-332
+  {0xCF42894A5DCE35EAU, -1140}, // 1e-324
+  {0x9A6BB0AA55653B2DU, -1113}, // 1e-316
+  {0xE61ACF033D1A45DFU, -1087}, // 1e-308
+  {0xAB70FE17C79AC6CAU, -1060}, // 1e-300
+  {0xFF77B1FCBEBCDC4FU, -1034}, // 1e-292
+  {0xBE5691EF416BD60CU, -1007}, // 1e-284
+  {0x8DD01FAD907FFC3CU, -980}, // 1e-276
+  {0xD3515C2831559A83U, -954}, // 1e-268
+  {0x9D71AC8FADA6C9B5U, -927}, // 1e-260
+  {0xEA9C227723EE8BCBU, -901}, // 1e-252
+  {0xAECC49914078536DU, -874}, // 1e-244
+  {0x823C12795DB6CE57U, -847}, // 1e-236
+  {0xC21094364DFB5637U, -821}, // 1e-228
+  {0x9096EA6F3848984FU, -794}, // 1e-220
+  {0xD77485CB25823AC7U, -768}, // 1e-212
+  {0xA086CFCD97BF97F4U, -741}, // 1e-204
+  {0xEF340A98172AACE5U, -715}, // 1e-196
+  {0xB23867FB2A35B28EU, -688}, // 1e-188
+  {0x84C8D4DFD2C63F3BU, -661}, // 1e-180
+  {0xC5DD44271AD3CDBAU, -635}, // 1e-172
+  {0x936B9FCEBB25C996U, -608}, // 1e-164
+  {0xDBAC6C247D62A584U, -582}, // 1e-156
+  {0xA3AB66580D5FDAF6U, -555}, // 1e-148
+  {0xF3E2F893DEC3F126U, -529}, // 1e-140
+  {0xB5B5ADA8AAFF80B8U, -502}, // 1e-132
+  {0x87625F056C7C4A8BU, -475}, // 1e-124
+  {0xC9BCFF6034C13053U, -449}, // 1e-116
+  {0x964E858C91BA2655U, -422}, // 1e-108
+  {0xDFF9772470297EBDU, -396}, // 1e-100
+  {0xA6DFBD9FB8E5B88FU, -369}, // 1e-92
+  {0xF8A95FCF88747D94U, -343}, // 1e-84
+  {0xB94470938FA89BCFU, -316}, // 1e-76
+  {0x8A08F0F8BF0F156BU, -289}, // 1e-68
+  {0xCDB02555653131B6U, -263}, // 1e-60
+  {0x993FE2C6D07B7FACU, -236}, // 1e-52
+  {0xE45C10C42A2B3B06U, -210}, // 1e-44
+  {0xAA242499697392D3U, -183}, // 1e-36
+  {0xFD87B5F28300CA0EU, -157}, // 1e-28
+  {0xBCE5086492111AEBU, -130}, // 1e-20
+  {0x8CBCCC096F5088CCU, -103}, // 1e-12
+  {0xD1B71758E219652CU, -77}, // 1e-4
+  {0x9C40000000000000U, -50}, // 1e4
+  {0xE8D4A51000000000U, -24}, // 1e12
+  {0xAD78EBC5AC620000U, 3}, // 1e20
+  {0x813F3978F8940984U, 30}, // 1e28
+  {0xC097CE7BC90715B3U, 56}, // 1e36
+  {0x8F7E32CE7BEA5C70U, 83}, // 1e44
+  {0xD5D238A4ABE98068U, 109}, // 1e52
+  {0x9F4F2726179A2245U, 136}, // 1e60
+  {0xED63A231D4C4FB27U, 162}, // 1e68
+  {0xB0DE65388CC8ADA8U, 189}, // 1e76
+  {0x83C7088E1AAB65DBU, 216}, // 1e84
+  {0xC45D1DF942711D9AU, 242}, // 1e92
+  {0x924D692CA61BE758U, 269}, // 1e100
+  {0xDA01EE641A708DEAU, 295}, // 1e108
+  {0xA26DA3999AEF774AU, 322}, // 1e116
+  {0xF209787BB47D6B85U, 348}, // 1e124
+  {0xB454E4A179DD1877U, 375}, // 1e132
+  {0x865B86925B9BC5C2U, 402}, // 1e140
+  {0xC83553C5C8965D3DU, 428}, // 1e148
+  {0x952AB45CFA97A0B3U, 455}, // 1e156
+  {0xDE469FBD99A05FE3U, 481}, // 1e164
+  {0xA59BC234DB398C25U, 508}, // 1e172
+  {0xF6C69A72A3989F5CU, 534}, // 1e180
+  {0xB7DCBF5354E9BECEU, 561}, // 1e188
+  {0x88FCF317F22241E2U, 588}, // 1e196
+  {0xCC20CE9BD35C78A5U, 614}, // 1e204
+  {0x98165AF37B2153DFU, 641}, // 1e212
+  {0xE2A0B5DC971F303AU, 667}, // 1e220
+  {0xA8D9D1535CE3B396U, 694}, // 1e228
+  {0xFB9B7CD9A4A7443CU, 720}, // 1e236
+  {0xBB764C4CA7A44410U, 747}, // 1e244
+  {0x8BAB8EEFB6409C1AU, 774}, // 1e252
+  {0xD01FEF10A657842CU, 800}, // 1e260
+  {0x9B10A4E5E9913129U, 827}, // 1e268
+  {0xE7109BFBA19C0C9DU, 853}, // 1e276
+  {0xAC2820D9623BF429U, 880}, // 1e284
+  {0x80444B5E7AA7CF85U, 907}, // 1e292
+  {0xBF21E44003ACDD2DU, 933}, // 1e300
+  {0x8E679C2F5E44FF8FU, 960}, // 1e308
+  {0xD433179D9C8CB841U, 986}, // 1e316
+  {0x9E19DB92B4E31BA9U, 1013}, // 1e324
+  {0xEB96BF6EBADF77D9U, 1039}, // 1e332
+  {0xAF87023B9BF0EE6BU, 1066}, // 1e340
+};
+
+static const uint64_t pow10_u64[] = {1U,
+                                     10U,
+                                     100U,
+                                     1000U,
+                                     10000U,
+                                     100000U,
+                                     1000000U,
+                                     10000000U,
+                                     100000000U,
+                                     1000000000U,
+                                     10000000000U,
+                                     100000000000U,
+                                     1000000000000U,
+                                     10000000000000U,
+                                     100000000000000U,
+                                     1000000000000000U,
+                                     10000000000000000U,
+                                     100000000000000000U,
+                                     1000000000000000000U,
+                                     10000000000000000000U};
+
+static DiyFp
+diy_multiply(const DiyFp x, const DiyFp y)
+{
+  const uint64_t m32 = 0xFFFFFFFFU;
+  const uint64_t a   = x.f >> 32U;
+  const uint64_t b   = x.f & m32;
+  const uint64_t c   = y.f >> 32U;
+  const uint64_t d   = y.f & m32;
+  const uint64_t ac  = a * c;
+  const uint64_t bc  = b * c;
+  const uint64_t ad  = a * d;
+  const uint64_t bd  = b * d;
+  const uint64_t mid = (bd >> 32U) + (ad & m32) + (bc & m32) + (1U << 31U);
+
+  const DiyFp r = {ac + (ad >> 32U) + (bc >> 32U) + (mid >> 32U),
+                   x.e + y.e + 64};
+  return r;
+}
+
+static DiyFp
+diy_normalize(DiyFp x)
+{
+  while (!(x.f & ((uint64_t)1U << 63U))) {
+    x.f <<= 1U;
+    --x.e;
+  }
+
+  return x;
+}
+
+/// Return the cached power c such that the product with 2^e is in range
+static DiyFp
+cached_power(const int e, int* const k10)
+{
+  const double dk = ((-61 - e) * 0.30102999566398114) + 347;
+  int          k  = (int)dk;
+  if (dk - k > 0.0) {
+    ++k;
+  }
+
+  const unsigned index = (unsigned)((k >> 3) + 1);
+  *k10                 = -(-348 + (int)(index * 8U));
+  return cached_powers[index];
+}
+
+static unsigned
+count_digits(const uint32_t n)
+{
+  unsigned count = 1U;
+  for (uint32_t m = n; m >= 10U; m /= 10U) {
+    ++count;
+  }
+
+  return count;
+}
+
+static void
+grisu_round(char* const    digits,
+            const unsigned len,
+            const uint64_t delta,
+            uint64_t       rest,
+            const uint64_t ten_kappa,
+            const uint64_t wp_w)
+{
+  while (rest < wp_w && delta - rest >= ten_kappa &&
+         (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+    --digits[len - 1U];
+    rest += ten_kappa;
+  }
+}
+
+/// Generate the digits of `w` within the interval [mp - delta, mp]
+static unsigned
+digit_gen(const DiyFp w,
+          const DiyFp mp,
+          uint64_t    delta,
+          char* const digits,
+          int* const  k10)
+{
+  const unsigned shift = (unsigned)-mp.e;
+  const uint64_t one   = (uint64_t)1U << shift;
+  const uint64_t wp_w  = mp.f - w.f;
+  uint32_t       p1    = (uint32_t)(mp.f >> shift);
+  uint64_t       p2    = mp.f & (one - 1U);
+  unsigned       len   = 0U;
+
+  for (int kappa = (int)count_digits(p1); kappa > 0;) {
+    const uint32_t div = (uint32_t)pow10_u64[kappa - 1];
+    const uint32_t d   = p1 / div;
+
+    p1 %= div;
+    if (d || len) {
+      digits[len++] = (char)('0' + d);
+    }
+
+    --kappa;
+    const uint64_t rest = ((uint64_t)p1 << shift) + p2;
+    if (rest <= delta) {
+      *k10 += kappa;
+      grisu_round(
+        digits, len, delta, rest, pow10_u64[kappa] << shift, wp_w);
+      return len;
+    }
+  }
+
+  for (int kappa = 0;;) {
+    p2 *= 10U;
+    delta *= 10U;
+
+    const char d = (char)(p2 >> shift);
+    if (d || len) {
+      digits[len++] = (char)('0' + d);
+    }
+
+    p2 &= one - 1U;
+    --kappa;
+    if (p2 < delta) {
+      const unsigned index = (unsigned)-kappa;
+
+      *k10 += kappa;
+      grisu_round(digits,
+                  len,
+                  delta,
+                  p2,
+                  one,
+                  wp_w * (index < 20U ? pow10_u64[index] : 0U));
+      return len;
+    }
+  }
+}
+
+/**
+   Generate the shortest digits for a positive value f * 2^e.
+
+   @param f Significand, including the hidden bit if normal.
+   @param e Binary exponent.
+   @param lower_closer True if the lower neighbour is closer than the upper.
+   @param digits Output digits, at least 20 characters.
+   @param k10 Set to the decimal exponent, so the value is digits * 10^k10.
+   @return The number of digits.
+*/
+static unsigned
+grisu2(const uint64_t f,
+       const int      e,
+       const bool     lower_closer,
+       char* const    digits,
+       int* const     k10)
+{
+  const DiyFp v      = {f, e};
+  const DiyFp upper  = {(f << 1U) + 1U, e - 1};
+  const DiyFp mplus  = diy_normalize(upper);
+  DiyFp       mminus = {(f << 1U) - 1U, e - 1};
+  if (lower_closer) {
+    mminus.f = (f << 2U) - 1U;
+    mminus.e = e - 2;
+  }
+
+  mminus.f <<= (unsigned)(mminus.e - mplus.e);
+  mminus.e = mplus.e;
+
+  int         mk = 0;
+  const DiyFp c  = cached_power(mplus.e, &mk);
+  const DiyFp w  = diy_multiply(diy_normalize(v), c);
+  DiyFp       wp = diy_multiply(mplus, c);
+  DiyFp       wm = diy_multiply(mminus, c);
+
+  // Shrink the interval by one unit to account for rounding errors
+  ++wm.f;
+  --wp.f;
+
+  *k10 = mk;
+  return digit_gen(w, wp, wp.f - wm.f, digits, k10);
+}
+
+/// Write a string and return its length
+static size_t
+write_string(char* const buf, const char* const str)
+{
+  const size_t len = strlen(str);
+  memcpy(buf, str, len + 1U);
+  return len;
+}
+
+/// Write the digits of a value, digits * 10^k10, in a readable notation
+static size_t
+write_digits(char* const       buf,
+             const bool        negative,
+             const char* const digits,
+             const unsigned    len,
+             const int         k10)
+{
+  const int point = (int)len + k10; // Position of the decimal point
+  char*     s     = buf;
+
+  if (negative) {
+    *s++ = '-';
+  }
+
+  if (point > 0 && point <= 21) {
+    if (k10 >= 0) {
+      // Integer like "1200.0"
+      memcpy(s, digits, len);
+      memset(s + len, '0', (size_t)k10);
+      s += point;
+      *s++ = '.';
+      *s++ = '0';
+    } else {
+      // Decimal like "12.5"
+      memcpy(s, digits, (size_t)point);
+      s += point;
+      *s++ = '.';
+      memcpy(s, digits + point, len - (unsigned)point);
+      s += len - (unsigned)point;
+    }
+  } else if (point <= 0 && point > -5) {
+    // Small decimal like "0.00125"
+    *s++ = '0';
+    *s++ = '.';
+    memset(s, '0', (size_t)-point);
+    s += -point;
+    memcpy(s, digits, len);
+    s += len;
+  } else {
+    // Scientific notation like "1.25E-7"
+    *s++ = digits[0];
+    *s++ = '.';
+    if (len > 1U) {
+      memcpy(s, digits + 1, len - 1U);
+      s += len - 1U;
+    } else {
+      *s++ = '0';
+    }
+
+    *s++ = 'E';
+    s += number_format_integer(s, point - 1);
+  }
+
+  *s = '\0';
+  return (size_t)(s - buf);
+}
+
+size_t
+number_format_integer(char* const buf, const int64_t value)
+{
+  char     digits[20];
+  unsigned len = 0U;
+  uint64_t mag = (value < 0) ? 0U - (uint64_t)value : (uint64_t)value;
+
+  do {
+    digits[len++] = (char)('0' + (mag % 10U));
+    mag /= 10U;
+  } while (mag);
+
+  char* s = buf;
+  if (value < 0) {
+    *s++ = '-';
+  }
+
+  while (len) {
+    *s++ = digits[--len];
+  }
+
+  *s = '\0';
+  return (size_t)(s - buf);
+}
+
+size_t
+number_format_double(char* const buf, const double value)
+{
+  uint64_t bits = 0U;
+  memcpy(&bits, &value, sizeof(bits));
+
+  const bool     negative = bits >> 63U;
+  const unsigned biased   = (unsigned)((bits >> 52U) & 0x7FFU);
+  const uint64_t fraction = bits & (((uint64_t)1U << 52U) - 1U);
+
+  if (biased == 0x7FFU) {
+    return write_string(buf, fraction ? "NaN" : negative ? "-INF" : "INF");
+  }
+
+  if (!biased && !fraction) {
+    return write_string(buf, negative ? "-0.0" : "0.0");
+  }
+
+  const uint64_t hidden = (uint64_t)1U << 52U;
+  const uint64_t f      = biased ? (fraction | hidden) : fraction;
+  const int      e      = biased ? (int)biased - 1075 : -1074;
+
+  char           digits[20];
+  int            k10 = 0;
+  const unsigned len = grisu2(f, e, !fraction && biased > 1U, digits, &k10);
+
+  return write_digits(buf, negative, digits, len, k10);
+}
+
+size_t
+number_format_float(char* const buf, const float value)
+{
+  uint32_t bits = 0U;
+  memcpy(&bits, &value, sizeof(bits));
+
+  const bool     negative = bits >> 31U;
+  const unsigned biased   = (bits >> 23U) & 0xFFU;
+  const uint32_t fraction = bits & ((1U << 23U) - 1U);
+
+  if (biased == 0xFFU) {
+    return write_string(buf, fraction ? "NaN" : negative ? "-INF" : "INF");
+  }
+
+  if (!biased && !fraction) {
+    return write_string(buf, negative ? "-0.0" : "0.0");
+  }
+
+  const uint32_t hidden = 1U << 23U;
+  const uint32_t f      = biased ? (fraction | hidden) : fraction;
+  const int      e      = biased ? (int)biased - 150 : -149;
+
+  char           digits[20];
+  int            k10 = 0;
+  const unsigned len = grisu2(f, e, !fraction && biased > 1U, digits, &k10);
+
+  return write_digits(buf, negative, digits, len, k10);
+}
+
+/// A scanned decimal number, mantissa * 10^exponent
+typedef struct {
+  const char* start;     ///< Start of number, after any whitespace
+  const char* end;       ///< End of number
+  uint64_t    mantissa;  ///< Up to 19 significant digits
+  int         exponent;  ///< Decimal exponent of mantissa
+  bool        negative;  ///< True if there is a leading minus sign
+  bool        truncated; ///< True if non-zero digits were dropped
+} Decimal;
+
+static const char*
+skip_space(const char* s)
+{
+  while (*s == ' ' || *s == '\t' || *s == '\n' || *s == '\r' || *s == '\f' ||
+         *s == '\v') {
+    ++s;
+  }
+
+  return s;
+}
+
+static bool
+is_digit(const char c)
+{
+  return (unsigned)(uint8_t)c - '0' < 10U;
+}
+
+/// Return the length of a case-insensitive match of `word` at `s`, or zero
+static size_t
+match_word(const char* const s, const char* const word)
+{
+  size_t i = 0U;
+  for (; word[i]; ++i) {
+    if (((unsigned)(uint8_t)s[i] | 0x20U) != (unsigned)(uint8_t)word[i]) {
+      return 0U;
+    }
+  }
+
+  return i;
+}
+
+/// Add a digit to a decimal, dropping it if there are too many to fit
+static void
+add_digit(Decimal* const  d,
+          unsigned* const n_digits,
+          const unsigned  digit,
+          const bool      is_fraction)
+{
+  if (*n_digits < 19U) {
+    d->mantissa = (d->mantissa * 10U) + digit;
+    d->exponent -= is_fraction;
+    *n_digits += (d->mantissa != 0U);
+  } else {
+    d->truncated |= (digit != 0U);
+    d->exponent += !is_fraction;
+  }
+}
+
+/// Scan a finite decimal number, returning false if there is none
+static bool
+scan_decimal(const char* const str, Decimal* const d)
+{
+  const char* s = skip_space(str);
+
+  d->start     = s;
+  d->end       = str;
+  d->mantissa  = 0U;
+  d->exponent  = 0;
+  d->negative  = (*s == '-');
+  d->truncated = false;
+
+  if (*s == '-' || *s == '+') {
+    ++s;
+  }
+
+  unsigned n_digits = 0U;
+  bool     any      = false;
+  for (; is_digit(*s); ++s) {
+    add_digit(d, &n_digits, (unsigned)(*s - '0'), false);
+    any = true;
+  }
+
+  if (*s == '.') {
+    for (++s; is_digit(*s); ++s) {
+      add_digit(d, &n_digits, (unsigned)(*s - '0'), true);
+      any = true;
+    }
+  }
+
+  if (!any) {
+    return false;
+  }
+
+  if ((*s == 'e' || *s == 'E') &&
+      (is_digit(s[1]) || ((s[1] == '-' || s[1] == '+') && is_digit(s[2])))) {
+    const bool negative_exponent = (s[1] == '-');
+    int        exponent          = 0;
+
+    for (s += (is_digit(s[1]) ? 1 : 2); is_digit(*s); ++s) {
+      if (exponent < 100000) {
+        exponent = (exponent * 10) + (*s - '0');
+      }
+    }
+
+    d->exponent += negative_exponent ? -exponent : exponent;
+  }
+
+  d->end = s;
+  return true;
+}
+
+/// Scan "NaN" or "INF" with an optional sign, returning zero if not found
+static size_t
+scan_special(const char* const s, double* const value)
+{
+  const bool   negative = (*s == '-');
+  const size_t sign     = (*s == '-' || *s == '+') ? 1U : 0U;
+  size_t       len      = 0U;
+
+  if ((len = match_word(s + sign, "nan"))) {
+    *value = negative ? -(double)NAN : (double)NAN;
+  } else if ((len = match_word(s + sign, "infinity")) ||
+             (len = match_word(s + sign, "inf"))) {
+    *value = negative ? -(double)INFINITY : (double)INFINITY;
+  } else {
+    return 0U;
+  }
+
+  return sign + len;
+}
+
+/**
+   Parse a scanned decimal with the C library.
+
+   The text is copied to replace the decimal point with that of the current
+   locale, on the stack unless it is unusually long.
+*/
+static double
+parse_with_libc(const Decimal* const d, const bool single)
+{
+  const char   point = localeconv()->decimal_point[0];
+  const size_t len   = (size_t)(d->end - d->start);
+  char         short_str[64];
+  char* const  str =
+    (len < sizeof(short_str)) ? short_str : (char*)malloc(len + 1U);
+  if (!str) {
+    return single ? (double)strtof(d->start, NULL) : strtod(d->start, NULL);
+  }
+
+  memcpy(str, d->start, len);
+  str[len] = '\0';
+  if (point != '.') {
+    char* const dot = strchr(str, '.');
+    if (dot) {
+      *dot = point;
+    }
+  }
+
+  const double value = single ? (double)strtof(str, NULL) : strtod(str, NULL);
+
+  if (str != short_str) {
+    free(str);
+  }
+
+  return value;
+}
+
+int64_t
+number_parse_integer(const char* const str, const char** const end)
+{
+  const char* s        = skip_space(str);
+  const bool  negative = (*s == '-');
+  if (*s == '-' || *s == '+') {
+    ++s;
+  }
+
+  if (!is_digit(*s)) {
+    *end = str;
+    return 0;
+  }
+
+  const uint64_t limit = negative ? (uint64_t)INT64_MAX + 1U : INT64_MAX;
+  uint64_t       mag   = 0U;
+  for (; is_digit(*s); ++s) {
+    const unsigned digit = (unsigned)(*s - '0');
+    mag = (mag > (limit - digit) / 10U) ? limit : (mag * 10U) + digit;
+  }
+
+  *end = s;
+  if (negative) {
+    return (mag == (uint64_t)INT64_MAX + 1U) ? INT64_MIN : -(int64_t)mag;
+  }
+
+  return (int64_t)mag;
+}
+
+double
+number_parse_double(const char* const str, const char** const end)
+{
+  static const double exact_powers[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  Decimal d;
+  if (!scan_decimal(str, &d)) {
+    double       value = 0.0;
+    const size_t len   = scan_special(d.start, &value);
+
+    *end = len ? d.start + len : str;
+    return value;
+  }
+
+  *end = d.end;
+  if (!d.mantissa) {
+    return d.negative ? -0.0 : 0.0;
+  }
+
+  // Values exactly representable as a double and power of ten are exact
+  const uint64_t max_exact = (uint64_t)1U << 53U;
+  if (!d.truncated && d.mantissa <= max_exact && d.exponent >= -22 &&
+      d.exponent <= 22) {
+    const double m = (double)d.mantissa;
+    const double v = (d.exponent < 0) ? m / exact_powers[-d.exponent]
+                                      : m * exact_powers[d.exponent];
+    return d.negative ? -v : v;
+  }
+
+  return parse_with_libc(&d, false);
+}
+
+float
+number_parse_float(const char* const str, const char** const end)
+{
+  static const float exact_powers[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+  Decimal d;
+  if (!scan_decimal(str, &d)) {
+    double       value = 0.0;
+    const size_t len   = scan_special(d.start, &value);
+
+    *end = len ? d.start + len : str;
+    return (float)value;
+  }
+
+  *end = d.end;
+  if (!d.mantissa) {
+    return d.negative ? -0.0f : 0.0f;
+  }
+
+  // Values exactly representable as a float and power of ten are exact
+  const uint64_t max_exact = (uint64_t)1U << 24U;
+  if (!d.truncated && d.mantissa <= max_exact && d.exponent >= -10 &&
+      d.exponent <= 10) {
+    const float m = (float)d.mantissa;
+    const float v = (d.exponent < 0) ? m / exact_powers[-d.exponent]
+                                     : m * exact_powers[d.exponent];
+    return d.negative ? -v : v;
+  }
+
+  return (float)parse_with_libc(&d, true);
+}
@@ -0,0 +1,67 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_NUMBER_H
+#define SRATOM_SRC_NUMBER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Maximum length of a formatted number, not including the null terminator
+#define NUMBER_MAX_LENGTH 24U
+
+/**
+   Format an integer.
+
+   @param buf Output buffer of at least `NUMBER_MAX_LENGTH + 1` characters.
+   @param value Value to format.
+   @return The length of the null-terminated string written to `buf`.
+*/
+size_t
+number_format_integer(char* buf, int64_t value);
+
+/**
+   Format a double with the fewest digits that read back exactly.
+
+   Values with a moderate magnitude are written as decimals like "12.5", and
+   others in scientific notation like "1.25E-7".  The string always contains
+   a decimal point, except for the special values "NaN", "INF", and "-INF".
+
+   @param buf Output buffer of at least `NUMBER_MAX_LENGTH + 1` characters.
+   @param value Value to format.
+   @return The length of the null-terminated string written to `buf`.
+*/
+size_t
+number_format_double(char* buf, double value);
+
+/// Format a float like number_format_double(), but with float precision
+size_t
+number_format_float(char* buf, float value);
+
+/**
+   Parse an integer like strtoll(), saturating on overflow.
+
+   @param str String to parse, which may have leading whitespace.
+   @param end Set to the end of the number, or `str` if there is none.
+*/
+int64_t
+number_parse_integer(const char* str, const char** end);
+
+/**
+   Parse a double, with correct rounding.
+
+   This accepts decimal and scientific notation regardless of the current
+   locale, and the special values "NaN", "INF", and "-INF", case
+   insensitively.
+
+   @param str String to parse, which may have leading whitespace.
+   @param end Set to the end of the number, or `str` if there is none.
+*/
+double
+number_parse_double(const char* str, const char** end);
+
+/// Parse a float like number_parse_double(), with correct rounding
+float
+number_parse_float(const char* str, const char** end);
+
+#endif /* SRATOM_SRC_NUMBER_H */
@@ -1,34 +1,216 @@
 // Copyright 2012-2026 David Robillard <d@drobilla.net>
 // SPDX-License-Identifier: ISC
 
+#include "archive.h"
+#include "arena.h"
+#include "base64.h"
+#include "clock.h"
+#include "delta.h"
+#include "hex.h"
+#include "number.h"
+#include "thread.h"
+#include "turtle.h"
+#include "uri.h"
+
 #include <sratom/sratom.h>
 
 #include <lv2/atom/atom.h>
 #include <lv2/atom/forge.h>
 #include <lv2/atom/util.h>
 #include <lv2/midi/midi.h>
+#include <lv2/patch/patch.h>
+#include <lv2/units/units.h>
 #include <lv2/urid/urid.h>
 #include <serd/serd.h>
 #include <sord/sord.h>
 
-#include <assert.h>
 #include <ctype.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_MSC_VER) && !defined(__GNUC__)
+#  include <intrin.h>
+#endif
+
 #define NS_RDF (const uint8_t*)"http://www.w3.org/1999/02/22-rdf-syntax-ns#"
 #define NS_XSD (const uint8_t*)"http://www.w3.org/2001/XMLSchema#"
 
 #define USTR(str) ((const uint8_t*)(str))
 
-static const SerdStyle style =
-  (SerdStyle)(SERD_STYLE_ABBREVIATED | SERD_STYLE_RESOLVED | SERD_STYLE_CURIED);
+/// Style of the Turtle written by default
+static const SerdStyle turtle_style = (SerdStyle)(
+  SERD_STYLE_ABBREVIATED | SERD_STYLE_RESOLVED | SERD_STYLE_CURIED);
 
 typedef enum { MODE_SUBJECT, MODE_BODY, MODE_SEQUENCE } ReadMode;
 
+/// The kind of an atom type, which determines how it is written
+typedef enum {
+  KIND_VALUE, ///< Unknown type, written as an opaque base64 value object
+  KIND_STRING,
+  KIND_CHUNK,
+  KIND_LITERAL,
+  KIND_URID,
+  KIND_PATH,
+  KIND_URI,
+  KIND_INT,
+  KIND_LONG,
+  KIND_FLOAT,
+  KIND_DOUBLE,
+  KIND_BOOL,
+  KIND_MIDI_EVENT,
+  KIND_EVENT,
+  KIND_TUPLE,
+  KIND_VECTOR,
+  KIND_OBJECT,
+  KIND_SEQUENCE,
+  KIND_COUNT, ///< Number of kinds, not a kind
+} AtomKind;
+
+/// Number of slots in the type table, a power of two well above the kinds
+#define N_TYPE_SLOTS 64U
+
+/// Slot in the open-addressed table from type URID to kind
+typedef struct {
+  LV2_URID type; ///< Type URID, or zero for an empty slot
+  AtomKind kind; ///< Kind of atoms with this type
+} TypeSlot;
+
+/// Literal datatype that is read as a specific kind of atom
+typedef struct {
+  const char* uri;  ///< Datatype URI
+  size_t      len;  ///< Length of URI in bytes
+  AtomKind    kind; ///< Kind of atom to read literals as
+} Datatype;
+
+#define DATATYPE(uri, kind) {uri, sizeof(uri) - 1U, kind}
+
+/// Number of entries in the datatypes table
+#define N_DATATYPES 10U
+
+static const Datatype datatypes[N_DATATYPES] = {
+  DATATYPE("http://www.w3.org/2001/XMLSchema#int", KIND_INT),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#integer", KIND_INT),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#long", KIND_LONG),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#float", KIND_FLOAT),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#decimal", KIND_FLOAT),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#double", KIND_DOUBLE),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#boolean", KIND_BOOL),
+  DATATYPE("http://www.w3.org/2001/XMLSchema#base64Binary", KIND_CHUNK),
+  DATATYPE(LV2_ATOM__Path, KIND_PATH),
+  DATATYPE(LV2_MIDI__MidiEvent, KIND_MIDI_EVENT),
+};
+
+/// Slot in the open-addressed cache from URID to URI node
+typedef struct {
+  LV2_URID urid; ///< URID, or zero for an empty slot
+  SerdNode node; ///< URI node with the unmapped string
+} UriSlot;
+
+/// Slot in the open-addressed cache from URI node to URID
+typedef struct {
+  const SordNode* node; ///< URI node, or null for an empty slot
+  LV2_URID        urid; ///< Mapped URID of node
+} UridSlot;
+
+/// Mapped language URI for reading literals
+typedef struct {
+  const char* tag;  ///< Language tag, allocated in the scratch arena
+  LV2_URID    urid; ///< Mapped URID of the language URI
+} LangSlot;
+
+/// Interned vocabulary nodes used for reading from a model
+typedef struct {
+  SordNode* atom_childType;
+  SordNode* atom_frameTime;
+  SordNode* atom_beatTime;
+  SordNode* atom_timeUnit;
+  SordNode* rdf_first;
+  SordNode* rdf_rest;
+  SordNode* rdf_type;
+  SordNode* rdf_value;
+  SordNode* xsd_base64Binary;
+  SordNode* datatypes[N_DATATYPES]; ///< Nodes for entries in datatypes
+} VocabNodes;
+
+/**
+   Temporary memory and caches used while reading or writing.
+
+   Each Sratom has one that is reused between calls, but it can only be used
+   by one call at a time, so concurrent calls use their own temporary one.
+*/
+typedef struct {
+  Arena            arena;       ///< Temporary nodes and buffers
+  LV2_URID_Unmap   unmap;       ///< Unmap the URI cache was filled with
+  unsigned         unmap_epoch; ///< Epoch of the URI cache contents
+  UriSlot*         uris;        ///< Cache of unmapped URIs for writing
+  size_t           uris_cap;    ///< Number of slots in uris
+  size_t           n_uris;      ///< Number of occupied slots in uris
+  UridSlot*        urids;       ///< Cache of mapped URIDs for reading
+  size_t           urids_cap;   ///< Number of slots in urids
+  size_t           n_urids;     ///< Number of occupied slots in urids
+  LangSlot*        langs;       ///< Cache of mapped languages for reading
+  size_t           langs_cap;   ///< Number of slots in langs
+  size_t           n_langs;     ///< Number of occupied slots in langs
+  SratomCacheStats urid_stats;  ///< Statistics for the URID cache
+} Scratch;
+
+/**
+   An atom serializer.
+
+   Everything here is configuration which isn't modified while reading or
+   writing, except for the scratch space, which is claimed by a call with the
+   scratch_busy flag, and the counters for blank node IDs and URI cache
+   clears, which are only accessed atomically.  The state of a call is kept in
+   a WriteState or ReadState on the stack, so an Sratom can be shared between
+   threads.
+*/
+struct SratomImpl {
+  LV2_URID_Map*          map;
+  LV2_Atom_Forge         forge;
+  SerdEnv*               env;
+  SerdNode               base_uri;
+  SerdURI                base;
+  SerdStatementSink      write_statement;
+  SerdEndSink            end_anon;
+  void*                  handle;
+  LV2_URID               atom_Event;
+  LV2_URID               atom_frameTime;
+  LV2_URID               atom_beatTime;
+  LV2_URID               midi_MidiEvent;
+  TypeSlot               types[N_TYPE_SLOTS];
+  SratomObjectMode       object_mode;
+  SratomVectorEncoding   vector_encoding;
+  SratomSequenceEncoding sequence_encoding;
+  SordWorld*             world;
+  VocabNodes             nodes;
+  Scratch                scratch;
+  Mutex                  model_lock; ///< Held while sord changes a model
+  long                   scratch_busy;
+  long                   next_id;
+  long                   unmap_epoch;
+
+  bool pretty_numbers;
+};
+
+/// State for writing a single top-level atom
+typedef struct {
+  const Sratom*     sratom;
+  Scratch*          scratch;
+  SerdStatementSink write_statement;
+  SerdEndSink       end_anon;
+  void*             handle;
+  const SerdNode*   base_uri;
+  const SerdURI*    base;
+  long*             next_id;
+  uint32_t          seq_unit;
+  TurtleWriter*     writer; ///< Turtle writer for handle, or null
+} WriteState;
+
+/// State for writing an atom at some level of nesting
 typedef struct {
-  Sratom*            sratom;
+  WriteState*        state;
   const SerdNode*    subject;
   const SerdNode*    predicate;
   SerdStatementFlags flags;
@@ -38,56 +220,230 @@ typedef struct {
   SerdNode           node;
 } WriteContext;
 
-struct SratomImpl {
-  LV2_URID_Map*     map;
-  LV2_Atom_Forge    forge;
-  SerdEnv*          env;
-  SerdNode          base_uri;
-  SerdURI           base;
-  SerdStatementSink write_statement;
-  SerdEndSink       end_anon;
-  void*             handle;
-  LV2_URID          atom_Event;
-  LV2_URID          atom_frameTime;
-  LV2_URID          atom_beatTime;
-  LV2_URID          midi_MidiEvent;
-  unsigned          next_id;
-  SratomObjectMode  object_mode;
+/**
+   State for reading a single top-level atom.
+
+   Reading never modifies nodes or their reference counts, so several threads
+   can read from the same model.  Sord counts the live iterators of a model,
+   though, and interning nodes changes the world, so if model_lock is set, it
+   is held while creating or freeing iterators or temporary vocabulary nodes.
+*/
+typedef struct {
+  const Sratom*     sratom;
+  Scratch*          scratch;
+  const VocabNodes* nodes;
+  const SerdURI*    base;
+  Mutex*            model_lock;
   uint32_t          seq_unit;
-  struct {
-    SordNode* atom_childType;
-    SordNode* atom_frameTime;
-    SordNode* atom_beatTime;
-    SordNode* rdf_first;
-    SordNode* rdf_rest;
-    SordNode* rdf_type;
-    SordNode* rdf_value;
-    SordNode* xsd_base64Binary;
-  } nodes;
+} ReadState;
 
-  bool pretty_numbers;
-};
+static SerdStatus
+write_atom(WriteState*     state,
+           LV2_URID_Unmap* unmap,
+           uint32_t        flags,
+           const SerdNode* subject,
+           const SerdNode* predicate,
+           uint32_t        type_urid,
+           uint32_t        size,
+           const void*     body);
 
-static void
-read_node(Sratom*         sratom,
+static SerdStatus
+read_node(ReadState*      state,
           LV2_Atom_Forge* forge,
-          SordWorld*      world,
           SordModel*      model,
           const SordNode* node,
           ReadMode        mode);
 
+static uint32_t
+type_slot_index(const LV2_URID type)
+{
+  return (type * 2654435761U) >> 26U; // Fibonacci hash to 6 bits
+}
+
+static void
+add_type(Sratom* const sratom, const LV2_URID type, const AtomKind kind)
+{
+  if (type) {
+    uint32_t i = type_slot_index(type);
+    while (sratom->types[i].type && sratom->types[i].type != type) {
+      i = (i + 1U) & (N_TYPE_SLOTS - 1U);
+    }
+
+    if (!sratom->types[i].type) {
+      sratom->types[i].type = type;
+      sratom->types[i].kind = kind;
+    }
+  }
+}
+
+static AtomKind
+atom_kind(const Sratom* const sratom, const LV2_URID type)
+{
+  for (uint32_t i = type_slot_index(type); sratom->types[i].type;
+       i = (i + 1U) & (N_TYPE_SLOTS - 1U)) {
+    if (sratom->types[i].type == type) {
+      return sratom->types[i].kind;
+    }
+  }
+
+  return KIND_VALUE;
+}
+
+static void
+scratch_init(Scratch* const scratch)
+{
+  memset(scratch, 0, sizeof(Scratch));
+  arena_init(&scratch->arena);
+}
+
+static void
+scratch_cleanup(Scratch* const scratch)
+{
+  arena_cleanup(&scratch->arena);
+  free(scratch->langs);
+  free(scratch->urids);
+  free(scratch->uris);
+}
+
+/// Atomically set a flag, returning true if it was previously clear
+static bool
+try_set_flag(long* const flag)
+{
+#if defined(__GNUC__)
+  return !__atomic_exchange_n(flag, 1L, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+  return !_InterlockedExchange(flag, 1L);
+#else
+  (void)flag;
+  return false; // Never share scratch space without atomics
+#endif
+}
+
+/// Atomically clear a flag set with try_set_flag()
+static void
+clear_flag(long* const flag)
+{
+#if defined(__GNUC__)
+  __atomic_store_n(flag, 0L, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+  _InterlockedExchange(flag, 0L);
+#else
+  (void)flag;
+#endif
+}
+
+/// Atomically increment a counter, returning its previous value
+static unsigned
+fetch_increment(long* const counter)
+{
+#if defined(__GNUC__)
+  return (unsigned)__atomic_fetch_add(counter, 1L, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+  return (unsigned)(_InterlockedIncrement(counter) - 1L);
+#else
+  return (unsigned)(*counter)++;
+#endif
+}
+
+/// Atomically load a counter incremented with fetch_increment()
+static unsigned
+load_counter(long* const counter)
+{
+#if defined(__GNUC__)
+  return (unsigned)__atomic_load_n(counter, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+  return (unsigned)_InterlockedOr(counter, 0L);
+#else
+  return (unsigned)*counter;
+#endif
+}
+
+/// Remove all entries from the cache of unmapped URIs
+static void
+clear_uris(Scratch* const scratch)
+{
+  if (scratch->n_uris) {
+    memset(scratch->uris, 0, scratch->uris_cap * sizeof(UriSlot));
+    scratch->n_uris = 0U;
+  }
+}
+
+/**
+   Return the scratch space to use for a call.
+
+   This is the scratch space of the Sratom if no other call is using it,
+   otherwise `local` is initialised and returned.
+*/
+static Scratch*
+claim_scratch(Sratom* const sratom, Scratch* const local)
+{
+  if (try_set_flag(&sratom->scratch_busy)) {
+    const unsigned epoch = load_counter(&sratom->unmap_epoch);
+    if (sratom->scratch.unmap_epoch != epoch) {
+      clear_uris(&sratom->scratch);
+      sratom->scratch.unmap_epoch = epoch;
+    }
+
+    return &sratom->scratch;
+  }
+
+  scratch_init(local);
+  return local;
+}
+
+/// Release the scratch space returned by claim_scratch()
+static void
+release_scratch(Sratom* const sratom, Scratch* const scratch)
+{
+  if (scratch == &sratom->scratch) {
+    arena_reset(&scratch->arena);
+    clear_flag(&sratom->scratch_busy);
+  } else {
+    scratch_cleanup(scratch);
+  }
+}
+
 Sratom*
 sratom_new(LV2_URID_Map* map)
 {
   Sratom* sratom = (Sratom*)calloc(1, sizeof(Sratom));
+  if (sratom && !mutex_init(&sratom->model_lock)) {
+    free(sratom);
+    return NULL;
+  }
+
   if (sratom) {
-    sratom->map            = map;
-    sratom->atom_Event     = map->map(map->handle, LV2_ATOM__Event);
-    sratom->atom_frameTime = map->map(map->handle, LV2_ATOM__frameTime);
-    sratom->atom_beatTime  = map->map(map->handle, LV2_ATOM__beatTime);
-    sratom->midi_MidiEvent = map->map(map->handle, LV2_MIDI__MidiEvent);
-    sratom->object_mode    = SRATOM_OBJECT_MODE_BLANK;
+    sratom->map               = map;
+    sratom->atom_Event        = map->map(map->handle, LV2_ATOM__Event);
+    sratom->atom_frameTime    = map->map(map->handle, LV2_ATOM__frameTime);
+    sratom->atom_beatTime     = map->map(map->handle, LV2_ATOM__beatTime);
+    sratom->midi_MidiEvent    = map->map(map->handle, LV2_MIDI__MidiEvent);
+    sratom->object_mode       = SRATOM_OBJECT_MODE_BLANK;
+    sratom->vector_encoding   = SRATOM_VECTOR_ENCODING_LIST;
+    sratom->sequence_encoding = SRATOM_SEQUENCE_ENCODING_LIST;
     lv2_atom_forge_init(&sratom->forge, map);
+    scratch_init(&sratom->scratch);
+
+    const LV2_Atom_Forge* const forge = &sratom->forge;
+    add_type(sratom, forge->String, KIND_STRING);
+    add_type(sratom, forge->Chunk, KIND_CHUNK);
+    add_type(sratom, forge->Literal, KIND_LITERAL);
+    add_type(sratom, forge->URID, KIND_URID);
+    add_type(sratom, forge->Path, KIND_PATH);
+    add_type(sratom, forge->URI, KIND_URI);
+    add_type(sratom, forge->Int, KIND_INT);
+    add_type(sratom, forge->Long, KIND_LONG);
+    add_type(sratom, forge->Float, KIND_FLOAT);
+    add_type(sratom, forge->Double, KIND_DOUBLE);
+    add_type(sratom, forge->Bool, KIND_BOOL);
+    add_type(sratom, sratom->midi_MidiEvent, KIND_MIDI_EVENT);
+    add_type(sratom, sratom->atom_Event, KIND_EVENT);
+    add_type(sratom, forge->Tuple, KIND_TUPLE);
+    add_type(sratom, forge->Vector, KIND_VECTOR);
+    add_type(sratom, forge->Object, KIND_OBJECT);
+    add_type(sratom, forge->Blank, KIND_OBJECT);
+    add_type(sratom, forge->Resource, KIND_OBJECT);
+    add_type(sratom, forge->Sequence, KIND_SEQUENCE);
   }
   return sratom;
 }
@@ -96,7 +452,10 @@ void
 sratom_free(Sratom* sratom)
 {
   if (sratom) {
+    sratom_unbind_world(sratom);
     serd_node_free(&sratom->base_uri);
+    scratch_cleanup(&sratom->scratch);
+    mutex_destroy(&sratom->model_lock);
     free(sratom);
   }
 }
@@ -136,6 +495,20 @@ sratom_set_object_mode(Sratom* sratom, SratomObjectMode object_mode)
   sratom->object_mode = object_mode;
 }
 
+void
+sratom_set_vector_encoding(Sratom*              sratom,
+                           SratomVectorEncoding vector_encoding)
+{
+  sratom->vector_encoding = vector_encoding;
+}
+
+void
+sratom_set_sequence_encoding(Sratom*                sratom,
+                             SratomSequenceEncoding sequence_encoding)
+{
+  sratom->sequence_encoding = sequence_encoding;
+}
+
 static void
 gensym(SerdNode* out, char c, unsigned num)
 {
@@ -143,7 +516,7 @@ gensym(SerdNode* out, char c, unsigned num)
 }
 
 static SerdStatus
-list_append(Sratom*         sratom,
+list_append(WriteState*     state,
             LV2_URID_Unmap* unmap,
             unsigned*       flags,
             SerdNode*       s,
@@ -155,20 +528,25 @@ list_append(Sratom*         sratom,
 {
   int st = 0;
 
-  // Generate a list node
-  gensym(node, 'l', sratom->next_id);
-  if ((st = sratom->write_statement(
-         sratom->handle, *flags, NULL, s, p, node, NULL, NULL))) {
+  /* Generate a list node.  After the first element, the subject is the
+     previous list node in the same buffer, so the new node is named in a
+     separate buffer until the link to it has been written. */
+  const unsigned id      = fetch_increment(state->next_id);
+  uint8_t        buf[12] = {0};
+  SerdNode       next    = serd_node_from_string(SERD_BLANK, buf);
+  gensym(&next, 'l', id);
+  if ((st = state->write_statement(
+         state->handle, *flags, NULL, s, p, &next, NULL, NULL))) {
     return (SerdStatus)st;
   }
 
   // _:node rdf:first value
+  gensym(node, 'l', id);
   *flags = SERD_LIST_CONT;
   *p     = serd_node_from_string(SERD_URI, NS_RDF "first");
-  st     = sratom_write(sratom, unmap, *flags, node, p, type, size, body);
+  st     = write_atom(state, unmap, *flags, node, p, type, size, body);
 
   // Set subject to node and predicate to rdf:rest for next time
-  gensym(node, 'l', ++sratom->next_id);
   *s = *node;
   *p = serd_node_from_string(SERD_URI, NS_RDF "rest");
   return (SerdStatus)st;
@@ -187,24 +565,24 @@ list_end(SerdStatementSink sink,
 }
 
 static SerdStatus
-start_object(Sratom*         sratom,
+start_object(WriteState*     state,
              uint32_t*       flags,
              const SerdNode* subject,
              const SerdNode* predicate,
              const SerdNode* node,
-             const char*     type)
+             const SerdNode  type)
 {
   SerdStatus st = SERD_SUCCESS;
 
   if (subject && predicate) {
-    st = sratom->write_statement(sratom->handle,
-                                 *flags | SERD_ANON_O_BEGIN,
-                                 NULL,
-                                 subject,
-                                 predicate,
-                                 node,
-                                 NULL,
-                                 NULL);
+    st = state->write_statement(state->handle,
+                                *flags | SERD_ANON_O_BEGIN,
+                                NULL,
+                                subject,
+                                predicate,
+                                node,
+                                NULL,
+                                NULL);
 
     // Start abbreviating object properties
     *flags |= SERD_ANON_CONT;
@@ -213,12 +591,11 @@ start_object(Sratom*         sratom,
     *flags &= ~(uint32_t)SERD_LIST_CONT;
   }
 
-  if (!st && type) {
+  if (!st && type.buf) {
     SerdNode p = serd_node_from_string(SERD_URI, NS_RDF "type");
-    SerdNode o = serd_node_from_string(SERD_URI, USTR(type));
 
-    st = sratom->write_statement(
-      sratom->handle, *flags, NULL, node, &p, &o, NULL, NULL);
+    st = state->write_statement(
+      state->handle, *flags, NULL, node, &p, &type, NULL, NULL);
   }
 
   return st;
@@ -232,7 +609,7 @@ path_is_absolute(const char* path)
 }
 
 static SerdNode
-number_type(const Sratom* sratom, const uint8_t* type)
+number_type(const Sratom* sratom, const char* text, const uint8_t* type)
 {
   if (sratom->pretty_numbers &&
       (!strcmp((const char*)type, (const char*)NS_XSD "int") ||
@@ -240,10 +617,20 @@ number_type(const Sratom* sratom, const uint8_t* type)
     return serd_node_from_string(SERD_URI, NS_XSD "integer");
   }
 
-  if (sratom->pretty_numbers &&
-      (!strcmp((const char*)type, (const char*)NS_XSD "float") ||
+  /* Special values like "INF" have no decimal point, and keep their type.
+     Only doubles can be written bare with an exponent, so floats like
+     "1.0E-7" keep their type to be read back as floats. */
+  const bool is_float = !strcmp((const char*)type, (const char*)NS_XSD "float");
+  if (sratom->pretty_numbers && strchr(text, '.') &&
+      (is_float ||
        !strcmp((const char*)type, (const char*)NS_XSD "double"))) {
-    return serd_node_from_string(SERD_URI, NS_XSD "decimal");
+    if (!strchr(text, 'E')) {
+      return serd_node_from_string(SERD_URI, NS_XSD "decimal");
+    }
+
+    if (!is_float) {
+      return serd_node_from_string(SERD_URI, NS_XSD "double");
+    }
   }
 
   return serd_node_from_string(SERD_URI, type);
@@ -257,51 +644,206 @@ write_node(const WriteContext* const ctx,
 {
   const SerdNode def_s = serd_node_from_string(SERD_BLANK, USTR("atom"));
   const SerdNode def_p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
-  return ctx->sratom->write_statement(ctx->sratom->handle,
-                                      ctx->flags,
-                                      NULL,
-                                      ctx->subject ? ctx->subject : &def_s,
-                                      ctx->predicate ? ctx->predicate : &def_p,
-                                      &object,
-                                      &datatype,
-                                      &language);
+  return ctx->state->write_statement(ctx->state->handle,
+                                     ctx->flags,
+                                     NULL,
+                                     ctx->subject ? ctx->subject : &def_s,
+                                     ctx->predicate ? ctx->predicate : &def_p,
+                                     &object,
+                                     &datatype,
+                                     &language);
 }
 
+/// Write a formatted number literal with the given precise datatype
 static SerdStatus
-write_free_node(const WriteContext* const ctx,
-                SerdNode                  object,
-                const SerdNode            datatype,
-                const SerdNode            language)
+write_number(const WriteContext* const ctx,
+             const char* const         str,
+             const size_t              len,
+             const uint8_t* const      type)
 {
-  const SerdStatus st = write_node(ctx, object, datatype, language);
-  serd_node_free(&object);
-  return st;
+  const SerdNode object = {USTR(str), len, len, 0, SERD_LITERAL};
+
+  return write_node(
+    ctx, object, number_type(ctx->state->sratom, str, type), SERD_NODE_NULL);
 }
 
-static const char*
-unmap_uri(LV2_URID_Unmap* const unmap, const LV2_URID urid)
+/// Return a new base64 literal node allocated in the arena
+static SerdNode
+new_base64_node(Arena* const arena, const void* const body, const size_t size)
+{
+  const size_t len = base64_encoded_length(size, true);
+  char* const  str = (char*)arena_alloc(arena, len + 1U);
+  if (!str) {
+    return SERD_NODE_NULL;
+  }
+
+  const bool newline = base64_encode(str, (const uint8_t*)body, size, true);
+  str[len]           = '\0';
+
+  const SerdNode node = {
+    USTR(str), len, len, newline ? SERD_HAS_NEWLINE : 0U, SERD_LITERAL};
+
+  return node;
+}
+
+static size_t
+uri_slot_index(const LV2_URID urid, const size_t cap)
 {
-  return unmap->unmap(unmap->handle, urid);
+  return (urid * 2654435761U) & (cap - 1U);
+}
+
+static bool
+grow_uris(Scratch* const scratch)
+{
+  const size_t   cap   = scratch->uris_cap ? scratch->uris_cap * 2U : 64U;
+  UriSlot* const slots = (UriSlot*)calloc(cap, sizeof(UriSlot));
+  if (!slots) {
+    return false;
+  }
+
+  for (size_t i = 0U; i < scratch->uris_cap; ++i) {
+    const UriSlot* const slot = &scratch->uris[i];
+    if (slot->urid) {
+      size_t j = uri_slot_index(slot->urid, cap);
+      while (slots[j].urid) {
+        j = (j + 1U) & (cap - 1U);
+      }
+
+      slots[j] = *slot;
+    }
+  }
+
+  free(scratch->uris);
+  scratch->uris     = slots;
+  scratch->uris_cap = cap;
+  return true;
+}
+
+/**
+   Return a URI node for a URID, calling unmap only once per URID.
+
+   The cache persists between writes, since unmapped strings are valid for
+   the lifetime of the map, but is flushed if a different unmap is used.
+   Unknown URIDs aren't cached, and result in a node with a null string.
+*/
+static SerdNode
+unmap_node(Scratch* const              scratch,
+           const LV2_URID_Unmap* const unmap,
+           const LV2_URID              urid)
+{
+  if (unmap->handle != scratch->unmap.handle ||
+      unmap->unmap != scratch->unmap.unmap) {
+    clear_uris(scratch);
+    scratch->unmap = *unmap;
+  }
+
+  if (scratch->uris_cap) {
+    size_t i = uri_slot_index(urid, scratch->uris_cap);
+    for (; scratch->uris[i].urid; i = (i + 1U) & (scratch->uris_cap - 1U)) {
+      if (scratch->uris[i].urid == urid) {
+        return scratch->uris[i].node;
+      }
+    }
+  }
+
+  const char* const uri  = unmap->unmap(unmap->handle, urid);
+  const SerdNode    node = serd_node_from_string(SERD_URI, USTR(uri));
+  if (!urid || !uri ||
+      ((scratch->n_uris + 1U) * 2U > scratch->uris_cap &&
+       !grow_uris(scratch))) {
+    return node;
+  }
+
+  size_t i = uri_slot_index(urid, scratch->uris_cap);
+  while (scratch->uris[i].urid) {
+    i = (i + 1U) & (scratch->uris_cap - 1U);
+  }
+
+  scratch->uris[i].urid = urid;
+  scratch->uris[i].node = node;
+  ++scratch->n_uris;
+  return node;
+}
+
+static SerdStatus
+write_string(WriteContext* const   ctx,
+             LV2_URID_Unmap* const unmap,
+             const uint32_t        type_urid,
+             const uint32_t        size,
+             const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  return write_node(ctx,
+                    serd_node_from_string(SERD_LITERAL, USTR(body)),
+                    SERD_NODE_NULL,
+                    SERD_NODE_NULL);
 }
 
 static SerdStatus
-write_literal(const WriteContext* const          ctx,
-              LV2_URID_Unmap* const              unmap,
-              const LV2_Atom_Literal_Body* const lit)
+write_chunk(WriteContext* const   ctx,
+            LV2_URID_Unmap* const unmap,
+            const uint32_t        type_urid,
+            const uint32_t        size,
+            const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+
+  const SerdNode datatype =
+    serd_node_from_string(SERD_URI, NS_XSD "base64Binary");
+
+  if (ctx->state->writer) {
+    // Encode straight into the output, so memory doesn't grow with the chunk
+    const SerdNode def_s = serd_node_from_string(SERD_BLANK, USTR("atom"));
+    const SerdNode def_p =
+      serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+    return turtle_writer_write_base64(ctx->state->writer,
+                                      ctx->flags,
+                                      NULL,
+                                      ctx->subject ? ctx->subject : &def_s,
+                                      ctx->predicate ? ctx->predicate : &def_p,
+                                      body,
+                                      size,
+                                      &datatype);
+  }
+
+  const SerdNode object =
+    new_base64_node(&ctx->state->scratch->arena, body, size);
+  if (!object.buf) {
+    return SERD_ERR_INTERNAL;
+  }
+
+  return write_node(ctx, object, datatype, SERD_NODE_NULL);
+}
+
+static SerdStatus
+write_literal(WriteContext* const   ctx,
+              LV2_URID_Unmap* const unmap,
+              const uint32_t        type_urid,
+              const uint32_t        size,
+              const void* const     body)
 {
-  const uint8_t* const str = USTR(lit + 1);
+  (void)type_urid;
+  (void)size;
+
+  const LV2_Atom_Literal_Body* const lit = (const LV2_Atom_Literal_Body*)body;
+  const uint8_t* const               str = USTR(lit + 1);
 
   const SerdNode object = serd_node_from_string(SERD_LITERAL, str);
   if (lit->datatype) {
-    return write_node(
-      ctx,
-      object,
-      serd_node_from_string(SERD_URI, USTR(unmap_uri(unmap, lit->datatype))),
-      SERD_NODE_NULL);
+    return write_node(ctx,
+                      object,
+                      unmap_node(ctx->state->scratch, unmap, lit->datatype),
+                      SERD_NODE_NULL);
   }
 
   if (lit->lang) {
-    const char* const lang       = unmap_uri(unmap, lit->lang);
+    const char* const lang =
+      (const char*)unmap_node(ctx->state->scratch, unmap, lit->lang).buf;
     const char* const prefix     = "http://lexvo.org/id/iso639-3/";
     const size_t      prefix_len = strlen(prefix);
     if (!lang || !!strncmp(lang, prefix, prefix_len)) {
@@ -320,125 +862,280 @@ write_literal(const WriteContext* const          ctx,
 }
 
 static SerdStatus
-write_path(const WriteContext* const ctx, const uint8_t* const str)
+write_urid(WriteContext* const   ctx,
+           LV2_URID_Unmap* const unmap,
+           const uint32_t        type_urid,
+           const uint32_t        size,
+           const void* const     body)
 {
-  SerdNode object   = SERD_NODE_NULL;
-  SerdNode datatype = SERD_NODE_NULL;
+  (void)type_urid;
+  (void)size;
+
+  const LV2_URID urid = *(const uint32_t*)body;
+
+  return write_node(ctx,
+                    unmap_node(ctx->state->scratch, unmap, urid),
+                    SERD_NODE_NULL,
+                    SERD_NODE_NULL);
+}
+
+static SerdStatus
+write_path(WriteContext* const   ctx,
+           LV2_URID_Unmap* const unmap,
+           const uint32_t        type_urid,
+           const uint32_t        size,
+           const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  const uint8_t* const str = USTR(body);
+
+  const WriteState* const state    = ctx->state;
+  Arena* const            arena    = &state->scratch->arena;
+  SerdNode                object   = SERD_NODE_NULL;
+  SerdNode                datatype = SERD_NODE_NULL;
   if (path_is_absolute((const char*)str)) {
-    object = serd_node_new_file_uri(str, NULL, NULL, true);
-  } else if (!ctx->sratom->base_uri.buf ||
-             !!strncmp((const char*)ctx->sratom->base_uri.buf, "file://", 7)) {
+    object = uri_from_path(arena, (const char*)str);
+  } else if (!state->base_uri->buf ||
+             !!strncmp((const char*)state->base_uri->buf, "file://", 7)) {
     fprintf(stderr, "warning: Relative path but base is not a file URI.\n");
     fprintf(stderr, "warning: Writing ambiguous atom:Path literal.\n");
-    SerdNode string = serd_node_from_string(SERD_LITERAL, str);
-    object          = serd_node_copy(&string);
-    datatype        = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__Path));
+    object   = serd_node_from_string(SERD_LITERAL, str);
+    datatype = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__Path));
   } else {
-    SerdNode rel = serd_node_new_file_uri(str, NULL, NULL, true);
-    object       = serd_node_new_uri_from_node(&rel, &ctx->sratom->base, NULL);
-    serd_node_free(&rel);
+    const SerdNode rel = uri_from_path(arena, (const char*)str);
+    if (rel.buf) {
+      SerdURI ref = SERD_URI_NULL;
+      SerdURI abs = SERD_URI_NULL;
+      serd_uri_parse(rel.buf, &ref);
+      serd_uri_resolve(&ref, state->base, &abs);
+      object = uri_node(arena, &abs, NULL);
+    }
   }
 
-  return write_free_node(ctx, object, datatype, SERD_NODE_NULL);
+  return object.buf ? write_node(ctx, object, datatype, SERD_NODE_NULL)
+                    : SERD_ERR_INTERNAL;
 }
 
 static SerdStatus
-write_midi_event(const WriteContext* const ctx,
-                 const uint32_t            size,
-                 const void* const         body)
+write_uri(WriteContext* const   ctx,
+          LV2_URID_Unmap* const unmap,
+          const uint32_t        type_urid,
+          const uint32_t        size,
+          const void* const     body)
 {
-  static const char hex_chars[] = "0123456789ABCDEF";
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  return write_node(ctx,
+                    serd_node_from_string(SERD_URI, USTR(body)),
+                    SERD_NODE_NULL,
+                    SERD_NODE_NULL);
+}
+
+static SerdStatus
+write_int(WriteContext* const   ctx,
+          LV2_URID_Unmap* const unmap,
+          const uint32_t        type_urid,
+          const uint32_t        size,
+          const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  char         str[NUMBER_MAX_LENGTH + 1U];
+  const size_t len = number_format_integer(str, *(const int32_t*)body);
+
+  return write_number(ctx, str, len, NS_XSD "int");
+}
+
+static SerdStatus
+write_long(WriteContext* const   ctx,
+           LV2_URID_Unmap* const unmap,
+           const uint32_t        type_urid,
+           const uint32_t        size,
+           const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  char         str[NUMBER_MAX_LENGTH + 1U];
+  const size_t len = number_format_integer(str, *(const int64_t*)body);
+
+  return write_number(ctx, str, len, NS_XSD "long");
+}
+
+static SerdStatus
+write_float(WriteContext* const   ctx,
+            LV2_URID_Unmap* const unmap,
+            const uint32_t        type_urid,
+            const uint32_t        size,
+            const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  char         str[NUMBER_MAX_LENGTH + 1U];
+  const size_t len = number_format_float(str, *(const float*)body);
+
+  return write_number(ctx, str, len, NS_XSD "float");
+}
+
+static SerdStatus
+write_double(WriteContext* const   ctx,
+             LV2_URID_Unmap* const unmap,
+             const uint32_t        type_urid,
+             const uint32_t        size,
+             const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  char         str[NUMBER_MAX_LENGTH + 1U];
+  const size_t len = number_format_double(str, *(const double*)body);
+
+  return write_number(ctx, str, len, NS_XSD "double");
+}
+
+static SerdStatus
+write_bool(WriteContext* const   ctx,
+           LV2_URID_Unmap* const unmap,
+           const uint32_t        type_urid,
+           const uint32_t        size,
+           const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
+  (void)size;
+
+  return write_node(
+    ctx,
+    serd_node_from_string(SERD_LITERAL,
+                          USTR(*(const int32_t*)body ? "true" : "false")),
+    serd_node_from_string(SERD_URI, NS_XSD "boolean"),
+    SERD_NODE_NULL);
+}
+
+static SerdStatus
+write_midi_event(WriteContext* const   ctx,
+                 LV2_URID_Unmap* const unmap,
+                 const uint32_t        type_urid,
+                 const uint32_t        size,
+                 const void* const     body)
+{
+  (void)unmap;
+  (void)type_urid;
 
   const size_t len = (size_t)size * 2U;
-  char* const  str = (char*)calloc(len + 1, 1);
-  for (size_t i = 0U; i < size; ++i) {
-    const uint8_t byte = ((const uint8_t*)body)[i];
-    str[2U * i]        = hex_chars[byte >> 4U];
-    str[(2U * i) + 1U] = hex_chars[byte & 0x0FU];
+  char* const  str = (char*)arena_alloc(&ctx->state->scratch->arena, len + 1U);
+  if (!str) {
+    return SERD_ERR_INTERNAL;
   }
 
-  const SerdStatus st =
-    write_node(ctx,
-               serd_node_from_string(SERD_LITERAL, USTR(str)),
-               serd_node_from_string(SERD_URI, USTR(LV2_MIDI__MidiEvent)),
-               SERD_NODE_NULL);
-  free(str);
-  return st;
+  hex_encode(str, (const uint8_t*)body, size);
+  str[len] = '\0';
+
+  const SerdNode object = {USTR(str), len, len, 0, SERD_LITERAL};
+
+  return write_node(ctx,
+                    object,
+                    serd_node_from_string(SERD_URI, USTR(LV2_MIDI__MidiEvent)),
+                    SERD_NODE_NULL);
 }
 
 static SerdStatus
-write_event(WriteContext* const         ctx,
-            LV2_URID_Unmap* const       unmap,
-            const LV2_Atom_Event* const ev)
+write_event(WriteContext* const   ctx,
+            LV2_URID_Unmap* const unmap,
+            const uint32_t        type_urid,
+            const uint32_t        size,
+            const void* const     body)
 {
-  gensym(&ctx->id, 'e', ctx->sratom->next_id++);
+  (void)type_urid;
+  (void)size;
+
+  const LV2_Atom_Event* const ev = (const LV2_Atom_Event*)body;
+
+  gensym(&ctx->id, 'e', fetch_increment(ctx->state->next_id));
 
-  SerdStatus st = start_object(
-    ctx->sratom, &ctx->flags, ctx->subject, ctx->predicate, &ctx->id, NULL);
+  SerdStatus st = start_object(ctx->state,
+                               &ctx->flags,
+                               ctx->subject,
+                               ctx->predicate,
+                               &ctx->id,
+                               SERD_NODE_NULL);
   if (st) {
     return st;
   }
 
-  SerdNode time     = SERD_NODE_NULL;
+  char     str[NUMBER_MAX_LENGTH + 1U];
+  size_t   len      = 0U;
   SerdNode p        = SERD_NODE_NULL;
   SerdNode datatype = SERD_NODE_NULL;
   SerdNode language = SERD_NODE_NULL;
-  if (ctx->sratom->seq_unit == ctx->sratom->atom_beatTime) {
-    time     = serd_node_new_decimal(ev->time.beats, 16);
+  if (ctx->state->seq_unit == ctx->state->sratom->atom_beatTime) {
+    len      = number_format_double(str, ev->time.beats);
     p        = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__beatTime));
-    datatype = number_type(ctx->sratom, NS_XSD "double");
+    datatype = number_type(ctx->state->sratom, str, NS_XSD "double");
   } else {
-    time     = serd_node_new_integer(ev->time.frames);
+    len      = number_format_integer(str, ev->time.frames);
     p        = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__frameTime));
-    datatype = number_type(ctx->sratom, NS_XSD "long");
-  }
-
-  st = ctx->sratom->write_statement(ctx->sratom->handle,
-                                    SERD_ANON_CONT,
-                                    NULL,
-                                    &ctx->id,
-                                    &p,
-                                    &time,
-                                    &datatype,
-                                    &language);
-  serd_node_free(&time);
+    datatype = number_type(ctx->state->sratom, str, NS_XSD "long");
+  }
+
+  const SerdNode time = {USTR(str), len, len, 0, SERD_LITERAL};
+
+  st = ctx->state->write_statement(ctx->state->handle,
+                                   SERD_ANON_CONT,
+                                   NULL,
+                                   &ctx->id,
+                                   &p,
+                                   &time,
+                                   &datatype,
+                                   &language);
   if (st) {
     return st;
   }
 
   p  = serd_node_from_string(SERD_URI, NS_RDF "value");
-  st = (SerdStatus)sratom_write(ctx->sratom,
-                                unmap,
-                                SERD_ANON_CONT,
-                                &ctx->id,
-                                &p,
-                                ev->body.type,
-                                ev->body.size,
-                                LV2_ATOM_BODY(&ev->body));
+  st = write_atom(ctx->state,
+                  unmap,
+                  SERD_ANON_CONT,
+                  &ctx->id,
+                  &p,
+                  ev->body.type,
+                  ev->body.size,
+                  LV2_ATOM_BODY(&ev->body));
 
   return st ? st
-         : ctx->sratom->end_anon
-           ? ctx->sratom->end_anon(ctx->sratom->handle, &ctx->id)
+         : ctx->state->end_anon
+           ? ctx->state->end_anon(ctx->state->handle, &ctx->id)
            : SERD_SUCCESS;
 }
 
 static SerdStatus
 write_tuple(WriteContext* const   ctx,
             LV2_URID_Unmap* const unmap,
-            const char* const     type_uri,
+            const uint32_t        type_urid,
             const uint32_t        size,
-            const void*           body)
+            const void* const     body)
 {
   SerdStatus st = SERD_SUCCESS;
 
-  gensym(&ctx->id, 't', ctx->sratom->next_id++);
+  gensym(&ctx->id, 't', fetch_increment(ctx->state->next_id));
 
-  if ((st = start_object(ctx->sratom,
+  if ((st = start_object(ctx->state,
                          &ctx->flags,
                          ctx->subject,
                          ctx->predicate,
                          &ctx->id,
-                         type_uri))) {
+                         unmap_node(ctx->state->scratch, unmap, type_urid)))) {
     return st;
   }
 
@@ -447,7 +1144,7 @@ write_tuple(WriteContext* const   ctx,
   for (const LV2_Atom* i = (const LV2_Atom*)body;
        !lv2_atom_tuple_is_end(body, size, i);
        i = lv2_atom_tuple_next(i)) {
-    if ((st = list_append(ctx->sratom,
+    if ((st = list_append(ctx->state,
                           unmap,
                           &ctx->flags,
                           &ctx->id,
@@ -460,83 +1157,205 @@ write_tuple(WriteContext* const   ctx,
     }
   }
 
-  st = list_end(ctx->sratom->write_statement,
-                ctx->sratom->handle,
+  st = list_end(ctx->state->write_statement,
+                ctx->state->handle,
                 ctx->flags,
                 &ctx->id,
                 &p);
 
   return st ? st
-         : ctx->sratom->end_anon
-           ? ctx->sratom->end_anon(ctx->sratom->handle, &ctx->id)
+         : ctx->state->end_anon
+           ? ctx->state->end_anon(ctx->state->handle, &ctx->id)
            : SERD_SUCCESS;
 }
 
-static SerdStatus
-write_vector(WriteContext* const   ctx,
-             LV2_URID_Unmap* const unmap,
-             const char* const     type_uri,
-             const uint32_t        size,
-             const void*           body)
+static uint32_t
+atom_size(const Sratom* sratom, uint32_t type_urid)
 {
-  SerdStatus st = SERD_SUCCESS;
+  if (type_urid == sratom->forge.Int || type_urid == sratom->forge.Bool) {
+    return sizeof(int32_t);
+  }
 
-  const LV2_Atom_Vector_Body* vec = (const LV2_Atom_Vector_Body*)body;
-  if (!vec->child_size) {
-    return SERD_ERR_BAD_ARG;
+  if (type_urid == sratom->forge.Long) {
+    return sizeof(int64_t);
   }
 
-  gensym(&ctx->id, 'v', ctx->sratom->next_id++);
-  if ((st = start_object(ctx->sratom,
+  if (type_urid == sratom->forge.Float) {
+    return sizeof(float);
+  }
+
+  if (type_urid == sratom->forge.Double) {
+    return sizeof(double);
+  }
+
+  if (type_urid == sratom->forge.URID) {
+    return sizeof(uint32_t);
+  }
+
+  return 0;
+}
+
+static bool
+is_scalar_kind(const AtomKind kind)
+{
+  return kind == KIND_INT || kind == KIND_LONG || kind == KIND_FLOAT ||
+         kind == KIND_DOUBLE || kind == KIND_BOOL;
+}
+
+/// Format a number or boolean as text, returning the number of characters
+static size_t
+format_scalar(char* const buf, const AtomKind kind, const void* const value)
+{
+  switch (kind) {
+  case KIND_INT:
+    return number_format_integer(buf, *(const int32_t*)value);
+  case KIND_LONG:
+    return number_format_integer(buf, *(const int64_t*)value);
+  case KIND_FLOAT:
+    return number_format_float(buf, *(const float*)value);
+  case KIND_DOUBLE:
+    return number_format_double(buf, *(const double*)value);
+  case KIND_BOOL:
+    memcpy(buf, *(const int32_t*)value ? "true" : "false", 5U);
+    return *(const int32_t*)value ? 4U : 5U;
+  default:
+    break;
+  }
+
+  return 0U;
+}
+
+static char*
+vector_text(WriteState* const                 state,
+            const LV2_Atom_Vector_Body* const vec,
+            const uint32_t                    size)
+{
+  Arena* const         arena = &state->scratch->arena;
+  const AtomKind       kind  = atom_kind(state->sratom, vec->child_type);
+  const uint32_t       n     = (size - sizeof(*vec)) / vec->child_size;
+  const size_t         len   = (size_t)n * (NUMBER_MAX_LENGTH + 1U);
+  char* const          str   = (char*)arena_alloc(arena, len + 1U);
+  const uint8_t* const elems = (const uint8_t*)(vec + 1);
+  if (!str) {
+    return NULL;
+  }
+
+  char* s = str;
+  for (uint32_t i = 0U; i < n; ++i) {
+    const void* const elem = elems + ((size_t)i * vec->child_size);
+    if (i) {
+      *s++ = ' ';
+    }
+
+    s += format_scalar(s, kind, elem);
+  }
+
+  *s = '\0';
+  return str;
+}
+
+static SerdStatus
+write_vector_value(WriteContext* const               ctx,
+                   const SerdNode* const             predicate,
+                   const LV2_Atom_Vector_Body* const vec,
+                   const uint32_t                    size)
+{
+  WriteState* const state    = ctx->state;
+  Arena* const      arena    = &state->scratch->arena;
+  SerdNode          object   = SERD_NODE_NULL;
+  SerdNode          datatype = SERD_NODE_NULL;
+  if (state->sratom->vector_encoding == SRATOM_VECTOR_ENCODING_BASE64) {
+    object   = new_base64_node(arena, vec + 1, size - sizeof(*vec));
+    datatype = serd_node_from_string(SERD_URI, NS_XSD "base64Binary");
+  } else {
+    object = serd_node_from_string(SERD_LITERAL,
+                                   USTR(vector_text(state, vec, size)));
+  }
+
+  if (!object.buf) {
+    return SERD_ERR_INTERNAL;
+  }
+
+  return state->write_statement(state->handle,
+                                ctx->flags,
+                                NULL,
+                                &ctx->id,
+                                predicate,
+                                &object,
+                                &datatype,
+                                NULL);
+}
+
+static SerdStatus
+write_vector(WriteContext* const   ctx,
+             LV2_URID_Unmap* const unmap,
+             const uint32_t        type_urid,
+             const uint32_t        size,
+             const void* const     body)
+{
+  SerdStatus st = SERD_SUCCESS;
+
+  const LV2_Atom_Vector_Body* vec = (const LV2_Atom_Vector_Body*)body;
+  if (!vec->child_size) {
+    return SERD_ERR_BAD_ARG;
+  }
+
+  gensym(&ctx->id, 'v', fetch_increment(ctx->state->next_id));
+  if ((st = start_object(ctx->state,
                          &ctx->flags,
                          ctx->subject,
                          ctx->predicate,
                          &ctx->id,
-                         type_uri))) {
+                         unmap_node(ctx->state->scratch, unmap, type_urid)))) {
     return st;
   }
 
   SerdNode p = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__childType));
-  SerdNode child_type =
-    serd_node_from_string(SERD_URI, USTR(unmap_uri(unmap, vec->child_type)));
-
-  if ((st = ctx->sratom->write_statement(ctx->sratom->handle,
-                                         ctx->flags,
-                                         NULL,
-                                         &ctx->id,
-                                         &p,
-                                         &child_type,
-                                         NULL,
-                                         NULL))) {
+  SerdNode child_type = unmap_node(ctx->state->scratch, unmap, vec->child_type);
+
+  if ((st = ctx->state->write_statement(ctx->state->handle,
+                                        ctx->flags,
+                                        NULL,
+                                        &ctx->id,
+                                        &p,
+                                        &child_type,
+                                        NULL,
+                                        NULL))) {
     return st;
   }
 
   p = serd_node_from_string(SERD_URI, NS_RDF "value");
-  ctx->flags |= SERD_LIST_O_BEGIN;
-  for (const char* i = (const char*)(vec + 1); i < (const char*)vec + size;
-       i += vec->child_size) {
-    if ((st = list_append(ctx->sratom,
-                          unmap,
-                          &ctx->flags,
-                          &ctx->id,
-                          &p,
-                          &ctx->node,
-                          vec->child_size,
-                          vec->child_type,
-                          i))) {
-      return st;
+  if (ctx->state->sratom->vector_encoding != SRATOM_VECTOR_ENCODING_LIST &&
+      is_scalar_kind(atom_kind(ctx->state->sratom, vec->child_type)) &&
+      vec->child_size == atom_size(ctx->state->sratom, vec->child_type)) {
+    st = write_vector_value(ctx, &p, vec, size);
+  } else {
+    ctx->flags |= SERD_LIST_O_BEGIN;
+    for (const char* i = (const char*)(vec + 1); i < (const char*)vec + size;
+         i += vec->child_size) {
+      if ((st = list_append(ctx->state,
+                            unmap,
+                            &ctx->flags,
+                            &ctx->id,
+                            &p,
+                            &ctx->node,
+                            vec->child_size,
+                            vec->child_type,
+                            i))) {
+        return st;
+      }
     }
-  }
 
-  st = list_end(ctx->sratom->write_statement,
-                ctx->sratom->handle,
-                ctx->flags,
-                &ctx->id,
-                &p);
+    st = list_end(ctx->state->write_statement,
+                  ctx->state->handle,
+                  ctx->flags,
+                  &ctx->id,
+                  &p);
+  }
 
   return st ? st
-         : ctx->sratom->end_anon
-           ? ctx->sratom->end_anon(ctx->sratom->handle, &ctx->id)
+         : ctx->state->end_anon
+           ? ctx->state->end_anon(ctx->state->handle, &ctx->id)
            : SERD_SUCCESS;
 }
 
@@ -545,141 +1364,304 @@ write_atom_object(WriteContext* const   ctx,
                   LV2_URID_Unmap* const unmap,
                   const uint32_t        type_urid,
                   const uint32_t        size,
-                  const void*           body)
+                  const void* const     body)
 {
   int st = SERD_SUCCESS;
 
-  const LV2_Atom_Object_Body* const obj   = (const LV2_Atom_Object_Body*)body;
-  const char* const                 otype = unmap_uri(unmap, obj->otype);
+  const LV2_Atom_Object_Body* const obj = (const LV2_Atom_Object_Body*)body;
 
-  if (lv2_atom_forge_is_blank(&ctx->sratom->forge, type_urid, obj)) {
-    gensym(&ctx->id, 'b', ctx->sratom->next_id++);
+  const SerdNode otype = unmap_node(ctx->state->scratch, unmap, obj->otype);
+
+  if (lv2_atom_forge_is_blank(&ctx->state->sratom->forge, type_urid, obj)) {
+    gensym(&ctx->id, 'b', fetch_increment(ctx->state->next_id));
     st = start_object(
-      ctx->sratom, &ctx->flags, ctx->subject, ctx->predicate, &ctx->id, otype);
+      ctx->state, &ctx->flags, ctx->subject, ctx->predicate, &ctx->id, otype);
   } else {
-    ctx->id = serd_node_from_string(SERD_URI, USTR(unmap_uri(unmap, obj->id)));
+    ctx->id    = unmap_node(ctx->state->scratch, unmap, obj->id);
     ctx->flags = 0U;
-    st = start_object(ctx->sratom, &ctx->flags, NULL, NULL, &ctx->id, otype);
+    st = start_object(ctx->state, &ctx->flags, NULL, NULL, &ctx->id, otype);
   }
 
   for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(obj);
        !st && !lv2_atom_object_is_end(obj, size, p);
        p = lv2_atom_object_next(p)) {
-    const char* const key  = unmap_uri(unmap, p->key);
-    SerdNode          pred = serd_node_from_string(SERD_URI, USTR(key));
-
-    st = sratom_write(ctx->sratom,
-                      unmap,
-                      ctx->flags,
-                      &ctx->id,
-                      &pred,
-                      p->value.type,
-                      p->value.size,
-                      LV2_ATOM_BODY(&p->value));
+    const SerdNode pred = unmap_node(ctx->state->scratch, unmap, p->key);
+
+    st = write_atom(ctx->state,
+                    unmap,
+                    ctx->flags,
+                    &ctx->id,
+                    &pred,
+                    p->value.type,
+                    p->value.size,
+                    LV2_ATOM_BODY(&p->value));
   }
 
   return st ? (SerdStatus)st
-         : (ctx->sratom->end_anon && (ctx->flags & SERD_ANON_CONT))
-           ? ctx->sratom->end_anon(ctx->sratom->handle, &ctx->id)
+         : (ctx->state->end_anon && (ctx->flags & SERD_ANON_CONT))
+           ? ctx->state->end_anon(ctx->state->handle, &ctx->id)
            : SERD_SUCCESS;
 }
 
+/// Return the kind of every event if a sequence can be written compactly
+static AtomKind
+compact_event_kind(const Sratom* const                 sratom,
+                   const LV2_Atom_Sequence_Body* const seq,
+                   const uint32_t                      size)
+{
+  const LV2_Atom_Event* const first = lv2_atom_sequence_begin(seq);
+  if (sratom->sequence_encoding != SRATOM_SEQUENCE_ENCODING_COMPACT ||
+      lv2_atom_sequence_is_end(seq, size, first)) {
+    return KIND_VALUE;
+  }
+
+  const uint32_t type = first->body.type;
+  const AtomKind kind = atom_kind(sratom, type);
+  const uint32_t fixed_size =
+    is_scalar_kind(kind) ? atom_size(sratom, type) : 0U;
+  if (kind != KIND_MIDI_EVENT && !fixed_size) {
+    return KIND_VALUE;
+  }
+
+  for (const LV2_Atom_Event* ev = first;
+       !lv2_atom_sequence_is_end(seq, size, ev);
+       ev = lv2_atom_sequence_next(ev)) {
+    if (ev->body.type != type || !ev->body.size ||
+        (fixed_size && ev->body.size != fixed_size)) {
+      return KIND_VALUE;
+    }
+  }
+
+  return kind;
+}
+
+/// Return the text of a compact sequence, allocated in the arena
+static char*
+sequence_text(WriteState* const                   state,
+              const LV2_Atom_Sequence_Body* const seq,
+              const uint32_t                      size,
+              const AtomKind                      kind)
+{
+  const bool beats = seq->unit == state->sratom->atom_beatTime;
+
+  size_t len = 0U;
+  for (const LV2_Atom_Event* ev = lv2_atom_sequence_begin(seq);
+       !lv2_atom_sequence_is_end(seq, size, ev);
+       ev = lv2_atom_sequence_next(ev)) {
+    len += 2U * (NUMBER_MAX_LENGTH + 1U) + 2U * (size_t)ev->body.size;
+  }
+
+  char* const str = (char*)arena_alloc(&state->scratch->arena, len + 1U);
+  if (!str) {
+    return NULL;
+  }
+
+  char*   s    = str;
+  int64_t last = 0;
+  for (const LV2_Atom_Event* ev = lv2_atom_sequence_begin(seq);
+       !lv2_atom_sequence_is_end(seq, size, ev);
+       ev = lv2_atom_sequence_next(ev)) {
+    if (s != str) {
+      *s++ = ' ';
+    }
+
+    // Frame times are written as the difference from the previous event
+    if (beats) {
+      s += number_format_double(s, ev->time.beats);
+    } else {
+      s += number_format_integer(
+        s, (int64_t)((uint64_t)ev->time.frames - (uint64_t)last));
+      last = ev->time.frames;
+    }
+
+    *s++ = ' ';
+
+    const uint8_t* const body = (const uint8_t*)LV2_ATOM_BODY_CONST(&ev->body);
+    if (kind == KIND_MIDI_EVENT) {
+      hex_encode(s, body, ev->body.size);
+      s += 2U * (size_t)ev->body.size;
+    } else {
+      s += format_scalar(s, kind, body);
+    }
+  }
+
+  *s = '\0';
+  return str;
+}
+
+static SerdStatus
+write_sequence_value(WriteContext* const                 ctx,
+                     LV2_URID_Unmap* const               unmap,
+                     const LV2_Atom_Sequence_Body* const seq,
+                     const uint32_t                      size,
+                     const AtomKind                      kind)
+{
+  WriteState* const state = ctx->state;
+  const char* const text  = sequence_text(state, seq, size, kind);
+  if (!text) {
+    return SERD_ERR_INTERNAL;
+  }
+
+  const LV2_Atom_Event* const first = lv2_atom_sequence_begin(seq);
+  const bool                  beats = seq->unit == state->sratom->atom_beatTime;
+
+  SerdNode p = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__childType));
+  SerdNode o = unmap_node(state->scratch, unmap, first->body.type);
+
+  SerdStatus st = state->write_statement(
+    state->handle, ctx->flags, NULL, &ctx->id, &p, &o, NULL, NULL);
+
+  if (!st) {
+    p  = serd_node_from_string(SERD_URI, USTR(LV2_ATOM__timeUnit));
+    o  = serd_node_from_string(
+      SERD_URI, USTR(beats ? LV2_UNITS__beat : LV2_UNITS__frame));
+    st = state->write_statement(
+      state->handle, ctx->flags, NULL, &ctx->id, &p, &o, NULL, NULL);
+  }
+
+  if (!st) {
+    p  = serd_node_from_string(SERD_URI, NS_RDF "value");
+    o  = serd_node_from_string(SERD_LITERAL, USTR(text));
+    st = state->write_statement(
+      state->handle, ctx->flags, NULL, &ctx->id, &p, &o, NULL, NULL);
+  }
+
+  return st;
+}
+
 static SerdStatus
 write_sequence(WriteContext* const   ctx,
                LV2_URID_Unmap* const unmap,
-               const char* const     type_uri,
+               const uint32_t        type_urid,
                const uint32_t        size,
                const void* const     body)
 {
   SerdStatus st = SERD_SUCCESS;
 
   const LV2_Atom_Sequence_Body* seq = (const LV2_Atom_Sequence_Body*)body;
-  gensym(&ctx->id, 'v', ctx->sratom->next_id++);
-  if ((st = start_object(ctx->sratom,
+  gensym(&ctx->id, 'v', fetch_increment(ctx->state->next_id));
+  if ((st = start_object(ctx->state,
                          &ctx->flags,
                          ctx->subject,
                          ctx->predicate,
                          &ctx->id,
-                         type_uri))) {
+                         unmap_node(ctx->state->scratch, unmap, type_urid)))) {
     return st;
   }
 
-  SerdNode p = serd_node_from_string(SERD_URI, NS_RDF "value");
-  ctx->flags |= SERD_LIST_O_BEGIN;
-  for (const LV2_Atom_Event* ev = lv2_atom_sequence_begin(seq);
-       !lv2_atom_sequence_is_end(seq, size, ev);
-       ev = lv2_atom_sequence_next(ev)) {
-    ctx->sratom->seq_unit = seq->unit;
-    if ((st = list_append(ctx->sratom,
-                          unmap,
-                          &ctx->flags,
-                          &ctx->id,
-                          &p,
-                          &ctx->node,
-                          sizeof(LV2_Atom_Event) + ev->body.size,
-                          ctx->sratom->atom_Event,
-                          ev))) {
-      return st;
+  const AtomKind kind = compact_event_kind(ctx->state->sratom, seq, size);
+  if (kind != KIND_VALUE) {
+    st = write_sequence_value(ctx, unmap, seq, size, kind);
+  } else {
+    SerdNode p = serd_node_from_string(SERD_URI, NS_RDF "value");
+    ctx->flags |= SERD_LIST_O_BEGIN;
+    for (const LV2_Atom_Event* ev = lv2_atom_sequence_begin(seq);
+         !lv2_atom_sequence_is_end(seq, size, ev);
+         ev = lv2_atom_sequence_next(ev)) {
+      ctx->state->seq_unit = seq->unit;
+      if ((st = list_append(ctx->state,
+                            unmap,
+                            &ctx->flags,
+                            &ctx->id,
+                            &p,
+                            &ctx->node,
+                            sizeof(LV2_Atom_Event) + ev->body.size,
+                            ctx->state->sratom->atom_Event,
+                            ev))) {
+        return st;
+      }
     }
-  }
 
-  st = list_end(ctx->sratom->write_statement,
-                ctx->sratom->handle,
-                ctx->flags,
-                &ctx->id,
-                &p);
+    st = list_end(ctx->state->write_statement,
+                  ctx->state->handle,
+                  ctx->flags,
+                  &ctx->id,
+                  &p);
+  }
 
   return st ? st
-         : (ctx->sratom->end_anon && ctx->subject && ctx->predicate)
-           ? ctx->sratom->end_anon(ctx->sratom->handle, &ctx->id)
+         : (ctx->state->end_anon && ctx->subject && ctx->predicate)
+           ? ctx->state->end_anon(ctx->state->handle, &ctx->id)
            : SERD_SUCCESS;
 }
 
 static SerdStatus
-write_value_object(WriteContext* const ctx,
-                   const char* const   type_uri,
-                   const uint32_t      size,
-                   const void* const   body)
+write_value_object(WriteContext* const   ctx,
+                   LV2_URID_Unmap* const unmap,
+                   const uint32_t        type_urid,
+                   const uint32_t        size,
+                   const void* const     body)
 {
   SerdStatus st = SERD_SUCCESS;
 
-  gensym(&ctx->id, 'b', ctx->sratom->next_id++);
-  if ((st = start_object(ctx->sratom,
+  gensym(&ctx->id, 'b', fetch_increment(ctx->state->next_id));
+  if ((st = start_object(ctx->state,
                          &ctx->flags,
                          ctx->subject,
                          ctx->predicate,
                          &ctx->id,
-                         type_uri))) {
+                         unmap_node(ctx->state->scratch, unmap, type_urid)))) {
     return st;
   }
 
   SerdNode p        = serd_node_from_string(SERD_URI, NS_RDF "value");
-  SerdNode o        = serd_node_new_blob(body, size, true);
+  SerdNode o        = new_base64_node(&ctx->state->scratch->arena, body, size);
   SerdNode datatype = serd_node_from_string(SERD_URI, NS_XSD "base64Binary");
+  if (!o.buf) {
+    return SERD_ERR_INTERNAL;
+  }
 
-  st = ctx->sratom->write_statement(
-    ctx->sratom->handle, ctx->flags, NULL, &ctx->id, &p, &o, &datatype, NULL);
+  st = ctx->state->write_statement(
+    ctx->state->handle, ctx->flags, NULL, &ctx->id, &p, &o, &datatype, NULL);
 
-  if (!st && ctx->sratom->end_anon && ctx->subject && ctx->predicate) {
-    st = ctx->sratom->end_anon(ctx->sratom->handle, &ctx->id);
+  if (!st && ctx->state->end_anon && ctx->subject && ctx->predicate) {
+    st = ctx->state->end_anon(ctx->state->handle, &ctx->id);
   }
 
-  serd_node_free(&o);
   return st;
 }
 
-int
-sratom_write(Sratom*         sratom,
-             LV2_URID_Unmap* unmap,
-             uint32_t        flags,
-             const SerdNode* subject,
-             const SerdNode* predicate,
-             uint32_t        type_urid,
-             uint32_t        size,
-             const void*     body)
+/// A function that writes the body of an atom of some kind
+typedef SerdStatus (*WriteFunc)(WriteContext*   ctx,
+                                LV2_URID_Unmap* unmap,
+                                uint32_t        type_urid,
+                                uint32_t        size,
+                                const void*     body);
+
+/// Write functions indexed by AtomKind
+static const WriteFunc write_funcs[KIND_COUNT] = {
+  [KIND_VALUE]      = write_value_object,
+  [KIND_STRING]     = write_string,
+  [KIND_CHUNK]      = write_chunk,
+  [KIND_LITERAL]    = write_literal,
+  [KIND_URID]       = write_urid,
+  [KIND_PATH]       = write_path,
+  [KIND_URI]        = write_uri,
+  [KIND_INT]        = write_int,
+  [KIND_LONG]       = write_long,
+  [KIND_FLOAT]      = write_float,
+  [KIND_DOUBLE]     = write_double,
+  [KIND_BOOL]       = write_bool,
+  [KIND_MIDI_EVENT] = write_midi_event,
+  [KIND_EVENT]      = write_event,
+  [KIND_TUPLE]      = write_tuple,
+  [KIND_VECTOR]     = write_vector,
+  [KIND_OBJECT]     = write_atom_object,
+  [KIND_SEQUENCE]   = write_sequence,
+};
+
+static SerdStatus
+write_atom(WriteState*     state,
+           LV2_URID_Unmap* unmap,
+           uint32_t        flags,
+           const SerdNode* subject,
+           const SerdNode* predicate,
+           uint32_t        type_urid,
+           uint32_t        size,
+           const void*     body)
 {
   WriteContext ctx = {
-    sratom,
+    state,
     subject,
     predicate,
     flags,
@@ -691,7 +1673,6 @@ sratom_write(Sratom*         sratom,
   ctx.id   = serd_node_from_string(SERD_BLANK, ctx.idbuf);
   ctx.node = serd_node_from_string(SERD_BLANK, ctx.nodebuf);
 
-  const char* const type = unmap_uri(unmap, type_urid);
   if (type_urid == 0 && size == 0) {
     return write_node(&ctx,
                       serd_node_from_string(SERD_URI, USTR(NS_RDF "nil")),
@@ -699,107 +1680,148 @@ sratom_write(Sratom*         sratom,
                       SERD_NODE_NULL);
   }
 
-  if (type_urid == sratom->forge.String) {
-    return write_node(&ctx,
-                      serd_node_from_string(SERD_LITERAL, USTR(body)),
-                      SERD_NODE_NULL,
-                      SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Chunk) {
-    return write_free_node(
-      &ctx,
-      serd_node_new_blob(body, size, true),
-      serd_node_from_string(SERD_URI, NS_XSD "base64Binary"),
-      SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Literal) {
-    return write_literal(&ctx, unmap, (const LV2_Atom_Literal_Body*)body);
-  }
-
-  if (type_urid == sratom->forge.URID) {
-    return write_node(
-      &ctx,
-      serd_node_from_string(SERD_URI,
-                            USTR(unmap_uri(unmap, *(const uint32_t*)body))),
-      SERD_NODE_NULL,
-      SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Path) {
-    return write_path(&ctx, USTR(body));
-  }
-
-  if (type_urid == sratom->forge.URI) {
-    return write_node(&ctx,
-                      serd_node_from_string(SERD_URI, USTR(body)),
-                      SERD_NODE_NULL,
-                      SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Int) {
-    return write_free_node(&ctx,
-                           serd_node_new_integer(*(const int32_t*)body),
-                           number_type(sratom, NS_XSD "int"),
-                           SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Long) {
-    return write_free_node(&ctx,
-                           serd_node_new_integer(*(const int64_t*)body),
-                           number_type(sratom, NS_XSD "long"),
-                           SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Float) {
-    return write_free_node(&ctx,
-                           serd_node_new_decimal(*(const float*)body, 8),
-                           number_type(sratom, NS_XSD "float"),
-                           SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Double) {
-    return write_free_node(&ctx,
-                           serd_node_new_decimal(*(const double*)body, 16),
-                           number_type(sratom, NS_XSD "double"),
-                           SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->forge.Bool) {
-    return write_node(
-      &ctx,
-      serd_node_from_string(SERD_LITERAL,
-                            USTR(*(const int32_t*)body ? "true" : "false")),
-      serd_node_from_string(SERD_URI, NS_XSD "boolean"),
-      SERD_NODE_NULL);
-  }
-
-  if (type_urid == sratom->midi_MidiEvent) {
-    return write_midi_event(&ctx, size, body);
-  }
-
-  if (type_urid == sratom->atom_Event) {
-    return write_event(&ctx, unmap, (const LV2_Atom_Event*)body);
-  }
+  const AtomKind kind = atom_kind(state->sratom, type_urid);
+  return write_funcs[kind](&ctx, unmap, type_urid, size, body);
+}
 
-  if (type_urid == sratom->forge.Tuple) {
-    return write_tuple(&ctx, unmap, type, size, body);
-  }
+int
+sratom_write(Sratom*         sratom,
+             LV2_URID_Unmap* unmap,
+             uint32_t        flags,
+             const SerdNode* subject,
+             const SerdNode* predicate,
+             uint32_t        type_urid,
+             uint32_t        size,
+             const void*     body)
+{
+  Scratch    local;
+  WriteState state = {sratom,
+                      claim_scratch(sratom, &local),
+                      sratom->write_statement,
+                      sratom->end_anon,
+                      sratom->handle,
+                      &sratom->base_uri,
+                      &sratom->base,
+                      &sratom->next_id,
+                      0U,
+                      NULL};
+
+  const SerdStatus st = write_atom(
+    &state, unmap, flags, subject, predicate, type_urid, size, body);
+
+  release_scratch(sratom, state.scratch);
+  return st;
+}
 
-  if (type_urid == sratom->forge.Vector) {
-    return write_vector(&ctx, unmap, type, size, body);
-  }
+/// Write an atom to a Turtle writer using the given scratch space
+static SerdStatus
+write_document(Sratom* const         sratom,
+               Scratch* const        scratch,
+               TurtleWriter* const   writer,
+               LV2_URID_Unmap* const unmap,
+               const char* const     base_uri,
+               const SerdNode* const subject,
+               const SerdNode* const predicate,
+               const uint32_t        type,
+               const uint32_t        size,
+               const void* const     body)
+{
+  SerdURI  base      = SERD_URI_NULL;
+  SerdNode base_node = serd_node_new_uri_from_string(
+    USTR(base_uri), sratom->base_uri.buf ? &sratom->base : NULL, &base);
+
+  turtle_writer_set_base_uri(writer, &base_node);
+
+  // Blank node labels are numbered per document, so output is deterministic
+  long next_id = 0L;
+
+  WriteState state = {sratom,
+                      scratch,
+                      turtle_writer_write_statement,
+                      turtle_writer_end_anon,
+                      writer,
+                      &base_node,
+                      &base,
+                      &next_id,
+                      0U,
+                      writer};
+
+  const SerdStatus st = write_atom(
+    &state, unmap, SERD_EMPTY_S, subject, predicate, type, size, body);
+
+  turtle_writer_set_base_uri(writer, NULL);
+  serd_node_free(&base_node);
+  return st;
+}
 
-  if (lv2_atom_forge_is_object_type(&sratom->forge, type_urid)) {
-    return write_atom_object(&ctx, unmap, type_urid, size, body);
-  }
+/// Write an atom to a string using the given scratch space
+static char*
+write_text(Sratom* const         sratom,
+           Scratch* const        scratch,
+           LV2_URID_Unmap* const unmap,
+           const char* const     base_uri,
+           const SerdNode* const subject,
+           const SerdNode* const predicate,
+           const uint32_t        type,
+           const uint32_t        size,
+           const void* const     body,
+           const SerdSyntax      syntax,
+           const SerdStyle       style)
+{
+  TurtleWriter writer;
+  turtle_writer_init(&writer, sratom->env);
+  turtle_writer_set_syntax(&writer, syntax, style);
+
+  const SerdStatus st = write_document(sratom,
+                                       scratch,
+                                       &writer,
+                                       unmap,
+                                       base_uri,
+                                       subject,
+                                       predicate,
+                                       type,
+                                       size,
+                                       body);
+
+  char* const str = st ? NULL : turtle_writer_finish(&writer);
+
+  turtle_writer_cleanup(&writer);
+  return str;
+}
 
-  if (type_urid == sratom->forge.Sequence) {
-    return write_sequence(&ctx, unmap, type, size, body);
+char*
+sratom_to_string(Sratom*         sratom,
+                 LV2_URID_Unmap* unmap,
+                 const char*     base_uri,
+                 const SerdNode* subject,
+                 const SerdNode* predicate,
+                 uint32_t        type,
+                 uint32_t        size,
+                 const void*     body,
+                 SerdSyntax      syntax,
+                 SerdStyle       style)
+{
+  if (syntax != SERD_TURTLE && syntax != SERD_NTRIPLES &&
+      syntax != SERD_NQUADS && syntax != SERD_TRIG) {
+    return NULL;
   }
 
-  return write_value_object(&ctx, type, size, body);
+  Scratch        local;
+  Scratch* const scratch = claim_scratch(sratom, &local);
+  char* const    str     = write_text(sratom,
+                                     scratch,
+                                     unmap,
+                                     base_uri,
+                                     subject,
+                                     predicate,
+                                     type,
+                                     size,
+                                     body,
+                                     syntax,
+                                     style);
+
+  release_scratch(sratom, scratch);
+  return str;
 }
 
 char*
@@ -812,321 +1834,1143 @@ sratom_to_turtle(Sratom*         sratom,
                  uint32_t        size,
                  const void*     body)
 {
-  SerdURI  buri = SERD_URI_NULL;
-  SerdNode base =
-    serd_node_new_uri_from_string(USTR(base_uri), &sratom->base, &buri);
-  SerdEnv*    env = sratom->env ? sratom->env : serd_env_new(NULL);
-  SerdChunk   str = {NULL, 0};
-  SerdWriter* writer =
-    serd_writer_new(SERD_TURTLE, style, env, &buri, serd_chunk_sink, &str);
+  return sratom_to_string(sratom,
+                          unmap,
+                          base_uri,
+                          subject,
+                          predicate,
+                          type,
+                          size,
+                          body,
+                          SERD_TURTLE,
+                          turtle_style);
+}
 
-  serd_env_set_base_uri(env, &base);
-  sratom_set_sink(sratom,
-                  base_uri,
-                  (SerdStatementSink)serd_writer_write_statement,
-                  (SerdEndSink)serd_writer_end_anon,
-                  writer);
+int
+sratom_write_to_stream(Sratom*         sratom,
+                       LV2_URID_Unmap* unmap,
+                       const char*     base_uri,
+                       const SerdNode* subject,
+                       const SerdNode* predicate,
+                       uint32_t        type,
+                       uint32_t        size,
+                       const void*     body,
+                       SerdSink        sink,
+                       void*           stream)
+{
+  TurtleWriter writer;
+  turtle_writer_init(&writer, sratom->env);
+  if (!turtle_writer_set_sink(&writer, sink, stream)) {
+    turtle_writer_cleanup(&writer);
+    return 1;
+  }
 
-  const int st = sratom_write(
-    sratom, unmap, SERD_EMPTY_S, subject, predicate, type, size, body);
+  Scratch        local;
+  Scratch* const scratch = claim_scratch(sratom, &local);
 
-  serd_writer_finish(writer);
+  const SerdStatus st = write_document(sratom,
+                                       scratch,
+                                       &writer,
+                                       unmap,
+                                       base_uri,
+                                       subject,
+                                       predicate,
+                                       type,
+                                       size,
+                                       body);
 
-  serd_writer_free(writer);
-  if (!sratom->env) {
-    serd_env_free(env);
-  }
+  release_scratch(sratom, scratch);
 
-  serd_node_free(&base);
-  if (st) {
-    free((void*)str.buf);
-    return NULL;
-  }
+  const bool success = !st && turtle_writer_finish_stream(&writer);
 
-  return (char*)serd_chunk_sink_finish(&str);
+  turtle_writer_cleanup(&writer);
+  return !success;
 }
 
-static void
-read_list_value(Sratom*         sratom,
-                LV2_Atom_Forge* forge,
-                SordWorld*      world,
-                SordModel*      model,
-                const SordNode* node,
-                ReadMode        mode)
+int
+sratom_write_to_file(Sratom*         sratom,
+                     LV2_URID_Unmap* unmap,
+                     const char*     base_uri,
+                     const SerdNode* subject,
+                     const SerdNode* predicate,
+                     uint32_t        type,
+                     uint32_t        size,
+                     const void*     body,
+                     FILE*           file)
 {
-  SordNode* fst = sord_get(model, node, sratom->nodes.rdf_first, NULL, NULL);
-  SordNode* rst = sord_get(model, node, sratom->nodes.rdf_rest, NULL, NULL);
-  if (fst && rst) {
-    read_node(sratom, forge, world, model, fst, mode);
-    read_list_value(sratom, forge, world, model, rst, mode);
-  }
-
-  sord_node_free(world, rst);
-  sord_node_free(world, fst);
+  return sratom_write_to_stream(sratom,
+                                unmap,
+                                base_uri,
+                                subject,
+                                predicate,
+                                type,
+                                size,
+                                body,
+                                serd_file_sink,
+                                file) ||
+         fflush(file);
 }
 
+/// A thread that writes every `stride`th entry of a batch
+typedef struct {
+  Sratom*           sratom;
+  LV2_URID_Unmap*   unmap;
+  const char*       base_uri;
+  SratomBatchEntry* entries;
+  size_t            n_entries;
+  size_t            first;  ///< Index of the first entry to write
+  size_t            stride; ///< Number of entries between written entries
+  bool              failed; ///< True if writing any entry failed
+} BatchWorker;
+
 static void
-read_resource(Sratom*         sratom,
-              LV2_Atom_Forge* forge,
-              SordWorld*      world,
-              SordModel*      model,
-              const SordNode* node,
-              LV2_URID        otype)
+run_batch_worker(void* const arg)
 {
-  LV2_URID_Map* map = sratom->map;
-  SordQuad      q   = {node, NULL, NULL, NULL};
-  SordIter*     i   = sord_find(model, q);
-  SordQuad      match;
-  for (; !sord_iter_end(i); sord_iter_next(i)) {
-    sord_iter_get(i, match);
-    const SordNode* p      = match[SORD_PREDICATE];
-    const SordNode* o      = match[SORD_OBJECT];
-    const char*     p_uri  = (const char*)sord_node_get_string(p);
-    uint32_t        p_urid = map->map(map->handle, p_uri);
-    if (!(sord_node_equals(p, sratom->nodes.rdf_type) &&
-          sord_node_get_type(o) == SORD_URI &&
-          map->map(map->handle, (const char*)sord_node_get_string(o)) ==
-            otype)) {
-      lv2_atom_forge_key(forge, p_urid);
-      read_node(sratom, forge, world, model, o, MODE_BODY);
-    }
+  BatchWorker* const worker = (BatchWorker*)arg;
+
+  Scratch scratch;
+  scratch_init(&scratch);
+
+  for (size_t i = worker->first; i < worker->n_entries; i += worker->stride) {
+    SratomBatchEntry* const entry = &worker->entries[i];
+    const LV2_Atom* const   atom  = entry->atom;
+
+    entry->turtle = write_text(worker->sratom,
+                               &scratch,
+                               worker->unmap,
+                               worker->base_uri,
+                               entry->subject,
+                               entry->predicate,
+                               atom->type,
+                               atom->size,
+                               LV2_ATOM_BODY_CONST(atom),
+                               SERD_TURTLE,
+                               turtle_style);
+
+    worker->failed = worker->failed || !entry->turtle;
+    arena_reset(&scratch.arena);
   }
-  sord_iter_free(i);
+
+  scratch_cleanup(&scratch);
 }
 
-static uint32_t
-atom_size(const Sratom* sratom, uint32_t type_urid)
+/// Concatenate the strings of entries into a document, freeing them
+static char*
+join_batch(SratomBatchEntry* const entries, const size_t n_entries)
 {
-  if (type_urid == sratom->forge.Int || type_urid == sratom->forge.Bool) {
-    return sizeof(int32_t);
+  size_t len = 0U;
+  for (size_t i = 0U; i < n_entries; ++i) {
+    len += strlen(entries[i].turtle) + 1U;
   }
 
-  if (type_urid == sratom->forge.Long) {
-    return sizeof(int64_t);
+  char* const document = (char*)malloc(len + 1U);
+  if (document) {
+    char* d = document;
+    for (size_t i = 0U; i < n_entries; ++i) {
+      const size_t entry_len = strlen(entries[i].turtle);
+      if (i) {
+        *d++ = '\n';
+      }
+
+      memcpy(d, entries[i].turtle, entry_len);
+      d += entry_len;
+    }
+
+    *d = '\0';
   }
 
-  if (type_urid == sratom->forge.Float) {
-    return sizeof(float);
+  return document;
+}
+
+int
+sratom_write_batch(Sratom*           sratom,
+                   LV2_URID_Unmap*   unmap,
+                   const char*       base_uri,
+                   unsigned          n_threads,
+                   size_t            n_entries,
+                   SratomBatchEntry* entries,
+                   char**            document)
+{
+  // Use at least one thread, but no more than one per entry
+  size_t n_workers = n_threads ? n_threads : 1U;
+  if (n_workers > n_entries) {
+    n_workers = n_entries ? n_entries : 1U;
   }
 
-  if (type_urid == sratom->forge.Double) {
-    return sizeof(double);
+  BatchWorker* const workers =
+    (BatchWorker*)calloc(n_workers, sizeof(BatchWorker));
+  if (!workers) {
+    if (document) {
+      *document = NULL;
+    }
+    return 1;
   }
 
-  if (type_urid == sratom->forge.URID) {
-    return sizeof(uint32_t);
+  for (size_t i = 0U; i < n_workers; ++i) {
+    BatchWorker* const worker = &workers[i];
+    worker->sratom            = sratom;
+    worker->unmap             = unmap;
+    worker->base_uri          = base_uri;
+    worker->entries           = entries;
+    worker->n_entries         = n_entries;
+    worker->first             = i;
+    worker->stride            = n_workers;
   }
 
-  return 0;
+  thread_run_parallel(
+    run_batch_worker, workers, sizeof(BatchWorker), n_workers);
+
+  bool failed = false;
+  for (size_t i = 0U; i < n_workers; ++i) {
+    failed = failed || workers[i].failed;
+  }
+
+  free(workers);
+
+  if (document) {
+    *document = failed ? NULL : join_batch(entries, n_entries);
+    failed    = failed || !*document;
+    for (size_t i = 0U; i < n_entries; ++i) {
+      free(entries[i].turtle);
+      entries[i].turtle = NULL;
+    }
+  }
+
+  return failed;
+}
+
+static size_t
+urid_slot_index(const SordNode* const node, const size_t cap)
+{
+  return ((size_t)((uintptr_t)node >> 3U) * 2654435761U) & (cap - 1U);
 }
 
-static inline uint8_t
-hex_digit_value(const uint8_t c)
+static bool
+grow_urids(Scratch* const scratch)
 {
-  return (uint8_t)((c > '9') ? ((c & ~0x20) - 'A' + 10) : (c - '0'));
+  const size_t    cap   = scratch->urids_cap ? scratch->urids_cap * 2U : 64U;
+  UridSlot* const slots = (UridSlot*)calloc(cap, sizeof(UridSlot));
+  if (!slots) {
+    return false;
+  }
+
+  for (size_t i = 0U; i < scratch->urids_cap; ++i) {
+    const UridSlot* const slot = &scratch->urids[i];
+    if (slot->node) {
+      size_t j = urid_slot_index(slot->node, cap);
+      while (slots[j].node) {
+        j = (j + 1U) & (cap - 1U);
+      }
+
+      slots[j] = *slot;
+    }
+  }
+
+  free(scratch->urids);
+  scratch->urids     = slots;
+  scratch->urids_cap = cap;
+  return true;
 }
 
+/// Forget all cached URIDs, since nodes may not outlive a document
 static void
-read_literal(Sratom* sratom, LV2_Atom_Forge* forge, const SordNode* node)
+clear_urids(Scratch* const scratch)
 {
-  assert(sord_node_get_type(node) == SORD_LITERAL);
+  if (scratch->n_urids) {
+    memset(scratch->urids, 0, scratch->urids_cap * sizeof(UridSlot));
+    scratch->n_urids = 0U;
+  }
 
-  size_t          len = 0;
-  const char*     str = (const char*)sord_node_get_string_counted(node, &len);
-  const SordNode* datatype = sord_node_get_datatype(node);
-  const char*     language = sord_node_get_language(node);
-  if (datatype) {
-    const char* type_uri = (const char*)sord_node_get_string(datatype);
-    if (!strcmp(type_uri, (const char*)NS_XSD "int") ||
-        !strcmp(type_uri, (const char*)NS_XSD "integer")) {
-      lv2_atom_forge_int(forge, strtol(str, NULL, 10));
-    } else if (!strcmp(type_uri, (const char*)NS_XSD "long")) {
-      lv2_atom_forge_long(forge, strtol(str, NULL, 10));
-    } else if (!strcmp(type_uri, (const char*)NS_XSD "float") ||
-               !strcmp(type_uri, (const char*)NS_XSD "decimal")) {
-      lv2_atom_forge_float(forge, (float)serd_strtod(str, NULL));
-    } else if (!strcmp(type_uri, (const char*)NS_XSD "double")) {
-      lv2_atom_forge_double(forge, serd_strtod(str, NULL));
-    } else if (!strcmp(type_uri, (const char*)NS_XSD "boolean")) {
-      lv2_atom_forge_bool(forge, !strcmp(str, "true"));
-    } else if (!strcmp(type_uri, (const char*)NS_XSD "base64Binary")) {
-      size_t size = 0;
-      void*  body = serd_base64_decode(USTR(str), len, &size);
-      lv2_atom_forge_atom(forge, size, forge->Chunk);
-      lv2_atom_forge_write(forge, body, size);
-      free(body);
-    } else if (!strcmp(type_uri, LV2_ATOM__Path)) {
-      lv2_atom_forge_path(forge, str, len);
-    } else if (!strcmp(type_uri, LV2_MIDI__MidiEvent)) {
-      lv2_atom_forge_atom(forge, len / 2, sratom->midi_MidiEvent);
-      for (const char* s = str; s < str + len; s += 2) {
-        const uint8_t hi = hex_digit_value(s[0]);
-        const uint8_t lo = hex_digit_value(s[1]);
-        const uint8_t c  = (uint8_t)(((unsigned)hi << 4U) | lo);
-        lv2_atom_forge_raw(forge, &c, 1);
+  scratch->n_langs = 0U;
+}
+
+/// Map a URI node to a URID, calling the URID map only once per node
+static LV2_URID
+map_node(ReadState* const state, const SordNode* const node)
+{
+  Scratch* const scratch = state->scratch;
+  if (scratch->urids_cap) {
+    size_t i = urid_slot_index(node, scratch->urids_cap);
+    for (; scratch->urids[i].node; i = (i + 1U) & (scratch->urids_cap - 1U)) {
+      if (scratch->urids[i].node == node) {
+        ++scratch->urid_stats.hits;
+        return scratch->urids[i].urid;
+      }
+    }
+  }
+
+  LV2_URID_Map* const map  = state->sratom->map;
+  const LV2_URID      urid = map->map(
+    map->handle, (const char*)sord_node_get_string(node));
+
+  ++scratch->urid_stats.misses;
+  if ((scratch->n_urids + 1U) * 2U > scratch->urids_cap &&
+      !grow_urids(scratch)) {
+    return urid;
+  }
+
+  size_t i = urid_slot_index(node, scratch->urids_cap);
+  while (scratch->urids[i].node) {
+    i = (i + 1U) & (scratch->urids_cap - 1U);
+  }
+
+  scratch->urids[i].node = node;
+  scratch->urids[i].urid = urid;
+  ++scratch->n_urids;
+  return urid;
+}
+
+/// Return the URI for a language tag allocated in an arena
+static const char*
+language_uri(Arena* const arena, const char* const language)
+{
+  static const char* const prefix       = "http://lexvo.org/id/iso639-3/";
+  const size_t             prefix_len   = strlen(prefix);
+  const size_t             language_len = strlen(language);
+  char* const              uri =
+    (char*)arena_alloc(arena, prefix_len + language_len + 1U);
+
+  if (uri) {
+    memcpy(uri, prefix, prefix_len);
+    memcpy(uri + prefix_len, language, language_len + 1U);
+  }
+
+  return uri;
+}
+
+/**
+   Map the language of a literal node, calling the URID map once per language.
+
+   Documents rarely have more than a few languages, so they are simply
+   searched in order, and counted in the same statistics as URI nodes.
+*/
+static LV2_URID
+map_language(ReadState* const state, const char* const language)
+{
+  Scratch* const scratch = state->scratch;
+  for (size_t i = 0U; i < scratch->n_langs; ++i) {
+    if (!strcmp(scratch->langs[i].tag, language)) {
+      ++scratch->urid_stats.hits;
+      return scratch->langs[i].urid;
+    }
+  }
+
+  LV2_URID_Map* const map  = state->sratom->map;
+  const char* const   uri  = language_uri(&scratch->arena, language);
+  const LV2_URID      urid = uri ? map->map(map->handle, uri) : 0U;
+
+  ++scratch->urid_stats.misses;
+  if (scratch->n_langs == scratch->langs_cap) {
+    const size_t    cap   = scratch->langs_cap ? scratch->langs_cap * 2U : 4U;
+    LangSlot* const slots =
+      (LangSlot*)realloc(scratch->langs, cap * sizeof(LangSlot));
+    if (!slots) {
+      return urid;
+    }
+
+    scratch->langs     = slots;
+    scratch->langs_cap = cap;
+  }
+
+  const size_t len = strlen(language);
+  char* const  tag = (char*)arena_alloc(&scratch->arena, len + 1U);
+  if (tag) {
+    memcpy(tag, language, len + 1U);
+    scratch->langs[scratch->n_langs].tag  = tag;
+    scratch->langs[scratch->n_langs].urid = urid;
+    ++scratch->n_langs;
+  }
+
+  return urid;
+}
+
+/// Lock the model lock of a read, if there is one
+static void
+lock_model(const ReadState* const state)
+{
+  if (state->model_lock) {
+    mutex_lock(state->model_lock);
+  }
+}
+
+/// Unlock the model lock locked with lock_model()
+static void
+unlock_model(const ReadState* const state)
+{
+  if (state->model_lock) {
+    mutex_unlock(state->model_lock);
+  }
+}
+
+/// Find statements in a model, holding the model lock if there is one
+static SordIter*
+find_quads(ReadState* const state, SordModel* const model, const SordQuad pat)
+{
+  lock_model(state);
+  SordIter* const iter = sord_find(model, pat);
+  unlock_model(state);
+  return iter;
+}
+
+/// Free an iterator from find_quads()
+static void
+free_iter(ReadState* const state, SordIter* const iter)
+{
+  lock_model(state);
+  sord_iter_free(iter);
+  unlock_model(state);
+}
+
+/// Return an object of a subject and predicate, which the model owns
+static const SordNode*
+get_object(ReadState* const      state,
+           SordModel* const      model,
+           const SordNode* const subject,
+           const SordNode* const predicate)
+{
+  if (!subject) {
+    return NULL;
+  }
+
+  const SordQuad        pat = {subject, predicate, NULL, NULL};
+  SordIter* const       i   = find_quads(state, model, pat);
+  const SordNode* const node =
+    sord_iter_end(i) ? NULL : sord_iter_get_node(i, SORD_OBJECT);
+
+  free_iter(state, i);
+  return node;
+}
+
+static SerdStatus
+read_list_value(ReadState*      state,
+                LV2_Atom_Forge* forge,
+                SordModel*      model,
+                const SordNode* node,
+                ReadMode        mode)
+{
+  /* Walk the list iteratively, finding both the first and rest of each cell
+     with a single search.  Every cell has at least two statements, so the
+     number of statements bounds the length, even if the list has a cycle. */
+
+  SerdStatus      st   = SERD_SUCCESS;
+  const SordNode* cell = node;
+  for (size_t n = sord_num_quads(model) / 2U; !st && cell && n; --n) {
+    const SordQuad  pat = {cell, NULL, NULL, NULL};
+    SordIter* const i   = find_quads(state, model, pat);
+    const SordNode* fst = NULL;
+    const SordNode* rst = NULL;
+    SordQuad        match;
+    for (; !sord_iter_end(i) && !(fst && rst); sord_iter_next(i)) {
+      sord_iter_get(i, match);
+      if (!fst && sord_node_equals(match[SORD_PREDICATE],
+                                   state->nodes->rdf_first)) {
+        fst = match[SORD_OBJECT];
+      } else if (!rst && sord_node_equals(match[SORD_PREDICATE],
+                                          state->nodes->rdf_rest)) {
+        rst = match[SORD_OBJECT];
       }
-      lv2_atom_forge_pad(forge, len / 2);
+    }
+
+    free_iter(state, i);
+
+    if (fst && rst) {
+      st = read_node(state, forge, model, fst, mode);
+    }
+
+    cell = (fst && rst) ? rst : NULL;
+  }
+
+  return st;
+}
+
+static SerdStatus
+read_resource(ReadState*      state,
+              LV2_Atom_Forge* forge,
+              SordModel*      model,
+              const SordNode* node,
+              LV2_URID        otype)
+{
+  SerdStatus st = SERD_SUCCESS;
+  SordQuad   q  = {node, NULL, NULL, NULL};
+  SordIter*  i  = find_quads(state, model, q);
+  SordQuad   match;
+  for (; !st && !sord_iter_end(i); sord_iter_next(i)) {
+    sord_iter_get(i, match);
+    const SordNode* p = match[SORD_PREDICATE];
+    const SordNode* o = match[SORD_OBJECT];
+    if (!(sord_node_equals(p, state->nodes->rdf_type) &&
+          sord_node_get_type(o) == SORD_URI && map_node(state, o) == otype)) {
+      st = lv2_atom_forge_key(forge, map_node(state, p))
+             ? read_node(state, forge, model, o, MODE_BODY)
+             : SERD_ERR_BAD_WRITE;
+    }
+  }
+  free_iter(state, i);
+  return st;
+}
+
+/// Return the status of reading an atom that was written to `ref`
+static SerdStatus
+forge_status(const LV2_Atom_Forge_Ref ref)
+{
+  return ref ? SERD_SUCCESS : SERD_ERR_BAD_WRITE;
+}
+
+/**
+   Read a URI that isn't written as a URID, rdf:nil or a file URI.
+
+   @return SERD_FAILURE if the URI should be a URID, otherwise the status of
+   writing it to the forge.
+*/
+static SerdStatus
+read_unmapped_uri(ReadState* const      state,
+                  LV2_Atom_Forge* const forge,
+                  const char* const     str)
+{
+  LV2_Atom_Forge_Ref ref = 0;
+  if (!strcmp(str, (const char*)NS_RDF "nil")) {
+    ref = lv2_atom_forge_atom(forge, 0, 0);
+  } else if (!strncmp(str, "file://", 7)) {
+    SerdURI uri;
+    serd_uri_parse(USTR(str), &uri);
+
+    Arena* const      arena = &state->scratch->arena;
+    const SerdNode    rel   = uri_node(arena, &uri, state->base);
+    const char* const path =
+      rel.buf ? uri_to_path(arena, (const char*)rel.buf) : NULL;
+
+    if (path) {
+      ref = lv2_atom_forge_path(forge, path, strlen(path));
     } else {
-      lv2_atom_forge_literal(
-        forge, str, len, sratom->map->map(sratom->map->handle, type_uri), 0);
-    }
-  } else if (language) {
-    static const char* const prefix       = "http://lexvo.org/id/iso639-3/";
-    const size_t             prefix_len   = strlen(prefix);
-    const size_t             language_len = strlen(language);
-    const size_t             lang_uri_len = prefix_len + language_len;
-    char*                    lang_uri     = (char*)calloc(lang_uri_len + 1, 1);
-
-    memcpy(lang_uri, prefix, prefix_len + 1);
-    memcpy(lang_uri + prefix_len, language, language_len + 1);
-
-    lv2_atom_forge_literal(
-      forge, str, len, 0, sratom->map->map(sratom->map->handle, lang_uri));
-    free(lang_uri);
+      // FIXME: Report errors (required API change)
+      ref = lv2_atom_forge_atom(forge, 0, 0);
+    }
   } else {
-    lv2_atom_forge_string(forge, str, len);
+    return SERD_FAILURE;
   }
+
+  return forge_status(ref);
 }
 
-static void
-read_object(Sratom*         sratom,
+/**
+   Decode base64 text directly into space reserved in the forge.
+
+   The space is reserved by writing the start of the text itself, which is
+   always longer than the data it encodes, so no temporary buffer is needed.
+*/
+static LV2_Atom_Forge_Ref
+forge_base64(LV2_Atom_Forge* const forge,
+             const size_t          size,
+             const char* const     str,
+             const size_t          len)
+{
+  const LV2_Atom_Forge_Ref ref = lv2_atom_forge_raw(forge, str, (uint32_t)size);
+  if (ref) {
+    base64_decode((uint8_t*)lv2_atom_forge_deref(forge, ref), size, str, len);
+  }
+
+  return ref;
+}
+
+static SerdStatus
+read_base64(LV2_Atom_Forge* const forge,
+            const LV2_URID        type,
+            const char* const     str,
+            const size_t          len)
+{
+  const size_t size = base64_decoded_size(str, len);
+  if (size > UINT32_MAX - sizeof(LV2_Atom)) {
+    fprintf(stderr, "Base64 literal is too large\n");
+    return forge_status(lv2_atom_forge_atom(forge, 0, 0));
+  }
+
+  if (!lv2_atom_forge_atom(forge, (uint32_t)size, type) ||
+      !forge_base64(forge, size, str, len)) {
+    return SERD_ERR_BAD_WRITE;
+  }
+
+  lv2_atom_forge_pad(forge, (uint32_t)size);
+  return SERD_SUCCESS;
+}
+
+/// Read a hex MIDI event literal, returning SERD_ERR_BAD_SYNTAX if invalid
+static SerdStatus
+read_midi_event(ReadState* const      state,
+                LV2_Atom_Forge* const forge,
+                const char* const     str,
+                const size_t          len)
+{
+  if (len % 2U || len / 2U > UINT32_MAX) {
+    return SERD_ERR_BAD_SYNTAX;
+  }
+
+  const uint32_t size = (uint32_t)(len / 2U);
+  uint8_t* const buf  = (uint8_t*)arena_alloc(&state->scratch->arena, size);
+  if (!buf || !hex_decode(buf, str, len)) {
+    return SERD_ERR_BAD_SYNTAX;
+  }
+
+  return forge_status(
+    lv2_atom_forge_atom(forge, size, state->sratom->midi_MidiEvent) &&
+    lv2_atom_forge_write(forge, buf, size));
+}
+
+/// Return the kind of atom to read a literal with a datatype URI as
+static AtomKind
+literal_kind(const char* const type_uri, const size_t type_len)
+{
+  for (unsigned i = 0U; i < N_DATATYPES; ++i) {
+    if (type_len == datatypes[i].len &&
+        !memcmp(type_uri, datatypes[i].uri, type_len)) {
+      return datatypes[i].kind;
+    }
+  }
+
+  return KIND_LITERAL;
+}
+
+/// Return the kind of atom to read a literal with a datatype node as
+static AtomKind
+literal_node_kind(const ReadState* const state, const SordNode* const type)
+{
+  for (unsigned i = 0U; i < N_DATATYPES; ++i) {
+    if (type == state->nodes->datatypes[i]) {
+      return datatypes[i].kind;
+    }
+  }
+
+  return KIND_LITERAL;
+}
+
+/**
+   Read a literal.
+
+   @param kind The kind of atom for the datatype, from literal_kind() or
+   literal_node_kind(), or KIND_STRING for plain literals.
+   @param datatype The mapped datatype if kind is KIND_LITERAL, otherwise 0.
+   @param lang The mapped language URI, or 0 if there is no language.
+*/
+static SerdStatus
+read_literal(ReadState* const      state,
+             LV2_Atom_Forge* const forge,
+             const char* const     str,
+             const size_t          len,
+             const AtomKind        kind,
+             const LV2_URID        datatype,
+             const LV2_URID        lang)
+{
+  const char*        end = NULL;
+  LV2_Atom_Forge_Ref ref = 0;
+
+  switch (kind) {
+  case KIND_INT:
+    ref = lv2_atom_forge_int(forge, (int32_t)number_parse_integer(str, &end));
+    return forge_status(ref);
+  case KIND_LONG:
+    ref = lv2_atom_forge_long(forge, number_parse_integer(str, &end));
+    return forge_status(ref);
+  case KIND_FLOAT:
+    ref = lv2_atom_forge_float(forge, number_parse_float(str, &end));
+    return forge_status(ref);
+  case KIND_DOUBLE:
+    ref = lv2_atom_forge_double(forge, number_parse_double(str, &end));
+    return forge_status(ref);
+  case KIND_BOOL:
+    ref = lv2_atom_forge_bool(forge, !strcmp(str, "true"));
+    return forge_status(ref);
+  case KIND_CHUNK:
+    return read_base64(forge, forge->Chunk, str, len);
+  case KIND_PATH:
+    return forge_status(lv2_atom_forge_path(forge, str, len));
+  case KIND_MIDI_EVENT: {
+    const SerdStatus st = read_midi_event(state, forge, str, len);
+    if (st != SERD_ERR_BAD_SYNTAX) {
+      return st;
+    }
+
+    fprintf(stderr, "Invalid MIDI event \"%s\"\n", str);
+    ref = lv2_atom_forge_literal(
+      forge, str, len, state->sratom->midi_MidiEvent, 0);
+    return forge_status(ref);
+  }
+  default:
+    break;
+  }
+
+  if (datatype) {
+    ref = lv2_atom_forge_literal(forge, str, len, datatype, 0);
+  } else if (lang) {
+    ref = lv2_atom_forge_literal(forge, str, len, 0, lang);
+  } else {
+    ref = lv2_atom_forge_string(forge, str, len);
+  }
+
+  return forge_status(ref);
+}
+
+/// A number or boolean read from text
+typedef union {
+  int32_t i;
+  int64_t l;
+  float   f;
+  double  d;
+} ScalarValue;
+
+/// Parse a number or boolean, setting `end` to the character after it
+static ScalarValue
+parse_scalar(const AtomKind kind, const char* const str, const char** end)
+{
+  ScalarValue value = {0};
+
+  switch (kind) {
+  case KIND_INT:
+    value.i = (int32_t)number_parse_integer(str, end);
+    break;
+  case KIND_LONG:
+    value.l = number_parse_integer(str, end);
+    break;
+  case KIND_FLOAT:
+    value.f = number_parse_float(str, end);
+    break;
+  case KIND_DOUBLE:
+    value.d = number_parse_double(str, end);
+    break;
+  case KIND_BOOL:
+    *end    = str + strcspn(str, " \t\n\r");
+    value.i = (*end - str == 4 && !strncmp(str, "true", 4)) ||
+              (*end - str == 1 && *str == '1');
+    break;
+  default:
+    break;
+  }
+
+  return value;
+}
+
+static SerdStatus
+read_vector_value(ReadState*      state,
+                  LV2_Atom_Forge* forge,
+                  const char*     str,
+                  size_t          len,
+                  bool            is_base64,
+                  uint32_t        child_size,
+                  uint32_t        child_type)
+{
+  if (is_base64) {
+    const size_t size = base64_decoded_size(str, len) / child_size * child_size;
+    if (size > UINT32_MAX - sizeof(LV2_Atom_Vector)) {
+      fprintf(stderr, "Base64 vector is too large\n");
+      return forge_status(lv2_atom_forge_atom(forge, 0, 0));
+    }
+
+    LV2_Atom_Forge_Frame frame = {0, 0};
+    if (!lv2_atom_forge_vector_head(forge, &frame, child_size, child_type)) {
+      return SERD_ERR_BAD_WRITE;
+    }
+
+    const LV2_Atom_Forge_Ref ref = forge_base64(forge, size, str, len);
+    lv2_atom_forge_pop(forge, &frame);
+    lv2_atom_forge_pad(forge, (uint32_t)size);
+    return forge_status(ref);
+  }
+
+  const AtomKind           kind  = atom_kind(state->sratom, child_type);
+  LV2_Atom_Forge_Frame     frame = {0, 0};
+  const LV2_Atom_Forge_Ref ref =
+    lv2_atom_forge_vector_head(forge, &frame, child_size, child_type);
+  if (!ref) {
+    return SERD_ERR_BAD_WRITE;
+  }
+
+  SerdStatus  st = SERD_SUCCESS;
+  const char* s  = str + strspn(str, " \t\n\r");
+  while (*s) {
+    const char*       end  = NULL;
+    const ScalarValue elem = parse_scalar(kind, s, &end);
+    if (!end || end == s || (*end && !strchr(" \t\n\r", *end))) {
+      // Invalid element, give up and truncate vector
+      fprintf(stderr,
+              "Invalid vector element \"%.*s\"\n",
+              (int)strcspn(s, " \t\n\r"),
+              s);
+      break;
+    }
+
+    if (!lv2_atom_forge_raw(forge, &elem, child_size)) {
+      st = SERD_ERR_BAD_WRITE;
+      break;
+    }
+
+    s = end + strspn(end, " \t\n\r");
+  }
+
+  lv2_atom_forge_pop(forge, &frame);
+  lv2_atom_forge_pad(forge, lv2_atom_forge_deref(forge, ref)->size);
+  return st;
+}
+
+/**
+   Read the events of a compact sequence.
+
+   Events are read until the end of the string, or the first invalid time or
+   value, so an invalid literal is truncated rather than failing entirely.
+*/
+static SerdStatus
+read_sequence_value(ReadState*      state,
+                    LV2_Atom_Forge* forge,
+                    const char*     str,
+                    uint32_t        child_type,
+                    bool            beats)
+{
+  const Sratom* const      sratom     = state->sratom;
+  const AtomKind           kind       = atom_kind(sratom, child_type);
+  const uint32_t           child_size =
+    is_scalar_kind(kind) ? atom_size(sratom, child_type) : 0U;
+  LV2_Atom_Forge_Frame     frame      = {0, 0};
+  const LV2_Atom_Forge_Ref ref =
+    lv2_atom_forge_sequence_head(forge, &frame, 0);
+
+  const bool  valid  = ref && (kind == KIND_MIDI_EVENT || child_size);
+  SerdStatus  st     = forge_status(ref);
+  int64_t     frames = 0;
+  const char* s      = valid ? str + strspn(str, " \t\n\r") : "";
+  while (*s) {
+    // Parse the time, which is the difference from the last for frames
+    const char*   end   = NULL;
+    const double  beat  = beats ? number_parse_double(s, &end) : 0.0;
+    const int64_t delta = beats ? 0 : number_parse_integer(s, &end);
+    if (!end || end == s || !*end || !strchr(" \t\n\r", *end)) {
+      break;
+    }
+
+    // Parse the value before writing anything, so the event is complete
+    const char* const value = end + strspn(end, " \t\n\r");
+    const size_t      len   = strcspn(value, " \t\n\r");
+    uint8_t*          midi  = NULL;
+    ScalarValue       elem  = {0};
+    if (!len) {
+      break;
+    }
+
+    if (kind == KIND_MIDI_EVENT) {
+      if (len % 2U || len / 2U > UINT32_MAX ||
+          !(midi = (uint8_t*)arena_alloc(&state->scratch->arena, len / 2U)) ||
+          !hex_decode(midi, value, len)) {
+        break;
+      }
+    } else {
+      elem = parse_scalar(kind, value, &end);
+      if (end != value + len) {
+        break;
+      }
+    }
+
+    LV2_Atom_Forge_Ref time_ref = 0;
+    if (beats) {
+      time_ref = lv2_atom_forge_beat_time(forge, beat);
+    } else {
+      frames   = (int64_t)((uint64_t)frames + (uint64_t)delta);
+      time_ref = lv2_atom_forge_frame_time(forge, frames);
+    }
+
+    const uint32_t    size = midi ? (uint32_t)(len / 2U) : child_size;
+    const void* const body = midi ? (const void*)midi : (const void*)&elem;
+    if (!time_ref || !lv2_atom_forge_atom(forge, size, child_type) ||
+        !lv2_atom_forge_write(forge, body, size)) {
+      st = SERD_ERR_BAD_WRITE;
+      break;
+    }
+
+    s = value + len;
+    s += strspn(s, " \t\n\r");
+  }
+
+  lv2_atom_forge_pop(forge, &frame);
+  if (ref) {
+    LV2_Atom_Sequence* const seq =
+      (LV2_Atom_Sequence*)lv2_atom_forge_deref(forge, ref);
+
+    seq->body.unit = beats ? sratom->atom_beatTime : 0U;
+  }
+
+  return st;
+}
+
+static SerdStatus
+read_object(ReadState*      state,
             LV2_Atom_Forge* forge,
-            SordWorld*      world,
             SordModel*      model,
             const SordNode* node,
             ReadMode        mode)
 {
-  LV2_URID_Map* map = sratom->map;
-  size_t        len = 0;
-  const char*   str = (const char*)sord_node_get_string_counted(node, &len);
+  const Sratom* const sratom = state->sratom;
 
-  SordNode* type  = sord_get(model, node, sratom->nodes.rdf_type, NULL, NULL);
-  SordNode* value = sord_get(model, node, sratom->nodes.rdf_value, NULL, NULL);
+  const VocabNodes* const nodes = state->nodes;
 
-  const uint8_t* type_uri  = NULL;
-  uint32_t       type_urid = 0;
-  if (type) {
-    type_uri  = sord_node_get_string(type);
-    type_urid = map->map(map->handle, (const char*)type_uri);
-  }
+  const SordNode* const type  = get_object(state, model, node, nodes->rdf_type);
+  const SordNode* const value =
+    get_object(state, model, node, nodes->rdf_value);
 
+  const uint32_t type_urid = type ? map_node(state, type) : 0U;
+
+  SerdStatus           st    = SERD_SUCCESS;
   LV2_Atom_Forge_Frame frame = {0, 0};
   if (mode == MODE_SEQUENCE) {
-    SordNode* time =
-      sord_get(model, node, sratom->nodes.atom_beatTime, NULL, NULL);
-    uint32_t seq_unit = 0U;
+    const SordNode* time =
+      get_object(state, model, node, nodes->atom_beatTime);
+    uint32_t           seq_unit = 0U;
+    const char*        end      = NULL;
+    LV2_Atom_Forge_Ref ref      = 0;
     if (time) {
-      const char* time_str = (const char*)sord_node_get_string(time);
-      lv2_atom_forge_beat_time(forge, serd_strtod(time_str, NULL));
+      const char*  time_str = (const char*)sord_node_get_string(time);
+      const double beat     = number_parse_double(time_str, &end);
+
+      ref      = lv2_atom_forge_beat_time(forge, beat);
       seq_unit = sratom->atom_beatTime;
     } else {
-      time = sord_get(model, node, sratom->nodes.atom_frameTime, NULL, NULL);
+      time = get_object(state, model, node, nodes->atom_frameTime);
       const char* time_str =
         time ? (const char*)sord_node_get_string(time) : "";
-      lv2_atom_forge_frame_time(forge, serd_strtod(time_str, NULL));
+      const int64_t frames = number_parse_integer(time_str, &end);
+      ref      = lv2_atom_forge_frame_time(forge, frames);
       seq_unit = sratom->atom_frameTime;
     }
-    read_node(sratom, forge, world, model, value, MODE_BODY);
-    sord_node_free(world, time);
-    sratom->seq_unit = seq_unit;
+    st = ref ? read_node(state, forge, model, value, MODE_BODY)
+             : SERD_ERR_BAD_WRITE;
+    state->seq_unit = seq_unit;
   } else if (type_urid == sratom->forge.Tuple) {
-    lv2_atom_forge_tuple(forge, &frame);
-    read_list_value(sratom, forge, world, model, value, MODE_BODY);
+    st = lv2_atom_forge_tuple(forge, &frame)
+           ? read_list_value(state, forge, model, value, MODE_BODY)
+           : SERD_ERR_BAD_WRITE;
   } else if (type_urid == sratom->forge.Sequence) {
-    const LV2_Atom_Forge_Ref ref =
-      lv2_atom_forge_sequence_head(forge, &frame, 0);
-    sratom->seq_unit = 0;
-    read_list_value(sratom, forge, world, model, value, MODE_SEQUENCE);
+    const SordNode* const child_type_node =
+      get_object(state, model, node, nodes->atom_childType);
+    if (child_type_node && value &&
+        sord_node_get_type(value) == SORD_LITERAL) {
+      const SordNode* const unit =
+        get_object(state, model, node, nodes->atom_timeUnit);
+
+      st = read_sequence_value(
+        state,
+        forge,
+        (const char*)sord_node_get_string(value),
+        map_node(state, child_type_node),
+        unit && !strcmp((const char*)sord_node_get_string(unit),
+                        LV2_UNITS__beat));
+    } else {
+      const LV2_Atom_Forge_Ref ref =
+        lv2_atom_forge_sequence_head(forge, &frame, 0);
+      if (!ref) {
+        return SERD_ERR_BAD_WRITE;
+      }
 
-    LV2_Atom_Sequence* seq =
-      (LV2_Atom_Sequence*)lv2_atom_forge_deref(forge, ref);
-    seq->body.unit =
-      (sratom->seq_unit == sratom->atom_frameTime) ? 0 : sratom->seq_unit;
+      state->seq_unit = 0;
+      st = read_list_value(state, forge, model, value, MODE_SEQUENCE);
+
+      LV2_Atom_Sequence* seq =
+        (LV2_Atom_Sequence*)lv2_atom_forge_deref(forge, ref);
+      seq->body.unit =
+        (state->seq_unit == sratom->atom_frameTime) ? 0 : state->seq_unit;
+    }
   } else if (type_urid == sratom->forge.Vector) {
-    SordNode* child_type_node =
-      sord_get(model, node, sratom->nodes.atom_childType, NULL, NULL);
+    const SordNode* const child_type_node =
+      get_object(state, model, node, nodes->atom_childType);
     if (child_type_node) {
-      uint32_t child_type = map->map(
-        map->handle, (const char*)sord_node_get_string(child_type_node));
-      uint32_t child_size = atom_size(sratom, child_type);
-      if (child_size > 0) {
+      uint32_t child_type = map_node(state, child_type_node);
+      uint32_t child_size = atom_size(state->sratom, child_type);
+      if (child_size > 0 && value &&
+          sord_node_get_type(value) == SORD_LITERAL &&
+          is_scalar_kind(atom_kind(state->sratom, child_type))) {
+        size_t            vlen = 0;
+        const char* const vstr =
+          (const char*)sord_node_get_string_counted(value, &vlen);
+
+        st = read_vector_value(state,
+                               forge,
+                               vstr,
+                               vlen,
+                               sord_node_equals(sord_node_get_datatype(value),
+                                                nodes->xsd_base64Binary),
+                               child_size,
+                               child_type);
+      } else if (child_size > 0) {
         LV2_Atom_Forge_Ref ref =
           lv2_atom_forge_vector_head(forge, &frame, child_size, child_type);
-        read_list_value(sratom, forge, world, model, value, MODE_BODY);
+        st = ref ? read_list_value(state, forge, model, value, MODE_BODY)
+                 : SERD_ERR_BAD_WRITE;
         lv2_atom_forge_pop(forge, &frame);
         frame.ref = 0;
-        lv2_atom_forge_pad(forge, lv2_atom_forge_deref(forge, ref)->size);
+        if (ref) {
+          lv2_atom_forge_pad(forge, lv2_atom_forge_deref(forge, ref)->size);
+        }
       }
     }
-    sord_node_free(world, child_type_node);
   } else if (value && sord_node_equals(sord_node_get_datatype(value),
-                                       sratom->nodes.xsd_base64Binary)) {
-    size_t         vlen = 0;
-    const uint8_t* vstr = sord_node_get_string_counted(value, &vlen);
-    size_t         size = 0;
-    void*          body = serd_base64_decode(vstr, vlen, &size);
-    lv2_atom_forge_atom(forge, size, type_urid);
-    lv2_atom_forge_write(forge, body, size);
-    free(body);
-  } else if (sord_node_get_type(node) == SORD_URI) {
-    lv2_atom_forge_object(forge, &frame, map->map(map->handle, str), type_urid);
-    read_resource(sratom, forge, world, model, node, type_urid);
+                                       nodes->xsd_base64Binary)) {
+    size_t            vlen = 0;
+    const char* const vstr =
+      (const char*)sord_node_get_string_counted(value, &vlen);
+
+    st = read_base64(forge, type_urid, vstr, vlen);
   } else {
-    lv2_atom_forge_object(forge, &frame, 0, type_urid);
-    read_resource(sratom, forge, world, model, node, type_urid);
+    const LV2_URID id =
+      sord_node_get_type(node) == SORD_URI ? map_node(state, node) : 0U;
+
+    st = lv2_atom_forge_object(forge, &frame, id, type_urid)
+           ? read_resource(state, forge, model, node, type_urid)
+           : SERD_ERR_BAD_WRITE;
   }
 
   if (frame.ref) {
     lv2_atom_forge_pop(forge, &frame);
   }
-  sord_node_free(world, value);
-  sord_node_free(world, type);
+
+  return st;
 }
 
-static void
-read_node(Sratom*         sratom,
+static SerdStatus
+read_node(ReadState*      state,
           LV2_Atom_Forge* forge,
-          SordWorld*      world,
           SordModel*      model,
           const SordNode* node,
           ReadMode        mode)
 {
-  LV2_URID_Map* map = sratom->map;
-  size_t        len = 0;
-  const char*   str = (const char*)sord_node_get_string_counted(node, &len);
+  const Sratom* const sratom = state->sratom;
+
+  size_t      len = 0;
+  const char* str = (const char*)sord_node_get_string_counted(node, &len);
   if (sord_node_get_type(node) == SORD_LITERAL) {
-    read_literal(sratom, forge, node);
-  } else if (sord_node_get_type(node) == SORD_URI &&
-             !(sratom->object_mode == SRATOM_OBJECT_MODE_BLANK_SUBJECT &&
-               mode == MODE_SUBJECT)) {
-    if (!strcmp(str, (const char*)NS_RDF "nil")) {
-      lv2_atom_forge_atom(forge, 0, 0);
-    } else if (!strncmp(str, "file://", 7)) {
-      SerdURI uri;
-      serd_uri_parse(USTR(str), &uri);
-
-      SerdNode rel =
-        serd_node_new_relative_uri(&uri, &sratom->base, &sratom->base, NULL);
-
-      uint8_t* const path = serd_file_uri_parse(USTR(rel.buf), NULL);
-
-      if (path) {
-        lv2_atom_forge_path(
-          forge, (const char*)path, strlen((const char*)path));
-        serd_free(path);
-      } else {
-        // FIXME: Report errors (required API change)
-        lv2_atom_forge_atom(forge, 0, 0);
-      }
-      serd_node_free(&rel);
-    } else {
-      lv2_atom_forge_urid(forge, map->map(map->handle, str));
-    }
-  } else {
-    read_object(sratom, forge, world, model, node, mode);
+    const SordNode*   datatype = sord_node_get_datatype(node);
+    const char* const language = sord_node_get_language(node);
+    const AtomKind    kind =
+      datatype ? literal_node_kind(state, datatype) : KIND_STRING;
+
+    return read_literal(state,
+                        forge,
+                        str,
+                        len,
+                        kind,
+                        kind == KIND_LITERAL ? map_node(state, datatype) : 0U,
+                        language ? map_language(state, language) : 0U);
+  }
+
+  if (sord_node_get_type(node) == SORD_URI &&
+      !(sratom->object_mode == SRATOM_OBJECT_MODE_BLANK_SUBJECT &&
+        mode == MODE_SUBJECT)) {
+    const SerdStatus st = read_unmapped_uri(state, forge, str);
+    return (st == SERD_FAILURE)
+             ? forge_status(lv2_atom_forge_urid(forge, map_node(state, node)))
+             : st;
+  }
+
+  return read_object(state, forge, model, node, mode);
+}
+
+static void
+new_vocab_nodes(VocabNodes* const nodes, SordWorld* const world)
+{
+  nodes->atom_childType   = sord_new_uri(world, USTR(LV2_ATOM__childType));
+  nodes->atom_frameTime   = sord_new_uri(world, USTR(LV2_ATOM__frameTime));
+  nodes->atom_beatTime    = sord_new_uri(world, USTR(LV2_ATOM__beatTime));
+  nodes->atom_timeUnit    = sord_new_uri(world, USTR(LV2_ATOM__timeUnit));
+  nodes->rdf_first        = sord_new_uri(world, NS_RDF "first");
+  nodes->rdf_rest         = sord_new_uri(world, NS_RDF "rest");
+  nodes->rdf_type         = sord_new_uri(world, NS_RDF "type");
+  nodes->rdf_value        = sord_new_uri(world, NS_RDF "value");
+  nodes->xsd_base64Binary = sord_new_uri(world, NS_XSD "base64Binary");
+
+  for (unsigned i = 0U; i < N_DATATYPES; ++i) {
+    nodes->datatypes[i] = sord_new_uri(world, USTR(datatypes[i].uri));
+  }
+}
+
+static void
+free_vocab_nodes(VocabNodes* const nodes, SordWorld* const world)
+{
+  for (unsigned i = 0U; i < N_DATATYPES; ++i) {
+    sord_node_free(world, nodes->datatypes[N_DATATYPES - 1U - i]);
+  }
+
+  sord_node_free(world, nodes->xsd_base64Binary);
+  sord_node_free(world, nodes->rdf_value);
+  sord_node_free(world, nodes->rdf_type);
+  sord_node_free(world, nodes->rdf_rest);
+  sord_node_free(world, nodes->rdf_first);
+  sord_node_free(world, nodes->atom_timeUnit);
+  sord_node_free(world, nodes->atom_frameTime);
+  sord_node_free(world, nodes->atom_beatTime);
+  sord_node_free(world, nodes->atom_childType);
+  memset(nodes, 0, sizeof(VocabNodes));
+}
+
+void
+sratom_bind_world(Sratom* sratom, SordWorld* world)
+{
+  if (world != sratom->world) {
+    sratom_unbind_world(sratom);
+    new_vocab_nodes(&sratom->nodes, world);
+    sratom->world = world;
   }
 }
 
+void
+sratom_unbind_world(Sratom* sratom)
+{
+  if (sratom->world) {
+    free_vocab_nodes(&sratom->nodes, sratom->world);
+    sratom->world = NULL;
+  }
+}
+
+void
+sratom_clear_unmap_cache(Sratom* const sratom)
+{
+  fetch_increment(&sratom->unmap_epoch);
+}
+
+SratomCacheStats
+sratom_urid_cache_stats(const Sratom* sratom)
+{
+  return sratom->scratch.urid_stats;
+}
+
+/**
+   Read an atom from a model.
+
+   If the state has no vocabulary nodes for the world, temporary ones are
+   interned for this call.
+
+   @return SERD_ERR_BAD_WRITE if writing to the forge failed, otherwise
+   SERD_SUCCESS.
+*/
+static SerdStatus
+read_model(ReadState* const      state,
+           LV2_Atom_Forge* const forge,
+           SordWorld* const      world,
+           SordModel* const      model,
+           const SordNode* const node)
+{
+  clear_urids(state->scratch);
+
+  if (state->nodes) {
+    return read_node(state, forge, model, node, MODE_SUBJECT);
+  }
+
+  VocabNodes nodes;
+  lock_model(state);
+  new_vocab_nodes(&nodes, world);
+  unlock_model(state);
+  state->nodes = &nodes;
+
+  const SerdStatus st = read_node(state, forge, model, node, MODE_SUBJECT);
+
+  state->nodes = NULL;
+  lock_model(state);
+  free_vocab_nodes(&nodes, world);
+  unlock_model(state);
+  return st;
+}
+
 void
 sratom_read(Sratom*         sratom,
             LV2_Atom_Forge* forge,
@@ -1134,35 +2978,126 @@ sratom_read(Sratom*         sratom,
             SordModel*      model,
             const SordNode* node)
 {
-  sratom->nodes.atom_childType = sord_new_uri(world, USTR(LV2_ATOM__childType));
-  sratom->nodes.atom_frameTime = sord_new_uri(world, USTR(LV2_ATOM__frameTime));
-  sratom->nodes.atom_beatTime  = sord_new_uri(world, USTR(LV2_ATOM__beatTime));
-  sratom->nodes.rdf_first      = sord_new_uri(world, NS_RDF "first");
-  sratom->nodes.rdf_rest       = sord_new_uri(world, NS_RDF "rest");
-  sratom->nodes.rdf_type       = sord_new_uri(world, NS_RDF "type");
-  sratom->nodes.rdf_value      = sord_new_uri(world, NS_RDF "value");
-  sratom->nodes.xsd_base64Binary = sord_new_uri(world, NS_XSD "base64Binary");
-
-  sratom->next_id = 1;
-  read_node(sratom, forge, world, model, node, MODE_SUBJECT);
-
-  sord_node_free(world, sratom->nodes.xsd_base64Binary);
-  sord_node_free(world, sratom->nodes.rdf_value);
-  sord_node_free(world, sratom->nodes.rdf_type);
-  sord_node_free(world, sratom->nodes.rdf_rest);
-  sord_node_free(world, sratom->nodes.rdf_first);
-  sord_node_free(world, sratom->nodes.atom_frameTime);
-  sord_node_free(world, sratom->nodes.atom_beatTime);
-  sord_node_free(world, sratom->nodes.atom_childType);
-
-  sratom->nodes.xsd_base64Binary = NULL;
-  sratom->nodes.rdf_value        = NULL;
-  sratom->nodes.rdf_type         = NULL;
-  sratom->nodes.rdf_rest         = NULL;
-  sratom->nodes.rdf_first        = NULL;
-  sratom->nodes.atom_beatTime    = NULL;
-  sratom->nodes.atom_frameTime   = NULL;
-  sratom->nodes.atom_childType   = NULL;
+  Scratch   local;
+  ReadState state = {sratom,
+                     claim_scratch(sratom, &local),
+                     world == sratom->world ? &sratom->nodes : NULL,
+                     &sratom->base,
+                     &sratom->model_lock,
+                     0U};
+
+  read_model(&state, forge, world, model, node);
+  release_scratch(sratom, state.scratch);
+}
+
+/// A thread that reads every `stride`th node of many
+typedef struct {
+  Sratom*                sratom;
+  const VocabNodes*      nodes;
+  SordWorld*             world;
+  SordModel*             model;
+  const SordNode* const* subjects;
+  SratomForgeBuffer*     buffers;
+  size_t                 n_subjects;
+  size_t                 first;  ///< Index of the first node to read
+  size_t                 stride; ///< Number of nodes between read nodes
+  bool                   failed; ///< True if reading any node failed
+} ReadWorker;
+
+static void
+run_read_worker(void* const arg)
+{
+  ReadWorker* const worker = (ReadWorker*)arg;
+
+  Scratch scratch;
+  scratch_init(&scratch);
+
+  ReadState state = {worker->sratom,
+                     &scratch,
+                     worker->nodes,
+                     &worker->sratom->base,
+                     &worker->sratom->model_lock,
+                     0U};
+
+  LV2_Atom_Forge forge = worker->sratom->forge;
+  for (size_t i = worker->first; i < worker->n_subjects; i += worker->stride) {
+    SratomForgeBuffer* const buffer = &worker->buffers[i];
+
+    sratom_forge_buffer_clear(buffer);
+    lv2_atom_forge_set_sink(
+      &forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, buffer);
+
+    state.seq_unit      = 0U;
+    const SerdStatus st = read_model(
+      &state, &forge, worker->world, worker->model, worker->subjects[i]);
+
+    worker->failed = worker->failed || st || !buffer->len;
+
+    arena_reset(&scratch.arena);
+  }
+
+  scratch_cleanup(&scratch);
+}
+
+int
+sratom_read_many(Sratom*                sratom,
+                 SordWorld*             world,
+                 SordModel*             model,
+                 unsigned               n_threads,
+                 size_t                 n_subjects,
+                 const SordNode* const* subjects,
+                 SratomForgeBuffer*     buffers)
+{
+  // Use at least one thread, but no more than one per subject
+  size_t n_workers = n_threads ? n_threads : 1U;
+  if (n_workers > n_subjects) {
+    n_workers = n_subjects ? n_subjects : 1U;
+  }
+
+  ReadWorker* const workers =
+    (ReadWorker*)calloc(n_workers, sizeof(ReadWorker));
+  if (!workers) {
+    return 1;
+  }
+
+  // Intern the vocabulary once, since interning nodes isn't thread-safe
+  VocabNodes  local_nodes;
+  const bool  bound = world == sratom->world;
+  VocabNodes* nodes = bound ? &sratom->nodes : &local_nodes;
+  if (!bound) {
+    mutex_lock(&sratom->model_lock);
+    new_vocab_nodes(&local_nodes, world);
+    mutex_unlock(&sratom->model_lock);
+  }
+
+  for (size_t i = 0U; i < n_workers; ++i) {
+    ReadWorker* const worker = &workers[i];
+    worker->sratom           = sratom;
+    worker->nodes            = nodes;
+    worker->world            = world;
+    worker->model            = model;
+    worker->subjects         = subjects;
+    worker->buffers          = buffers;
+    worker->n_subjects       = n_subjects;
+    worker->first            = i;
+    worker->stride           = n_workers;
+  }
+
+  thread_run_parallel(run_read_worker, workers, sizeof(ReadWorker), n_workers);
+
+  bool failed = false;
+  for (size_t i = 0U; i < n_workers; ++i) {
+    failed = failed || workers[i].failed;
+  }
+
+  if (!bound) {
+    mutex_lock(&sratom->model_lock);
+    free_vocab_nodes(&local_nodes, world);
+    mutex_unlock(&sratom->model_lock);
+  }
+
+  free(workers);
+  return failed;
 }
 
 LV2_Atom_Forge_Ref
@@ -1183,49 +3118,1286 @@ sratom_forge_deref(LV2_Atom_Forge_Sink_Handle handle, LV2_Atom_Forge_Ref ref)
   return (LV2_Atom*)(chunk->buf + ref - 1);
 }
 
+static int
+forge_buffer_reserve(SratomForgeBuffer* const buffer, const size_t size)
+{
+  if (size <= buffer->cap) {
+    return 0;
+  }
+
+  size_t cap = buffer->cap ? buffer->cap : 64U;
+  while (cap < size) {
+    cap *= 2U;
+  }
+
+  uint8_t* const buf = (uint8_t*)realloc(buffer->buf, cap);
+  if (!buf) {
+    return 1;
+  }
+
+  buffer->buf = buf;
+  buffer->cap = cap;
+  return 0;
+}
+
+int
+sratom_forge_buffer_init(SratomForgeBuffer* const buffer, const size_t capacity)
+{
+  buffer->buf = NULL;
+  buffer->len = 0U;
+  buffer->cap = 0U;
+  return forge_buffer_reserve(buffer, capacity);
+}
+
+void
+sratom_forge_buffer_clear(SratomForgeBuffer* const buffer)
+{
+  buffer->len = 0U;
+}
+
+void
+sratom_forge_buffer_cleanup(SratomForgeBuffer* const buffer)
+{
+  free(buffer->buf);
+  buffer->buf = NULL;
+  buffer->len = 0U;
+  buffer->cap = 0U;
+}
+
+LV2_Atom_Forge_Ref
+sratom_forge_buffer_sink(LV2_Atom_Forge_Sink_Handle handle,
+                         const void*                buf,
+                         uint32_t                   size)
+{
+  SratomForgeBuffer* const buffer = (SratomForgeBuffer*)handle;
+  if (forge_buffer_reserve(buffer, buffer->len + size)) {
+    return 0;
+  }
+
+  const LV2_Atom_Forge_Ref ref = buffer->len + 1U;
+  memcpy(buffer->buf + buffer->len, buf, size);
+  buffer->len += size;
+  return ref;
+}
+
 LV2_Atom*
-sratom_from_turtle(Sratom*         sratom,
-                   const char*     base_uri,
-                   const SerdNode* subject,
-                   const SerdNode* predicate,
-                   const char*     str)
+sratom_forge_buffer_deref(LV2_Atom_Forge_Sink_Handle handle,
+                          LV2_Atom_Forge_Ref         ref)
 {
-  SerdChunk out = {NULL, 0};
-  SerdNode  base =
-    serd_node_new_uri_from_string(USTR(base_uri), &sratom->base, NULL);
-  SordWorld*  world  = sord_world_new();
-  SordModel*  model  = sord_new(world, SORD_SPO, false);
-  SerdEnv*    env    = sratom->env ? sratom->env : serd_env_new(&base);
-  SerdReader* reader = sord_new_reader(model, env, SERD_TURTLE, NULL);
+  const SratomForgeBuffer* const buffer = (const SratomForgeBuffer*)handle;
+  return (LV2_Atom*)(buffer->buf + ref - 1U);
+}
 
-  if (!serd_reader_read_string(reader, USTR(str))) {
-    const SordNode* s = sord_node_from_serd_node(world, env, subject, 0, 0);
-    lv2_atom_forge_set_sink(
-      &sratom->forge, sratom_forge_sink, sratom_forge_deref, &out);
+/// State of a node in the streaming reader
+typedef enum {
+  STREAM_PENDING, ///< No statements read yet
+  STREAM_TYPED,   ///< Type read, but atom not started
+  STREAM_OBJECT,  ///< Object started, reading properties
+  STREAM_TIMED,   ///< Event time written, value expected
+  STREAM_LIST,    ///< Container started, reading its value list
+  STREAM_DONE,    ///< Atom finished, no more statements expected
+} StreamState;
+
+/// An open anonymous node or list in the streaming reader
+typedef struct {
+  LV2_Atom_Forge_Frame frame;      ///< Forge frame for containers
+  LV2_Atom_Forge_Ref   ref;        ///< Reference to container header
+  size_t               label;      ///< Offset of node label in labels
+  LV2_URID             id;         ///< Object ID
+  LV2_URID             otype;      ///< Object type
+  LV2_URID             child_type; ///< Vector child type
+  LV2_URID             seq_unit;   ///< Time unit of (last) event
+  StreamState          state;      ///< Progress through node description
+  ReadMode             mode;       ///< Mode for reading node or elements
+  bool                 is_list;    ///< True if this is a list node
+  bool                 has_first;  ///< True if list element has been read
+} StreamFrame;
+
+/**
+   Reader that forges an atom while parsing.
+
+   Documents written by sratom are trees of anonymous nodes and lists, so
+   every node is described immediately after it is referenced, and the atom
+   can be built from statements as they arrive without storing them.
+   Anything else is flagged as unsupported, so the caller can fall back to
+   loading the document into a model.
+*/
+typedef struct {
+  ReadState*      state;       ///< State of the current call
+  LV2_Atom_Forge* forge;       ///< Forge for the atom being read
+  SerdEnv*        env;
+  const SerdNode* subject;
+  const SerdNode* predicate;
+  StreamFrame*    frames;      ///< Stack of open nodes
+  unsigned        n_frames;    ///< Number of open nodes
+  unsigned        frames_cap;  ///< Allocated number of frames
+  char*           labels;      ///< Null-terminated labels of open nodes
+  size_t          labels_len;  ///< Length of labels in bytes
+  size_t          labels_cap;  ///< Allocated size of labels in bytes
+  bool            has_root;    ///< First frame is the top-level subject
+  bool            found;       ///< Statement with the root value was read
+  bool            unsupported; ///< Document needs the model-based reader
+} StreamReader;
+
+static SerdStatus
+stream_unsupported(StreamReader* const reader)
+{
+  reader->unsupported = true;
+  return SERD_FAILURE;
+}
+
+static bool
+stream_is_uri(const SerdNode* const node, const uint8_t* const uri)
+{
+  return node->type == SERD_URI &&
+         !strcmp((const char*)node->buf, (const char*)uri);
+}
+
+static bool
+stream_is_label(const StreamReader* const reader,
+                const unsigned            index,
+                const SerdNode* const     node)
+{
+  const SerdType type =
+    (!index && reader->has_root) ? reader->subject->type : SERD_BLANK;
+
+  return node->type == type &&
+         !strcmp(reader->labels + reader->frames[index].label,
+                 (const char*)node->buf);
+}
+
+static bool
+stream_push_label(StreamReader* const   reader,
+                  const SerdNode* const node,
+                  size_t* const         offset)
+{
+  const size_t size = node->n_bytes + 1U;
+  if (reader->labels_len + size > reader->labels_cap) {
+    size_t cap = reader->labels_cap ? reader->labels_cap : 64U;
+    while (cap < reader->labels_len + size) {
+      cap *= 2U;
+    }
+
+    char* const labels = (char*)realloc(reader->labels, cap);
+    if (!labels) {
+      return false;
+    }
+
+    reader->labels     = labels;
+    reader->labels_cap = cap;
+  }
+
+  *offset = reader->labels_len;
+  memcpy(reader->labels + reader->labels_len, node->buf, size);
+  reader->labels_len += size;
+  return true;
+}
+
+static StreamFrame*
+stream_push(StreamReader* const   reader,
+            const SerdNode* const node,
+            const ReadMode        mode,
+            const bool            is_list)
+{
+  if (reader->n_frames == reader->frames_cap) {
+    const unsigned     cap = reader->frames_cap ? reader->frames_cap * 2U : 8U;
+    StreamFrame* const frames =
+      (StreamFrame*)realloc(reader->frames, cap * sizeof(StreamFrame));
+    if (!frames) {
+      return NULL;
+    }
+
+    reader->frames     = frames;
+    reader->frames_cap = cap;
+  }
+
+  StreamFrame* const frame = &reader->frames[reader->n_frames];
+  memset(frame, 0, sizeof(StreamFrame));
+  frame->state   = is_list ? STREAM_LIST : STREAM_PENDING;
+  frame->mode    = mode;
+  frame->is_list = is_list;
+  if (!stream_push_label(reader, node, &frame->label)) {
+    return NULL;
+  }
+
+  ++reader->n_frames;
+  return frame;
+}
+
+static void
+stream_pop(StreamReader* const reader)
+{
+  reader->labels_len = reader->frames[--reader->n_frames].label;
+}
+
+static bool
+stream_is_container(const Sratom* const sratom, const LV2_URID type)
+{
+  return type == sratom->forge.Tuple || type == sratom->forge.Sequence ||
+         type == sratom->forge.Vector;
+}
+
+static LV2_URID
+stream_map(const StreamReader* const reader, const SerdNode* const node)
+{
+  LV2_URID_Map* const map = reader->state->sratom->map;
+  return map->map(map->handle, (const char*)node->buf);
+}
+
+static LV2_URID
+stream_map_language(const StreamReader* const reader,
+                    const SerdNode* const     lang)
+{
+  LV2_URID_Map* const map = reader->state->sratom->map;
+  const char* const   uri =
+    language_uri(&reader->state->scratch->arena, (const char*)lang->buf);
+
+  return uri ? map->map(map->handle, uri) : 0U;
+}
+
+static SerdStatus
+stream_read_value(StreamReader* const      reader,
+                  const SerdStatementFlags flags,
+                  const SerdNode* const    object,
+                  const SerdNode* const    datatype,
+                  const SerdNode* const    lang,
+                  const ReadMode           mode)
+{
+  const Sratom* const   sratom = reader->state->sratom;
+  LV2_Atom_Forge* const forge  = reader->forge;
+
+  if (object->type == SERD_LITERAL) {
+    const AtomKind kind =
+      datatype ? literal_kind((const char*)datatype->buf, datatype->n_bytes)
+               : KIND_STRING;
+
+    read_literal(reader->state,
+                 forge,
+                 (const char*)object->buf,
+                 object->n_bytes,
+                 kind,
+                 kind == KIND_LITERAL ? stream_map(reader, datatype) : 0U,
+                 lang ? stream_map_language(reader, lang) : 0U);
+  } else if (object->type == SERD_URI) {
+    if (mode == MODE_SUBJECT &&
+        sratom->object_mode == SRATOM_OBJECT_MODE_BLANK_SUBJECT) {
+      return stream_unsupported(reader); // Described elsewhere
+    }
+
+    if (read_unmapped_uri(reader->state, forge, (const char*)object->buf) ==
+        SERD_FAILURE) {
+      lv2_atom_forge_urid(forge, stream_map(reader, object));
+    }
+  } else if (object->type == SERD_BLANK && (flags & SERD_ANON_O_BEGIN)) {
+    if (!stream_push(reader, object, mode, false)) {
+      return stream_unsupported(reader);
+    }
+  } else if (object->type == SERD_BLANK && (flags & SERD_EMPTY_O) &&
+             mode != MODE_SEQUENCE) {
+    LV2_Atom_Forge_Frame frame;
+    lv2_atom_forge_object(forge, &frame, 0, 0);
+    lv2_atom_forge_pop(forge, &frame);
+  } else {
+    return stream_unsupported(reader); // Named blank node or bare list
+  }
+
+  return SERD_SUCCESS;
+}
+
+static void
+stream_end_container(StreamReader* const reader,
+                     StreamFrame* const  frame,
+                     const LV2_URID      seq_unit)
+{
+  const Sratom* const   sratom = reader->state->sratom;
+  LV2_Atom_Forge* const forge  = reader->forge;
+
+  lv2_atom_forge_pop(forge, &frame->frame);
+  if (frame->otype == forge->Sequence) {
+    LV2_Atom_Sequence* const seq =
+      (LV2_Atom_Sequence*)lv2_atom_forge_deref(forge, frame->ref);
+
+    seq->body.unit = (seq_unit == sratom->atom_frameTime) ? 0 : seq_unit;
+  } else if (frame->otype == forge->Vector) {
+    lv2_atom_forge_pad(forge, lv2_atom_forge_deref(forge, frame->ref)->size);
+  }
+
+  frame->state = STREAM_DONE;
+}
+
+static SerdStatus
+stream_container_statement(StreamReader* const      reader,
+                           const unsigned           index,
+                           const SerdStatementFlags flags,
+                           const SerdNode* const    predicate,
+                           const SerdNode* const    object,
+                           const SerdNode* const    datatype)
+{
+  const Sratom* const   sratom = reader->state->sratom;
+  LV2_Atom_Forge* const forge  = reader->forge;
+  StreamFrame* const    frame  = &reader->frames[index];
+
+  if (frame->otype != forge->Tuple && !frame->child_type &&
+      stream_is_uri(predicate, USTR(LV2_ATOM__childType)) &&
+      object->type == SERD_URI) {
+    frame->child_type = stream_map(reader, object);
+    return SERD_SUCCESS;
+  }
+
+  if (frame->otype == forge->Sequence &&
+      stream_is_uri(predicate, USTR(LV2_ATOM__timeUnit)) &&
+      object->type == SERD_URI) {
+    frame->seq_unit = stream_is_uri(object, USTR(LV2_UNITS__beat))
+                        ? sratom->atom_beatTime
+                        : sratom->atom_frameTime;
+    return SERD_SUCCESS;
+  }
+
+  if (!stream_is_uri(predicate, NS_RDF "value")) {
+    return stream_unsupported(reader);
+  }
+
+  if (frame->otype == forge->Sequence && frame->child_type &&
+      object->type == SERD_LITERAL) {
+    read_sequence_value(reader->state,
+                        forge,
+                        (const char*)object->buf,
+                        frame->child_type,
+                        frame->seq_unit == sratom->atom_beatTime);
+    frame->state = STREAM_DONE;
+    return SERD_SUCCESS;
+  }
+
+  if (frame->otype == forge->Vector) {
+    const uint32_t child_size = atom_size(sratom, frame->child_type);
+    if (!child_size) {
+      return stream_unsupported(reader);
+    }
+
+    if (object->type == SERD_LITERAL &&
+        is_scalar_kind(atom_kind(sratom, frame->child_type))) {
+      const bool is_base64 =
+        datatype && stream_is_uri(datatype, NS_XSD "base64Binary");
+
+      read_vector_value(reader->state,
+                        forge,
+                        (const char*)object->buf,
+                        object->n_bytes,
+                        is_base64,
+                        child_size,
+                        frame->child_type);
+      frame->state = STREAM_DONE;
+      return SERD_SUCCESS;
+    }
+
+    frame->ref = lv2_atom_forge_vector_head(
+      forge, &frame->frame, child_size, frame->child_type);
+  } else if (frame->otype == forge->Tuple) {
+    lv2_atom_forge_tuple(forge, &frame->frame);
+  } else {
+    frame->ref = lv2_atom_forge_sequence_head(forge, &frame->frame, 0);
+  }
+
+  frame->state = STREAM_LIST;
+  if (stream_is_uri(object, NS_RDF "nil")) {
+    stream_end_container(reader, frame, 0U);
+  } else if (object->type != SERD_BLANK || !(flags & SERD_LIST_O_BEGIN) ||
+             !stream_push(reader,
+                          object,
+                          frame->otype == forge->Sequence ? MODE_SEQUENCE
+                                                          : MODE_BODY,
+                          true)) {
+    return stream_unsupported(reader);
+  }
+
+  return SERD_SUCCESS;
+}
+
+static SerdStatus
+stream_node_statement(StreamReader* const      reader,
+                      const unsigned           index,
+                      const SerdStatementFlags flags,
+                      const SerdNode* const    predicate,
+                      const SerdNode* const    object,
+                      const SerdNode* const    datatype,
+                      const SerdNode* const    lang)
+{
+  const Sratom* const   sratom = reader->state->sratom;
+  LV2_Atom_Forge* const forge  = reader->forge;
+  StreamFrame* const    frame  = &reader->frames[index];
+
+  const bool is_type   = stream_is_uri(predicate, NS_RDF "type");
+  const bool is_base64 = stream_is_uri(predicate, NS_RDF "value") &&
+                         object->type == SERD_LITERAL && datatype &&
+                         stream_is_uri(datatype, NS_XSD "base64Binary");
+
+  if (frame->state == STREAM_PENDING && is_type && object->type == SERD_URI) {
+    frame->otype = stream_map(reader, object);
+    frame->state = STREAM_TYPED;
+    return SERD_SUCCESS;
+  }
+
+  if (frame->state == STREAM_TYPED &&
+      stream_is_container(sratom, frame->otype)) {
+    return stream_container_statement(
+      reader, index, flags, predicate, object, datatype);
+  }
+
+  if (frame->state == STREAM_PENDING || frame->state == STREAM_TYPED) {
+    if (is_base64) {
+      read_base64(
+        forge, frame->otype, (const char*)object->buf, object->n_bytes);
+      frame->state = STREAM_DONE;
+      return SERD_SUCCESS;
+    }
+
+    lv2_atom_forge_object(forge, &frame->frame, frame->id, frame->otype);
+    frame->state = STREAM_OBJECT;
+  }
+
+  if (frame->state != STREAM_OBJECT || is_type || is_base64) {
+    return stream_unsupported(reader); // Order differs from sratom output
+  }
+
+  lv2_atom_forge_key(forge, stream_map(reader, predicate));
+  return stream_read_value(reader, flags, object, datatype, lang, MODE_BODY);
+}
+
+static SerdStatus
+stream_event_statement(StreamReader* const      reader,
+                       const unsigned           index,
+                       const SerdStatementFlags flags,
+                       const SerdNode* const    predicate,
+                       const SerdNode* const    object,
+                       const SerdNode* const    datatype,
+                       const SerdNode* const    lang)
+{
+  const Sratom* const   sratom = reader->state->sratom;
+  LV2_Atom_Forge* const forge  = reader->forge;
+  StreamFrame* const    frame  = &reader->frames[index];
+
+  if (frame->state == STREAM_PENDING && object->type == SERD_LITERAL) {
+    const char* const time_str = (const char*)object->buf;
+    const char*       end      = NULL;
+    if (stream_is_uri(predicate, USTR(LV2_ATOM__beatTime))) {
+      lv2_atom_forge_beat_time(forge, number_parse_double(time_str, &end));
+      frame->seq_unit = sratom->atom_beatTime;
+      frame->state    = STREAM_TIMED;
+      return SERD_SUCCESS;
+    }
+
+    if (stream_is_uri(predicate, USTR(LV2_ATOM__frameTime))) {
+      const int64_t frames = number_parse_integer(time_str, &end);
+      lv2_atom_forge_frame_time(forge, frames);
+      frame->seq_unit = sratom->atom_frameTime;
+      frame->state    = STREAM_TIMED;
+      return SERD_SUCCESS;
+    }
+  } else if (frame->state == STREAM_TIMED &&
+             stream_is_uri(predicate, NS_RDF "value")) {
+    frame->state = STREAM_DONE;
+    return stream_read_value(reader, flags, object, datatype, lang, MODE_BODY);
+  }
+
+  return stream_unsupported(reader);
+}
+
+static SerdStatus
+stream_list_statement(StreamReader* const      reader,
+                      const unsigned           index,
+                      const SerdStatementFlags flags,
+                      const SerdNode* const    predicate,
+                      const SerdNode* const    object,
+                      const SerdNode* const    datatype,
+                      const SerdNode* const    lang)
+{
+  StreamFrame* const frame = &reader->frames[index];
+
+  if (!frame->has_first && stream_is_uri(predicate, NS_RDF "first")) {
+    frame->has_first = true;
+    return stream_read_value(
+      reader, flags, object, datatype, lang, frame->mode);
+  }
+
+  if (frame->has_first && stream_is_uri(predicate, NS_RDF "rest")) {
+    if (stream_is_uri(object, NS_RDF "nil")) {
+      const LV2_URID seq_unit = frame->seq_unit;
+      stream_pop(reader);
+      stream_end_container(reader, &reader->frames[index - 1U], seq_unit);
+      return SERD_SUCCESS;
+    }
+
+    if (object->type == SERD_BLANK) {
+      reader->labels_len = frame->label;
+      frame->has_first   = false;
+      if (stream_push_label(reader, object, &frame->label)) {
+        return SERD_SUCCESS;
+      }
+    }
+  }
+
+  return stream_unsupported(reader);
+}
+
+/// Expand a CURIE or relative URI into a node allocated in the arena
+static const SerdNode*
+stream_expand(const StreamReader* const reader,
+              const SerdNode* const     node,
+              SerdNode* const           expanded)
+{
+  Arena* const arena = &reader->state->scratch->arena;
+
+  if (node && node->type == SERD_CURIE) {
+    SerdChunk prefix = {NULL, 0U};
+    SerdChunk suffix = {NULL, 0U};
+    if (serd_env_expand(reader->env, node, &prefix, &suffix)) {
+      return NULL;
+    }
+
+    const size_t len = prefix.len + suffix.len;
+    char* const  buf = (char*)arena_alloc(arena, len + 1U);
+    if (!buf) {
+      return NULL;
+    }
+
+    memcpy(buf, prefix.buf, prefix.len);
+    memcpy(buf + prefix.len, suffix.buf, suffix.len);
+    buf[len] = '\0';
+
+    const SerdNode uri = {USTR(buf), len, len, 0, SERD_URI};
+    *expanded          = uri;
+    return expanded;
+  }
+
+  if (node && node->type == SERD_URI &&
+      !serd_uri_string_has_scheme(node->buf)) {
+    SerdURI base = SERD_URI_NULL;
+    SerdURI ref  = SERD_URI_NULL;
+    SerdURI abs  = SERD_URI_NULL;
+    serd_env_get_base_uri(reader->env, &base);
+    serd_uri_parse(node->buf, &ref);
+    serd_uri_resolve(&ref, &base, &abs);
+
+    *expanded = uri_node(arena, &abs, NULL);
+    return expanded->buf ? expanded : NULL;
+  }
+
+  return node;
+}
+
+static SerdStatus
+stream_base(void* const handle, const SerdNode* const uri)
+{
+  return serd_env_set_base_uri(((StreamReader*)handle)->env, uri);
+}
+
+static SerdStatus
+stream_prefix(void* const           handle,
+              const SerdNode* const name,
+              const SerdNode* const uri)
+{
+  return serd_env_set_prefix(((StreamReader*)handle)->env, name, uri);
+}
+
+static SerdStatus
+stream_read_statement(StreamReader* const      reader,
+                      const SerdStatementFlags flags,
+                      const SerdNode* const    subject,
+                      const SerdNode* const    predicate,
+                      const SerdNode* const    object,
+                      const SerdNode* const    datatype,
+                      const SerdNode* const    lang)
+{
+  if (!reader->n_frames) {
+    if (!reader->predicate || !serd_node_equals(subject, reader->subject) ||
+        !serd_node_equals(predicate, reader->predicate)) {
+      return SERD_SUCCESS;
+    }
+
+    if (reader->found) {
+      return stream_unsupported(reader); // Several values
+    }
+
+    reader->found = true;
+    return stream_read_value(
+      reader, flags, object, datatype, lang, MODE_SUBJECT);
+  }
+
+  const unsigned           index = reader->n_frames - 1U;
+  const StreamFrame* const frame = &reader->frames[index];
+  if (!stream_is_label(reader, index, subject)) {
+    return (!index && reader->has_root) ? SERD_SUCCESS
+                                        : stream_unsupported(reader);
+  }
+
+  if (frame->is_list) {
+    return stream_list_statement(
+      reader, index, flags, predicate, object, datatype, lang);
+  }
+
+  if (frame->mode == MODE_SEQUENCE) {
+    return stream_event_statement(
+      reader, index, flags, predicate, object, datatype, lang);
+  }
+
+  return stream_node_statement(
+    reader, index, flags, predicate, object, datatype, lang);
+}
+
+static SerdStatus
+stream_statement(void* const              handle,
+                 const SerdStatementFlags flags,
+                 const SerdNode* const    graph,
+                 const SerdNode* const    subject,
+                 const SerdNode* const    predicate,
+                 const SerdNode* const    object,
+                 const SerdNode* const    object_datatype,
+                 const SerdNode* const    object_lang)
+{
+  (void)graph;
+
+  StreamReader* const reader = (StreamReader*)handle;
+  if (reader->unsupported) {
+    return SERD_FAILURE;
+  }
+
+  SerdNode expanded[4] = {
+    SERD_NODE_NULL, SERD_NODE_NULL, SERD_NODE_NULL, SERD_NODE_NULL};
+
+  const SerdNode* const s = stream_expand(reader, subject, &expanded[0]);
+  const SerdNode* const p = stream_expand(reader, predicate, &expanded[1]);
+  const SerdNode* const o = stream_expand(reader, object, &expanded[2]);
+  const SerdNode* const d =
+    stream_expand(reader, object_datatype, &expanded[3]);
+
+  const SerdStatus st =
+    (s && p && o && (d || !object_datatype))
+      ? stream_read_statement(reader, flags, s, p, o, d, object_lang)
+      : stream_unsupported(reader);
+
+  arena_reset(&reader->state->scratch->arena);
+  return st;
+}
+
+static SerdStatus
+stream_end_node(StreamReader* const reader, const unsigned index)
+{
+  const Sratom* const   sratom = reader->state->sratom;
+  LV2_Atom_Forge* const forge  = reader->forge;
+  StreamFrame* const    frame  = &reader->frames[index];
+
+  if (frame->is_list) {
+    return stream_unsupported(reader);
+  }
+
+  if (frame->mode == MODE_SEQUENCE) {
+    if (frame->state != STREAM_DONE) {
+      return stream_unsupported(reader);
+    }
+
+    reader->frames[index - 1U].seq_unit = frame->seq_unit;
+  } else if (frame->state == STREAM_PENDING ||
+             (frame->state == STREAM_TYPED &&
+              !stream_is_container(sratom, frame->otype))) {
+    lv2_atom_forge_object(forge, &frame->frame, frame->id, frame->otype);
+    lv2_atom_forge_pop(forge, &frame->frame);
+  } else if (frame->state == STREAM_OBJECT) {
+    lv2_atom_forge_pop(forge, &frame->frame);
+  } else if (frame->state != STREAM_DONE) {
+    return stream_unsupported(reader);
+  }
+
+  stream_pop(reader);
+  return SERD_SUCCESS;
+}
+
+static SerdStatus
+stream_end(void* const handle, const SerdNode* const node)
+{
+  StreamReader* const reader = (StreamReader*)handle;
+  if (reader->unsupported) {
+    return SERD_FAILURE;
+  }
+
+  if (!reader->n_frames) {
+    return SERD_SUCCESS;
+  }
+
+  const unsigned index = reader->n_frames - 1U;
+  if (!stream_is_label(reader, index, node)) {
+    return (!index && reader->has_root) ? SERD_SUCCESS
+                                        : stream_unsupported(reader);
+  }
+
+  return stream_end_node(reader, index);
+}
+
+static bool
+is_absolute_uri(const SerdNode* const node)
+{
+  return node->type == SERD_URI && serd_uri_string_has_scheme(node->buf);
+}
+
+/// Size of the pages that Turtle files are read in
+#define READ_PAGE_SIZE 65536U
+
+/// A Turtle document to read from a string or a file
+typedef struct {
+  const char* str;     ///< Document text, or null to read file
+  FILE*       file;    ///< File to read from the start if str is null
+  const char* name;    ///< Name of file for error messages
+  size_t      n_bytes; ///< Number of bytes read from file
+} TurtleSource;
+
+static size_t
+source_read(void* const  buf,
+            const size_t size,
+            const size_t nmemb,
+            void* const  stream)
+{
+  TurtleSource* const source = (TurtleSource*)stream;
+  const size_t        n      = fread(buf, size, nmemb, source->file);
+
+  source->n_bytes += n * size;
+  return n;
+}
+
+static int
+source_error(void* const stream)
+{
+  return ferror(((const TurtleSource*)stream)->file);
+}
+
+/// Parse a whole document from a source
+static SerdStatus
+read_source(SerdReader* const reader, TurtleSource* const source)
+{
+  if (source->str) {
+    return serd_reader_read_string(reader, USTR(source->str));
+  }
+
+  if (fseek(source->file, 0, SEEK_SET)) {
+    return SERD_ERR_UNKNOWN;
+  }
+
+  return serd_reader_read_source(reader,
+                                 source_read,
+                                 source_error,
+                                 source,
+                                 USTR(source->name),
+                                 READ_PAGE_SIZE);
+}
+
+struct SratomReaderImpl {
+  Sratom*        sratom;
+  LV2_Atom_Forge forge;         ///< Forge for atoms read by this reader
+  SerdEnv*       env;           ///< Copy of the serializer environment
+  StreamReader   stream;        ///< State of the single-pass reader
+  SerdReader*    stream_reader; ///< Parser for the single-pass reader
+  SordWorld*     world;         ///< World for the model, created on demand
+  VocabNodes     nodes;         ///< Vocabulary nodes interned in world
+  SordModel*     model;         ///< Model for documents that can't be streamed
+  SerdReader*    model_reader;  ///< Parser that loads the model
+  size_t         size_hint;     ///< Size of the last atom read
+};
+
+static SerdReader*
+new_stream_reader(SratomReader* const reader)
+{
+  return serd_reader_new(SERD_TURTLE,
+                         &reader->stream,
+                         NULL,
+                         stream_base,
+                         stream_prefix,
+                         stream_statement,
+                         stream_end);
+}
+
+static SerdStatus
+copy_prefix(void* const           handle,
+            const SerdNode* const name,
+            const SerdNode* const uri)
+{
+  return serd_env_set_prefix((SerdEnv*)handle, name, uri);
+}
+
+/// Create a reader with a copy of the environment of `sratom`
+static SratomReader*
+new_reader(Sratom* const sratom)
+{
+  SratomReader* const reader = (SratomReader*)calloc(1, sizeof(SratomReader));
+  if (!reader) {
+    return NULL;
+  }
+
+  reader->sratom = sratom;
+  reader->forge  = sratom->forge;
+
+  // Documents may define prefixes, which mustn't be added to the original
+  reader->env = serd_env_new(NULL);
+  if (reader->env && sratom->env) {
+    serd_env_foreach(sratom->env, copy_prefix, reader->env);
+  }
+
+  reader->stream.forge  = &reader->forge;
+  reader->stream.env    = reader->env;
+  reader->stream_reader = new_stream_reader(reader);
+  if (!reader->env || !reader->stream_reader) {
+    sratom_reader_free(reader);
+    return NULL;
+  }
+
+  return reader;
+}
+
+SratomReader*
+sratom_reader_new(Sratom* const sratom)
+{
+  return new_reader(sratom);
+}
+
+void
+sratom_reader_free(SratomReader* const reader)
+{
+  if (!reader) {
+    return;
+  }
+
+  if (reader->world) {
+    serd_reader_free(reader->model_reader);
+    sord_free(reader->model);
+    free_vocab_nodes(&reader->nodes, reader->world);
+    sord_world_free(reader->world);
+  }
+
+  serd_reader_free(reader->stream_reader);
+  free(reader->stream.labels);
+  free(reader->stream.frames);
+  serd_env_free(reader->env);
+
+  free(reader);
+}
+
+/**
+   Read an atom from a Turtle document without building a model.
+
+   @param unsupported Set to true if the document can not be read this way,
+   in which case the model must be used instead.
+   @return True if the document was read successfully.
+*/
+static bool
+stream_from_turtle(SratomReader* const   self,
+                   const SerdNode* const subject,
+                   const SerdNode* const predicate,
+                   TurtleSource* const   source,
+                   bool* const           unsupported)
+{
+  if (!subject || !subject->buf ||
+      !(subject->type == SERD_BLANK || is_absolute_uri(subject)) ||
+      (predicate && (!predicate->buf || !is_absolute_uri(predicate)))) {
+    *unsupported = true;
+    return false;
+  }
+
+  StreamReader* const reader = &self->stream;
+  const Sratom* const sratom = reader->state->sratom;
+
+  reader->subject     = subject;
+  reader->predicate   = predicate;
+  reader->n_frames    = 0U;
+  reader->labels_len  = 0U;
+  reader->has_root    = false;
+  reader->found       = false;
+  reader->unsupported = false;
+
+  if (predicate) {
+    // The root is the object of a statement, found while reading
+  } else if (subject->type == SERD_URI &&
+             sratom->object_mode != SRATOM_OBJECT_MODE_BLANK_SUBJECT) {
+    if (read_unmapped_uri(
+          reader->state, reader->forge, (const char*)subject->buf) ==
+        SERD_FAILURE) {
+      lv2_atom_forge_urid(reader->forge, stream_map(reader, subject));
+    }
+
+    reader->found = true;
+  } else {
+    // The root is described by top-level statements about the subject
+    StreamFrame* const root = stream_push(reader, subject, MODE_SUBJECT, false);
+    if (root && subject->type == SERD_URI) {
+      root->id = stream_map(reader, subject);
+    }
+
+    reader->has_root    = true;
+    reader->found       = true;
+    reader->unsupported = !root;
+  }
+
+  const SerdStatus st = read_source(self->stream_reader, source);
+  if (!reader->unsupported && !st && reader->has_root &&
+      reader->n_frames == 1U) {
+    stream_end_node(reader, 0U);
+  }
+
+  *unsupported = reader->unsupported || (!st && reader->n_frames);
+  if (st && !*unsupported) {
+    fprintf(stderr, "Failed to read Turtle\n");
+  } else if (!*unsupported && !reader->found) {
+    fprintf(stderr, "Failed to find node\n");
+  }
+
+  if (st) {
+    // Replace the parser rather than rely on it recovering from an error
+    serd_reader_free(self->stream_reader);
+    self->stream_reader = new_stream_reader(self);
+  }
+
+  return !st && !*unsupported;
+}
+
+/// Remove every statement from the model, keeping the world and its nodes
+static void
+clear_model(SordModel* const model)
+{
+  SordIter* const i = sord_begin(model);
+  while (!sord_iter_end(i)) {
+    sord_erase(model, i);
+  }
+
+  sord_iter_free(i);
+}
+
+/// Read an atom from a Turtle document by loading it into a model
+static bool
+model_from_turtle(SratomReader* const   self,
+                  const SerdNode* const subject,
+                  const SerdNode* const predicate,
+                  TurtleSource* const   source)
+{
+  if (!self->world) {
+    self->world = sord_world_new();
+    if (self->world) {
+      new_vocab_nodes(&self->nodes, self->world);
+      self->model = sord_new(self->world, SORD_SPO, false);
+    }
+  }
+
+  if (self->model && !self->model_reader) {
+    self->model_reader =
+      sord_new_reader(self->model, self->env, SERD_TURTLE, NULL);
+  }
+
+  if (!self->model_reader) {
+    return false;
+  }
+
+  SordWorld* const world = self->world;
+  SordModel* const model = self->model;
+  SerdEnv* const   env   = self->env;
+
+  SerdStatus st = read_source(self->model_reader, source);
+  if (!st) {
+    SordNode* s = sord_node_from_serd_node(world, env, subject, 0, 0);
     if (subject && predicate) {
-      const SordNode* p = sord_node_from_serd_node(world, env, predicate, 0, 0);
-      SordNode*       o = sord_get(model, s, p, NULL, NULL);
+      SordNode* p = sord_node_from_serd_node(world, env, predicate, 0, 0);
+      SordNode* o = sord_get(model, s, p, NULL, NULL);
       if (o) {
-        sratom_read(sratom, &sratom->forge, world, model, o);
+        st = read_model(self->stream.state, &self->forge, world, model, o);
         sord_node_free(world, o);
       } else {
         fprintf(stderr, "Failed to find node\n");
       }
+
+      sord_node_free(world, p);
     } else {
-      sratom_read(sratom, &sratom->forge, world, model, s);
+      st = read_model(self->stream.state, &self->forge, world, model, s);
     }
+
+    sord_node_free(world, s);
   } else {
     fprintf(stderr, "Failed to read Turtle\n");
+    serd_reader_free(self->model_reader);
+    self->model_reader = NULL;
   }
 
-  serd_reader_free(reader);
-  if (!sratom->env) {
-    serd_env_free(env);
+  clear_model(model);
+  return !st;
+}
+
+/// Read an atom from a Turtle document with a reader
+static LV2_Atom*
+read_document(SratomReader* const   reader,
+              const char* const     base_uri,
+              const SerdNode* const subject,
+              const SerdNode* const predicate,
+              TurtleSource* const   source)
+{
+  Sratom* const sratom = reader->sratom;
+
+  SerdURI  base      = SERD_URI_NULL;
+  SerdNode base_node = serd_node_new_uri_from_string(
+    USTR(base_uri), sratom->base_uri.buf ? &sratom->base : NULL, &base);
+
+  serd_env_set_base_uri(reader->env, &base_node);
+
+  Scratch   local;
+  ReadState state = {
+    sratom, claim_scratch(sratom, &local), &reader->nodes, &base, NULL, 0U};
+
+  SratomForgeBuffer out;
+  sratom_forge_buffer_init(&out, reader->size_hint);
+  lv2_atom_forge_set_sink(
+    &reader->forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &out);
+
+  reader->stream.state = &state;
+
+  bool unsupported = false;
+  bool success =
+    stream_from_turtle(reader, subject, predicate, source, &unsupported);
+
+  if (unsupported) {
+    sratom_forge_buffer_clear(&out);
+    success = model_from_turtle(reader, subject, predicate, source);
   }
 
-  sord_free(model);
-  sord_world_free(world);
-  serd_node_free(&base);
+  reader->stream.state = NULL;
+  release_scratch(sratom, state.scratch);
+  serd_node_free(&base_node);
+
+  if (!success || !out.len) {
+    sratom_forge_buffer_cleanup(&out);
+  } else {
+    reader->size_hint = out.len;
+  }
 
   return (LV2_Atom*)out.buf;
 }
+
+LV2_Atom*
+sratom_reader_read_string(SratomReader* const   reader,
+                          const char* const     base_uri,
+                          const SerdNode* const subject,
+                          const SerdNode* const predicate,
+                          const char* const     str)
+{
+  TurtleSource source = {str, NULL, NULL, 0U};
+  return read_document(reader, base_uri, subject, predicate, &source);
+}
+
+/// Read an atom from a document with a new reader that doesn't modify sratom
+static LV2_Atom*
+read_new_document(Sratom* const         sratom,
+                  const char* const     base_uri,
+                  const SerdNode* const subject,
+                  const SerdNode* const predicate,
+                  TurtleSource* const   source)
+{
+  SratomReader* const reader = new_reader(sratom);
+  if (!reader) {
+    return NULL;
+  }
+
+  LV2_Atom* const atom =
+    read_document(reader, base_uri, subject, predicate, source);
+
+  sratom_reader_free(reader);
+  return atom;
+}
+
+LV2_Atom*
+sratom_from_turtle(Sratom*         sratom,
+                   const char*     base_uri,
+                   const SerdNode* subject,
+                   const SerdNode* predicate,
+                   const char*     str)
+{
+  TurtleSource source = {str, NULL, NULL, 0U};
+  return read_new_document(sratom, base_uri, subject, predicate, &source);
+}
+
+LV2_Atom*
+sratom_from_turtle_file(Sratom*          sratom,
+                        const char*      base_uri,
+                        const SerdNode*  subject,
+                        const SerdNode*  predicate,
+                        const char*      path,
+                        SratomReadStats* stats)
+{
+  const double start  = clock_now();
+  LV2_Atom*    atom   = NULL;
+  TurtleSource source = {NULL, fopen(path, "rb"), path, 0U};
+  if (source.file) {
+    atom = read_new_document(sratom, base_uri, subject, predicate, &source);
+    fclose(source.file);
+  } else {
+    fprintf(stderr, "Failed to open %s\n", path);
+  }
+
+  if (stats) {
+    stats->n_bytes = source.n_bytes;
+    stats->seconds = clock_now() - start;
+  }
+
+  return atom;
+}
+
+/// Return the URIDs of the types that contain URIDs for archives
+static ArchiveTypes
+archive_types(const Sratom* const sratom)
+{
+  const LV2_Atom_Forge* const forge = &sratom->forge;
+  const ArchiveTypes          types = {forge->Blank,
+                                       forge->Literal,
+                                       forge->Object,
+                                       forge->Resource,
+                                       forge->Sequence,
+                                       forge->Tuple,
+                                       forge->URID,
+                                       forge->Vector};
+  return types;
+}
+
+void*
+sratom_to_archive(Sratom*         sratom,
+                  LV2_URID_Unmap* unmap,
+                  const LV2_Atom* atom,
+                  size_t*         size)
+{
+  const ArchiveTypes types   = archive_types(sratom);
+  void* const        archive = archive_write(&types, unmap, atom, size);
+  if (!archive) {
+    *size = 0U;
+  }
+
+  return archive;
+}
+
+LV2_Atom*
+sratom_from_archive(Sratom* sratom, void* archive, size_t size)
+{
+  const ArchiveTypes types = archive_types(sratom);
+  return archive_load(&types, sratom->map, archive, size);
+}
+
+void*
+sratom_turtle_to_archive(Sratom*         sratom,
+                         LV2_URID_Unmap* unmap,
+                         const char*     base_uri,
+                         const SerdNode* subject,
+                         const SerdNode* predicate,
+                         const char*     str,
+                         size_t*         size)
+{
+  LV2_Atom* const atom =
+    sratom_from_turtle(sratom, base_uri, subject, predicate, str);
+  if (!atom) {
+    *size = 0U;
+    return NULL;
+  }
+
+  void* const archive = sratom_to_archive(sratom, unmap, atom, size);
+  free(atom);
+  return archive;
+}
+
+char*
+sratom_archive_to_turtle(Sratom*         sratom,
+                         LV2_URID_Unmap* unmap,
+                         const char*     base_uri,
+                         const SerdNode* subject,
+                         const SerdNode* predicate,
+                         const void*     archive,
+                         size_t          size)
+{
+  // Load a copy, since loading modifies the archive
+  void* const copy = malloc(size);
+  if (!copy) {
+    return NULL;
+  }
+
+  memcpy(copy, archive, size);
+
+  char*                 str  = NULL;
+  const LV2_Atom* const atom = sratom_from_archive(sratom, copy, size);
+  if (atom) {
+    str = sratom_to_turtle(sratom,
+                           unmap,
+                           base_uri,
+                           subject,
+                           predicate,
+                           atom->type,
+                           atom->size,
+                           LV2_ATOM_BODY_CONST(atom));
+  }
+
+  free(copy);
+  return str;
+}
+
+static DeltaUris
+delta_uris(const Sratom* const sratom)
+{
+  LV2_URID_Map* const map  = sratom->map;
+  const DeltaUris     uris = {map->map(map->handle, LV2_PATCH__Patch),
+                              map->map(map->handle, LV2_PATCH__add),
+                              map->map(map->handle, LV2_PATCH__remove),
+                              map->map(map->handle, LV2_PATCH__subject),
+                              map->map(map->handle, LV2_PATCH__wildcard)};
+  return uris;
+}
+
+LV2_Atom_Forge_Ref
+sratom_forge_delta(Sratom*                sratom,
+                   LV2_Atom_Forge*        forge,
+                   const LV2_Atom_Object* old_object,
+                   const LV2_Atom_Object* new_object)
+{
+  const DeltaUris uris = delta_uris(sratom);
+  return delta_forge(forge, &uris, old_object, new_object);
+}
+
+int
+sratom_write_delta(Sratom*                sratom,
+                   LV2_URID_Unmap*        unmap,
+                   uint32_t               flags,
+                   const SerdNode*        subject,
+                   const SerdNode*        predicate,
+                   const LV2_Atom_Object* old_object,
+                   const LV2_Atom_Object* new_object)
+{
+  SratomForgeBuffer buffer;
+  if (sratom_forge_buffer_init(&buffer, 256U)) {
+    return SERD_ERR_INTERNAL;
+  }
+
+  LV2_Atom_Forge forge = sratom->forge;
+  lv2_atom_forge_set_sink(
+    &forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &buffer);
+
+  int st = SERD_ERR_INTERNAL;
+  if (sratom_forge_delta(sratom, &forge, old_object, new_object)) {
+    const LV2_Atom* const patch = (const LV2_Atom*)buffer.buf;
+
+    st = sratom_write(sratom,
+                      unmap,
+                      flags,
+                      subject,
+                      predicate,
+                      patch->type,
+                      patch->size,
+                      LV2_ATOM_BODY_CONST(patch));
+  }
+
+  sratom_forge_buffer_cleanup(&buffer);
+  return st;
+}
+
+LV2_Atom_Forge_Ref
+sratom_apply_delta(Sratom*                sratom,
+                   LV2_Atom_Forge*        forge,
+                   const LV2_Atom_Object* object,
+                   const LV2_Atom_Object* delta)
+{
+  const DeltaUris uris = delta_uris(sratom);
+  return delta_apply(forge, &uris, object, delta);
+}
@@ -0,0 +1,146 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "thread.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+
+#  include <windows.h>
+
+static DWORD WINAPI
+thread_main(LPVOID arg)
+{
+  Thread* const thread = (Thread*)arg;
+  thread->func(thread->arg);
+  return 0U;
+}
+
+bool
+thread_start(Thread* const thread, const ThreadFunc func, void* const arg)
+{
+  thread->func   = func;
+  thread->arg    = arg;
+  thread->handle = CreateThread(NULL, 0U, thread_main, thread, 0U, NULL);
+  return thread->handle != NULL;
+}
+
+void
+thread_join(Thread* const thread)
+{
+  WaitForSingleObject(thread->handle, INFINITE);
+  CloseHandle(thread->handle);
+}
+
+bool
+mutex_init(Mutex* const mutex)
+{
+  InitializeSRWLock((PSRWLOCK)&mutex->lock);
+  return true;
+}
+
+void
+mutex_destroy(Mutex* const mutex)
+{
+  (void)mutex;
+}
+
+void
+mutex_lock(Mutex* const mutex)
+{
+  AcquireSRWLockExclusive((PSRWLOCK)&mutex->lock);
+}
+
+void
+mutex_unlock(Mutex* const mutex)
+{
+  ReleaseSRWLockExclusive((PSRWLOCK)&mutex->lock);
+}
+
+#else
+
+static void*
+thread_main(void* const arg)
+{
+  Thread* const thread = (Thread*)arg;
+  thread->func(thread->arg);
+  return NULL;
+}
+
+bool
+thread_start(Thread* const thread, const ThreadFunc func, void* const arg)
+{
+  thread->func = func;
+  thread->arg  = arg;
+  return !pthread_create(&thread->handle, NULL, thread_main, thread);
+}
+
+void
+thread_join(Thread* const thread)
+{
+  pthread_join(thread->handle, NULL);
+}
+
+bool
+mutex_init(Mutex* const mutex)
+{
+  return !pthread_mutex_init(&mutex->lock, NULL);
+}
+
+void
+mutex_destroy(Mutex* const mutex)
+{
+  pthread_mutex_destroy(&mutex->lock);
+}
+
+void
+mutex_lock(Mutex* const mutex)
+{
+  pthread_mutex_lock(&mutex->lock);
+}
+
+void
+mutex_unlock(Mutex* const mutex)
+{
+  pthread_mutex_unlock(&mutex->lock);
+}
+
+#endif
+
+void
+thread_run_parallel(const ThreadFunc func,
+                    void* const      args,
+                    const size_t     arg_size,
+                    const size_t     n_args)
+{
+  Thread* const threads =
+    n_args > 1U ? (Thread*)calloc(n_args - 1U, sizeof(Thread)) : NULL;
+
+  // Start a thread for every argument but the first
+  for (size_t i = 1U; threads && i < n_args; ++i) {
+    void* const arg = (uint8_t*)args + (i * arg_size);
+    if (!thread_start(&threads[i - 1U], func, arg)) {
+      threads[i - 1U].func = NULL; // Mark as not started
+    }
+  }
+
+  // Make the calls that aren't running on another thread
+  for (size_t i = 0U; i < n_args; ++i) {
+    if (!i || !threads || !threads[i - 1U].func) {
+      func((uint8_t*)args + (i * arg_size));
+    }
+  }
+
+  // Wait for the other threads to finish
+  for (size_t i = 1U; threads && i < n_args; ++i) {
+    if (threads[i - 1U].func) {
+      thread_join(&threads[i - 1U]);
+    }
+  }
+
+  free(threads);
+}
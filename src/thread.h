@@ -0,0 +1,85 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_THREAD_H
+#define SRATOM_SRC_THREAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef _WIN32
+#  include <pthread.h>
+#endif
+
+/// A function run by a thread
+typedef void (*ThreadFunc)(void* arg);
+
+/// A thread that runs a function and can be joined
+typedef struct {
+  ThreadFunc func; ///< Function to run
+  void*      arg;  ///< Argument for func
+#ifdef _WIN32
+  void* handle; ///< Win32 thread handle
+#else
+  pthread_t handle; ///< POSIX thread handle
+#endif
+} Thread;
+
+/**
+   Start a thread that calls `func` with `arg`.
+
+   The thread struct must not move until the thread is joined.
+
+   @return True on success, or false if the thread couldn't be created.
+*/
+bool
+thread_start(Thread* thread, ThreadFunc func, void* arg);
+
+/// Wait for a thread started with thread_start() to finish
+void
+thread_join(Thread* thread);
+
+/**
+   Call a function with each of several arguments in parallel.
+
+   Each call is made on its own thread, except the first, which is made on
+   the calling thread, as are any that a thread can't be started for.  This
+   returns when every call has returned.
+
+   @param func Function to call.
+   @param args Array of arguments to pass to func.
+   @param arg_size Size of each element of args in bytes.
+   @param n_args Number of elements in args.
+*/
+void
+thread_run_parallel(ThreadFunc func,
+                    void*      args,
+                    size_t     arg_size,
+                    size_t     n_args);
+
+/// A mutual exclusion lock
+typedef struct {
+#ifdef _WIN32
+  void* lock; ///< Win32 SRWLOCK
+#else
+  pthread_mutex_t lock; ///< POSIX mutex
+#endif
+} Mutex;
+
+/// Initialise a mutex, returning true on success
+bool
+mutex_init(Mutex* mutex);
+
+/// Free the resources used by a mutex, which must be unlocked
+void
+mutex_destroy(Mutex* mutex);
+
+/// Lock a mutex, waiting until it is available
+void
+mutex_lock(Mutex* mutex);
+
+/// Unlock a mutex locked by the calling thread
+void
+mutex_unlock(Mutex* mutex);
+
+#endif /* SRATOM_SRC_THREAD_H */
@@ -0,0 +1,893 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "turtle.h"
+
+#include "base64.h"
+
+#include <serd/serd.h>
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_RDF "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+#define NS_XSD "http://www.w3.org/2001/XMLSchema#"
+
+#define NS_XSD_LEN (sizeof(NS_XSD) - 1U)
+
+/// Size of the output buffer when writing to a sink
+#define SINK_BLOCK_SIZE 4096U
+
+/// Bytes to write as the base64 text of a literal object
+typedef struct {
+  const uint8_t* buf;  ///< Bytes to encode
+  size_t         size; ///< Size of buf in bytes
+} Binary;
+
+/// Write the output buffer to the sink and empty it
+static void
+flush(TurtleWriter* const writer)
+{
+  if (writer->out.len && !writer->failed &&
+      writer->sink(writer->out.buf, writer->out.len, writer->stream) !=
+        writer->out.len) {
+    writer->failed = true;
+  }
+
+  writer->out.len = 0U;
+}
+
+static bool
+reserve(TurtleWriter* const writer, TextBuffer* const buf, const size_t len)
+{
+  if (buf == &writer->out && writer->sink && buf->len + len > buf->cap) {
+    flush(writer);
+  }
+
+  if (buf->len + len > buf->cap) {
+    size_t new_cap = buf->cap ? buf->cap : 256U;
+    while (new_cap < buf->len + len) {
+      new_cap *= 2U;
+    }
+
+    char* const new_buf = (char*)realloc(buf->buf, new_cap);
+    if (!new_buf) {
+      writer->failed = true;
+      return false;
+    }
+
+    buf->buf = new_buf;
+    buf->cap = new_cap;
+  }
+
+  return true;
+}
+
+static void
+append(TurtleWriter* const writer, const void* const str, const size_t len)
+{
+  if (writer->sink && len > writer->out.cap) {
+    // Write large strings directly rather than copying them in pieces
+    flush(writer);
+    if (!writer->failed && writer->sink(str, len, writer->stream) != len) {
+      writer->failed = true;
+    }
+  } else if (len && reserve(writer, &writer->out, len)) {
+    memcpy(writer->out.buf + writer->out.len, str, len);
+    writer->out.len += len;
+  }
+}
+
+static void
+append_char(TurtleWriter* const writer, const char c)
+{
+  if (reserve(writer, &writer->out, 1U)) {
+    writer->out.buf[writer->out.len++] = c;
+  }
+}
+
+static void
+set_text(TurtleWriter* const writer,
+         TextBuffer* const   buf,
+         const uint8_t*      str,
+         const size_t        len)
+{
+  buf->len = 0U;
+  if (reserve(writer, buf, len)) {
+    memcpy(buf->buf, str, len);
+    buf->len = len;
+  }
+}
+
+static bool
+text_equals(const TextBuffer* const buf, const SerdNode* const node)
+{
+  return buf->len == node->n_bytes && !memcmp(buf->buf, node->buf, buf->len);
+}
+
+static bool
+node_equals(const SerdNode* const node, const char* const str)
+{
+  return node->n_bytes == strlen(str) && !memcmp(node->buf, str, node->n_bytes);
+}
+
+static void
+write_newline(TurtleWriter* const writer, const unsigned indent)
+{
+  if (reserve(writer, &writer->out, 1U + indent)) {
+    char* const s = writer->out.buf + writer->out.len;
+    s[0]          = '\n';
+    memset(s + 1, '\t', indent);
+    writer->out.len += 1U + indent;
+  }
+}
+
+static void
+write_escape(TurtleWriter* const writer, const uint8_t c)
+{
+  char escape[8] = {0};
+  snprintf(escape, sizeof(escape), "\\u%04X", (unsigned)c);
+  append(writer, escape, 6U);
+}
+
+static bool
+uri_must_escape(const uint8_t c)
+{
+  switch (c) {
+  case ' ':
+  case '"':
+  case '<':
+  case '>':
+  case '\\':
+  case '^':
+  case '`':
+  case '{':
+  case '|':
+  case '}':
+    return true;
+  default:
+    return c < 0x20U || c == 0x7FU;
+  }
+}
+
+static void
+write_uri_text(TurtleWriter* const  writer,
+               const uint8_t* const utf8,
+               const size_t         n_bytes)
+{
+  size_t i = 0U;
+  while (i < n_bytes) {
+    size_t j = i;
+    while (j < n_bytes && !uri_must_escape(utf8[j])) {
+      ++j;
+    }
+
+    append(writer, utf8 + i, j - i);
+    if ((i = j) < n_bytes) {
+      write_escape(writer, utf8[i++]);
+    }
+  }
+}
+
+static bool
+is_string_char(const uint8_t c)
+{
+  return c >= 0x80U || (c >= 0x20U && c < 0x7FU && c != '\\' && c != '"');
+}
+
+static void
+write_string_text(TurtleWriter* const  writer,
+                  const uint8_t* const utf8,
+                  const size_t         n_bytes)
+{
+  size_t i = 0U;
+  while (i < n_bytes) {
+    size_t j = i;
+    while (j < n_bytes && is_string_char(utf8[j])) {
+      ++j;
+    }
+
+    append(writer, utf8 + i, j - i);
+    if ((i = j) == n_bytes) {
+      break;
+    }
+
+    const uint8_t c = utf8[i++];
+    switch (c) {
+    case '\\':
+      append(writer, "\\\\", 2U);
+      break;
+    case '\n':
+      append(writer, "\\n", 2U);
+      break;
+    case '\r':
+      append(writer, "\\r", 2U);
+      break;
+    case '\t':
+      append(writer, "\\t", 2U);
+      break;
+    case '"':
+      append(writer, "\\\"", 2U);
+      break;
+    case '\b':
+      append(writer, "\\b", 2U);
+      break;
+    case '\f':
+      append(writer, "\\f", 2U);
+      break;
+    default:
+      write_escape(writer, c);
+      break;
+    }
+  }
+}
+
+static void
+write_long_string_text(TurtleWriter* const  writer,
+                       const uint8_t* const utf8,
+                       const size_t         n_bytes)
+{
+  size_t i = 0U;
+  while (i < n_bytes) {
+    size_t j = i;
+    while (j < n_bytes && is_string_char(utf8[j])) {
+      ++j;
+    }
+
+    append(writer, utf8 + i, j - i);
+    if ((i = j) == n_bytes) {
+      break;
+    }
+
+    const uint8_t c = utf8[i++];
+    switch (c) {
+    case '\\':
+      append(writer, "\\\\", 2U);
+      break;
+    case '\b':
+      append(writer, "\\b", 2U);
+      break;
+    case '\n':
+    case '\r':
+    case '\t':
+    case '\f':
+      append_char(writer, (char)c);
+      break;
+    case '"':
+      // Escape quotes that would otherwise end the string
+      if (i == n_bytes || (i + 1U < n_bytes && utf8[i] == '"' &&
+                           utf8[i + 1U] == '"')) {
+        append(writer, "\\\"", 2U);
+      } else {
+        append_char(writer, '"');
+      }
+      break;
+    default:
+      write_escape(writer, c);
+      break;
+    }
+  }
+}
+
+static bool
+is_name(const uint8_t* const buf, const size_t len)
+{
+  for (size_t i = 0U; i < len; ++i) {
+    const uint8_t c = buf[i];
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+          (c >= '0' && c <= '9'))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool
+has_scheme(const uint8_t* const uri)
+{
+  const uint8_t c = uri[0];
+  if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))) {
+    return false;
+  }
+
+  for (const uint8_t* s = uri + 1; *s; ++s) {
+    if (*s == ':') {
+      return true;
+    }
+
+    if (!((*s >= 'a' && *s <= 'z') || (*s >= 'A' && *s <= 'Z') ||
+          (*s >= '0' && *s <= '9') || *s == '+' || *s == '-' || *s == '.')) {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+/// Return true if the output syntax has abbreviations for terms
+static bool
+is_terse(const TurtleWriter* const writer)
+{
+  return writer->syntax == SERD_TURTLE || writer->syntax == SERD_TRIG;
+}
+
+/**
+   Return the part of a URI relative to the base directory, or null.
+
+   This is only the case for URIs that simply extend the base directory, and
+   aren't a relative reference that would mean something else, like one that
+   starts with a query or looks like a URI with a scheme.
+*/
+static const uint8_t*
+relative_suffix(const TurtleWriter* const writer, const SerdNode* const node)
+{
+  const TextBuffer* const base = &writer->base;
+  if (!base->len || node->n_bytes <= base->len ||
+      !!memcmp(node->buf, base->buf, base->len)) {
+    return NULL;
+  }
+
+  const uint8_t* const suffix = node->buf + base->len;
+  const size_t         n      = strcspn((const char*)suffix, "/?#");
+  return (n && !memchr(suffix, ':', n)) ? suffix : NULL;
+}
+
+static void
+write_uri(TurtleWriter* const   writer,
+          const SerdNode* const node,
+          const bool            is_predicate)
+{
+  const bool terse = is_terse(writer);
+
+  if (terse && is_predicate && node_equals(node, NS_RDF "type")) {
+    append_char(writer, 'a');
+    return;
+  }
+
+  if (terse && node_equals(node, NS_RDF "nil")) {
+    append(writer, "()", 2U);
+    return;
+  }
+
+  SerdNode  prefix = SERD_NODE_NULL;
+  SerdChunk suffix = {NULL, 0U};
+  if (terse && (writer->style & SERD_STYLE_CURIED) && writer->env &&
+      has_scheme(node->buf) &&
+      serd_env_qualify(writer->env, node, &prefix, &suffix) &&
+      is_name(suffix.buf, suffix.len)) {
+    write_uri_text(writer, prefix.buf, prefix.n_bytes);
+    append_char(writer, ':');
+    write_uri_text(writer, suffix.buf, suffix.len);
+    return;
+  }
+
+  const uint8_t* const relative =
+    (terse && (writer->style & SERD_STYLE_RESOLVED))
+      ? relative_suffix(writer, node)
+      : NULL;
+
+  append_char(writer, '<');
+  if (relative) {
+    write_uri_text(writer, relative, node->n_bytes - writer->base.len);
+  } else {
+    write_uri_text(writer, node->buf, node->n_bytes);
+  }
+  append_char(writer, '>');
+}
+
+static bool
+is_bare_literal(const SerdNode* const node, const SerdNode* const datatype)
+{
+  if (!datatype || !datatype->buf || datatype->n_bytes <= NS_XSD_LEN ||
+      !!strncmp((const char*)datatype->buf, NS_XSD, NS_XSD_LEN)) {
+    return false;
+  }
+
+  const char* const name = (const char*)datatype->buf + NS_XSD_LEN;
+  if (!strcmp(name, "boolean") || !strcmp(name, "integer")) {
+    return true;
+  }
+
+  // Doubles in scientific notation like "1.5E-7" can be written bare
+  if (!strcmp(name, "double")) {
+    return strchr((const char*)node->buf, '.') &&
+           strchr((const char*)node->buf, 'E') &&
+           isdigit((int)node->buf[node->n_bytes - 1U]);
+  }
+
+  // Decimals without trailing digits, like "5.", can't be written bare
+  return !strcmp(name, "decimal") && node->n_bytes &&
+         strchr((const char*)node->buf, '.') &&
+         node->buf[node->n_bytes - 1U] != '.';
+}
+
+/// Write the base64 encoding of a binary object a line at a time
+static void
+write_base64_text(TurtleWriter* const writer,
+                  const Binary* const binary,
+                  const bool          long_string)
+{
+  const uint8_t* const body = binary->buf;
+  const size_t         size = binary->size;
+
+  for (size_t i = 0U; i < size; i += BASE64_LINE_BYTES) {
+    const size_t n   = (size - i < BASE64_LINE_BYTES) ? size - i
+                                                      : BASE64_LINE_BYTES;
+    const size_t len = base64_encoded_length(n, false);
+
+    if (i && long_string) {
+      append_char(writer, '\n');
+    } else if (i) {
+      append(writer, "\\n", 2U);
+    }
+
+    if (reserve(writer, &writer->out, len)) {
+      base64_encode(writer->out.buf + writer->out.len, body + i, n, false);
+      writer->out.len += len;
+    }
+  }
+}
+
+static void
+write_literal(TurtleWriter* const   writer,
+              const SerdNode* const node,
+              const SerdNode* const datatype,
+              const SerdNode* const lang,
+              const Binary* const   binary)
+{
+  const bool terse = is_terse(writer);
+
+  if (terse && is_bare_literal(node, datatype)) {
+    append(writer, node->buf, node->n_bytes);
+    return;
+  }
+
+  if (terse && (node->flags & (SERD_HAS_NEWLINE | SERD_HAS_QUOTE))) {
+    append(writer, "\"\"\"", 3U);
+    if (binary) {
+      write_base64_text(writer, binary, true);
+    } else {
+      write_long_string_text(writer, node->buf, node->n_bytes);
+    }
+    append(writer, "\"\"\"", 3U);
+  } else {
+    append_char(writer, '"');
+    if (binary) {
+      write_base64_text(writer, binary, false);
+    } else {
+      write_string_text(writer, node->buf, node->n_bytes);
+    }
+    append_char(writer, '"');
+  }
+
+  if (lang && lang->buf) {
+    append_char(writer, '@');
+    append(writer, lang->buf, lang->n_bytes);
+  } else if (datatype && datatype->buf) {
+    append(writer, "^^", 2U);
+    write_uri(writer, datatype, false);
+  }
+}
+
+static TurtleFrame*
+push_frame(TurtleWriter* const writer, const bool is_list)
+{
+  if (writer->n_frames == writer->frames_cap) {
+    const unsigned new_cap = writer->frames_cap ? writer->frames_cap * 2U : 8U;
+
+    TurtleFrame* const new_frames =
+      (TurtleFrame*)realloc(writer->frames, new_cap * sizeof(TurtleFrame));
+    if (!new_frames) {
+      writer->failed = true;
+      return NULL;
+    }
+
+    memset(new_frames + writer->frames_cap,
+           0,
+           (new_cap - writer->frames_cap) * sizeof(TurtleFrame));
+
+    writer->frames     = new_frames;
+    writer->frames_cap = new_cap;
+  }
+
+  TurtleFrame* const frame = &writer->frames[writer->n_frames++];
+  frame->predicate.len     = 0U;
+  frame->has_predicate     = false;
+  frame->is_list           = is_list;
+  return frame;
+}
+
+static void
+write_object(TurtleWriter* const      writer,
+             const SerdStatementFlags flags,
+             const SerdNode* const    object,
+             const SerdNode* const    datatype,
+             const SerdNode* const    lang,
+             const Binary* const      binary)
+{
+  switch (object->type) {
+  case SERD_LITERAL:
+    write_literal(writer, object, datatype, lang, binary);
+    break;
+  case SERD_URI:
+    write_uri(writer, object, false);
+    break;
+  case SERD_BLANK:
+    if (flags & SERD_ANON_O_BEGIN) {
+      append_char(writer, '[');
+      push_frame(writer, false);
+    } else if (flags & SERD_LIST_O_BEGIN) {
+      append_char(writer, '(');
+      push_frame(writer, true);
+    } else if (flags & SERD_EMPTY_O) {
+      append(writer, "[]", 2U);
+    } else {
+      append(writer, "_:", 2U);
+      append(writer, object->buf, object->n_bytes);
+    }
+    break;
+  default:
+    append(writer, object->buf, object->n_bytes);
+    break;
+  }
+}
+
+static void
+write_predicate_object(TurtleWriter* const      writer,
+                       const unsigned           frame_index,
+                       const SerdStatementFlags flags,
+                       const SerdNode* const    predicate,
+                       const SerdNode* const    object,
+                       const SerdNode* const    datatype,
+                       const SerdNode* const    lang,
+                       const Binary* const      binary)
+{
+  TurtleFrame* const frame  = &writer->frames[frame_index];
+  const unsigned     indent = frame_index + 1U;
+
+  if (frame->has_predicate && text_equals(&frame->predicate, predicate)) {
+    append(writer, " ,", 2U);
+    write_newline(writer, indent + 1U);
+  } else {
+    if (frame->has_predicate) {
+      append(writer, " ;", 2U);
+    }
+
+    write_newline(writer, indent);
+    write_uri(writer, predicate, true);
+    append_char(writer, ' ');
+    set_text(writer, &frame->predicate, predicate->buf, predicate->n_bytes);
+    frame->has_predicate = true;
+  }
+
+  write_object(writer, flags, object, datatype, lang, binary);
+}
+
+static void
+write_subject(TurtleWriter* const      writer,
+              const SerdStatementFlags flags,
+              const SerdNode* const    subject)
+{
+  if (writer->subject_type != SERD_NOTHING) {
+    append(writer, " .\n\n", 4U);
+  }
+
+  if (subject->type == SERD_BLANK) {
+    if (flags & SERD_EMPTY_S) {
+      append(writer, "[]", 2U);
+    } else {
+      append(writer, "_:", 2U);
+      append(writer, subject->buf, subject->n_bytes);
+    }
+  } else {
+    write_uri(writer, subject, false);
+  }
+
+  set_text(writer, &writer->subject, subject->buf, subject->n_bytes);
+  writer->subject_type            = subject->type;
+  writer->frames[0].has_predicate = false;
+}
+
+/// Write a node that isn't a literal as a whole term
+static void
+write_term(TurtleWriter* const writer, const SerdNode* const node)
+{
+  if (node->type == SERD_BLANK) {
+    append(writer, "_:", 2U);
+    append(writer, node->buf, node->n_bytes);
+  } else if (node->type == SERD_URI) {
+    write_uri(writer, node, false);
+  } else {
+    append(writer, node->buf, node->n_bytes);
+  }
+}
+
+/// Write a statement on a line of its own
+static void
+write_line(TurtleWriter* const   writer,
+           const SerdNode* const graph,
+           const SerdNode* const subject,
+           const SerdNode* const predicate,
+           const SerdNode* const object,
+           const SerdNode* const datatype,
+           const SerdNode* const lang,
+           const Binary* const   binary)
+{
+  write_term(writer, subject);
+  append_char(writer, ' ');
+  write_uri(writer, predicate, true);
+  append_char(writer, ' ');
+
+  if (object->type == SERD_LITERAL) {
+    write_literal(writer, object, datatype, lang, binary);
+  } else {
+    write_term(writer, object);
+  }
+
+  if (writer->syntax == SERD_NQUADS && graph && graph->buf) {
+    append_char(writer, ' ');
+    write_term(writer, graph);
+  }
+
+  append(writer, " .\n", 3U);
+}
+
+void
+turtle_writer_init(TurtleWriter* const writer, const SerdEnv* const env)
+{
+  memset(writer, 0, sizeof(TurtleWriter));
+  writer->env    = env;
+  writer->syntax = SERD_TURTLE;
+  writer->style  = (SerdStyle)(SERD_STYLE_ABBREVIATED | SERD_STYLE_RESOLVED |
+                              SERD_STYLE_CURIED);
+  push_frame(writer, false);
+}
+
+void
+turtle_writer_set_syntax(TurtleWriter* const writer,
+                         const SerdSyntax    syntax,
+                         const SerdStyle     style)
+{
+  writer->syntax = syntax;
+  writer->style  = style;
+  writer->lines  = !is_terse(writer) || !(style & SERD_STYLE_ABBREVIATED);
+}
+
+bool
+turtle_writer_set_sink(TurtleWriter* const writer,
+                       const SerdSink      sink,
+                       void* const         stream)
+{
+  if (!reserve(writer, &writer->out, SINK_BLOCK_SIZE)) {
+    return false;
+  }
+
+  writer->sink   = sink;
+  writer->stream = stream;
+  return true;
+}
+
+void
+turtle_writer_set_base_uri(TurtleWriter* const   writer,
+                           const SerdNode* const base_uri)
+{
+  writer->base.len = 0U;
+  if (!base_uri || !base_uri->buf || !has_scheme(base_uri->buf)) {
+    return;
+  }
+
+  // The directory is up to the last slash in the path, after any authority
+  const char* const uri  = (const char*)base_uri->buf;
+  const char*       path = strchr(uri, ':') + 1;
+  const size_t      end  = strcspn(uri, "?#");
+  size_t            len  = 0U;
+  if (!strncmp(path, "//", 2)) {
+    path += 2U + strcspn(path + 2U, "/?#");
+  }
+
+  for (size_t i = (size_t)(path - uri); i < end; ++i) {
+    if (uri[i] == '/') {
+      len = i + 1U;
+    }
+  }
+
+  if (len) {
+    set_text(writer, &writer->base, base_uri->buf, len);
+  }
+}
+
+void
+turtle_writer_cleanup(TurtleWriter* const writer)
+{
+  for (unsigned i = 0U; i < writer->frames_cap; ++i) {
+    free(writer->frames[i].predicate.buf);
+  }
+
+  free(writer->frames);
+  free(writer->base.buf);
+  free(writer->subject.buf);
+  free(writer->out.buf);
+  memset(writer, 0, sizeof(TurtleWriter));
+}
+
+static SerdStatus
+write_statement(TurtleWriter* const      writer,
+                const SerdStatementFlags flags,
+                const SerdNode* const    graph,
+                const SerdNode* const    subject,
+                const SerdNode* const    predicate,
+                const SerdNode* const    object,
+                const SerdNode* const    object_datatype,
+                const SerdNode* const    object_lang,
+                const Binary* const      binary)
+{
+  if (!subject || !subject->buf || !predicate || !predicate->buf || !object ||
+      !object->buf || !writer->n_frames) {
+    return SERD_ERR_BAD_ARG;
+  }
+
+  if (writer->lines) {
+    write_line(writer,
+               graph,
+               subject,
+               predicate,
+               object,
+               object_datatype,
+               object_lang,
+               binary);
+    return writer->failed ? SERD_ERR_BAD_WRITE : SERD_SUCCESS;
+  }
+
+  const unsigned     top   = writer->n_frames - 1U;
+  const TurtleFrame* frame = &writer->frames[top];
+
+  if (flags & SERD_LIST_CONT) {
+    if (!frame->is_list) {
+      return SERD_ERR_BAD_ARG;
+    }
+
+    if (object->type == SERD_URI && node_equals(object, NS_RDF "nil")) {
+      --writer->n_frames; // End of list
+      write_newline(writer, writer->n_frames);
+      append_char(writer, ')');
+    } else if (node_equals(predicate, NS_RDF "first")) {
+      write_newline(writer, writer->n_frames);
+      write_object(
+        writer, flags, object, object_datatype, object_lang, binary);
+    }
+  } else if ((flags & SERD_ANON_CONT) && top > 0U && !frame->is_list) {
+    write_predicate_object(writer,
+                           top,
+                           flags,
+                           predicate,
+                           object,
+                           object_datatype,
+                           object_lang,
+                           binary);
+  } else {
+    if (writer->subject_type != subject->type ||
+        !text_equals(&writer->subject, subject)) {
+      write_subject(writer, flags, subject);
+    }
+
+    write_predicate_object(writer,
+                           0U,
+                           flags,
+                           predicate,
+                           object,
+                           object_datatype,
+                           object_lang,
+                           binary);
+  }
+
+  return writer->failed ? SERD_ERR_BAD_WRITE : SERD_SUCCESS;
+}
+
+SerdStatus
+turtle_writer_write_statement(void* const              handle,
+                              const SerdStatementFlags flags,
+                              const SerdNode* const    graph,
+                              const SerdNode* const    subject,
+                              const SerdNode* const    predicate,
+                              const SerdNode* const    object,
+                              const SerdNode* const    object_datatype,
+                              const SerdNode* const    object_lang)
+{
+  return write_statement((TurtleWriter*)handle,
+                         flags,
+                         graph,
+                         subject,
+                         predicate,
+                         object,
+                         object_datatype,
+                         object_lang,
+                         NULL);
+}
+
+SerdStatus
+turtle_writer_write_base64(TurtleWriter* const      writer,
+                           const SerdStatementFlags flags,
+                           const SerdNode* const    graph,
+                           const SerdNode* const    subject,
+                           const SerdNode* const    predicate,
+                           const void* const        body,
+                           const size_t             size,
+                           const SerdNode* const    datatype)
+{
+  const Binary   binary = {(const uint8_t*)body, size};
+  const SerdNode object = {(const uint8_t*)"",
+                           0U,
+                           0U,
+                           size > BASE64_LINE_BYTES ? SERD_HAS_NEWLINE : 0U,
+                           SERD_LITERAL};
+
+  return write_statement(
+    writer, flags, graph, subject, predicate, &object, datatype, NULL, &binary);
+}
+
+SerdStatus
+turtle_writer_end_anon(void* const handle, const SerdNode* const node)
+{
+  (void)node;
+
+  TurtleWriter* const writer = (TurtleWriter*)handle;
+  if (writer->lines) {
+    return SERD_SUCCESS;
+  }
+
+  if (writer->n_frames < 2U || writer->frames[writer->n_frames - 1U].is_list) {
+    return SERD_ERR_UNKNOWN;
+  }
+
+  const TurtleFrame* const frame = &writer->frames[--writer->n_frames];
+  if (frame->has_predicate) {
+    write_newline(writer, writer->n_frames);
+  }
+
+  append_char(writer, ']');
+  return writer->failed ? SERD_ERR_BAD_WRITE : SERD_SUCCESS;
+}
+
+/// Terminate the last statement and reset the writer for a new document
+static void
+end_document(TurtleWriter* const writer)
+{
+  if (writer->subject_type != SERD_NOTHING) {
+    append(writer, " .\n", 3U);
+  }
+
+  writer->subject_type            = SERD_NOTHING;
+  writer->n_frames                = 1U;
+  writer->frames[0].has_predicate = false;
+}
+
+char*
+turtle_writer_finish(TurtleWriter* const writer)
+{
+  end_document(writer);
+  append_char(writer, '\0');
+  if (writer->failed) {
+    return NULL;
+  }
+
+  char* const str = writer->out.buf;
+
+  writer->out.buf = NULL;
+  writer->out.len = 0U;
+  writer->out.cap = 0U;
+  return str;
+}
+
+bool
+turtle_writer_finish_stream(TurtleWriter* const writer)
+{
+  end_document(writer);
+  flush(writer);
+  return !writer->failed;
+}
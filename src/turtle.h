@@ -0,0 +1,151 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_TURTLE_H
+#define SRATOM_SRC_TURTLE_H
+
+#include <serd/serd.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/// A growable text buffer
+typedef struct {
+  char*  buf; ///< Contents, not null-terminated
+  size_t len; ///< Length of contents in bytes
+  size_t cap; ///< Allocated size of buf in bytes
+} TextBuffer;
+
+/// An open description or list in the output
+typedef struct {
+  TextBuffer predicate; ///< Last predicate written, if has_predicate
+  bool       has_predicate;
+  bool       is_list;
+} TurtleFrame;
+
+/**
+   A Turtle writer for the statements produced by sratom.
+
+   Unlike SerdWriter, this trusts the abbreviation flags on statements to
+   determine the structure, so subjects only need to be compared at the top
+   level, and appends text directly to a single buffer that grows
+   geometrically.  By default, the output follows SerdWriter with the
+   abbreviated, resolved, and CURIEd styles.
+
+   Without the abbreviated style, or in N-Triples or N-Quads, every statement
+   is written on its own line as it arrives, so no structure is tracked at
+   all.  This relies on sratom naming every blank node.
+
+   If a sink is set, the output buffer has a fixed size instead, and is
+   written to the sink whenever it fills up.
+*/
+typedef struct {
+  const SerdEnv* env;          ///< Environment for prefixes, or null
+  SerdSyntax     syntax;       ///< Output syntax
+  SerdStyle      style;        ///< Output style flags
+  bool           lines;        ///< True to write a statement per line
+  SerdSink       sink;         ///< Sink for output, or null to build a string
+  void*          stream;       ///< Handle for sink
+  TextBuffer     out;          ///< Output text
+  TextBuffer     base;         ///< Directory of the base URI, or empty
+  TextBuffer     subject;      ///< Current top-level subject
+  SerdType       subject_type; ///< Type of subject, or SERD_NOTHING
+  TurtleFrame*   frames;       ///< Open frames, the first is the top level
+  unsigned       n_frames;     ///< Number of open frames
+  unsigned       frames_cap;   ///< Allocated number of frames
+  bool           failed;       ///< True if an allocation failed
+} TurtleWriter;
+
+/// Initialise a writer that uses the prefixes in `env`, which may be null
+void
+turtle_writer_init(TurtleWriter* writer, const SerdEnv* env);
+
+/**
+   Set the output syntax and style.
+
+   Only SERD_STYLE_ABBREVIATED, SERD_STYLE_RESOLVED, and SERD_STYLE_CURIED
+   have any effect, and only for Turtle or TriG.  This must be called before
+   anything is written.
+*/
+void
+turtle_writer_set_syntax(TurtleWriter* writer,
+                         SerdSyntax    syntax,
+                         SerdStyle     style);
+
+/**
+   Write output to a sink as it is produced, rather than building a string.
+
+   This must be called before anything is written.
+
+   @return True on success, or false if the output buffer couldn't be
+   allocated.
+*/
+bool
+turtle_writer_set_sink(TurtleWriter* writer, SerdSink sink, void* stream);
+
+/**
+   Set the base URI, or clear it if `base_uri` is null.
+
+   With SERD_STYLE_RESOLVED, URIs in the directory of the base URI are written
+   relative to it in Turtle or TriG.  Other URIs are written as they are, so
+   they must already be resolved.
+*/
+void
+turtle_writer_set_base_uri(TurtleWriter* writer, const SerdNode* base_uri);
+
+/// Free everything allocated by a writer, including any unfinished output
+void
+turtle_writer_cleanup(TurtleWriter* writer);
+
+/// Write a statement, a SerdStatementSink for a TurtleWriter handle
+SerdStatus
+turtle_writer_write_statement(void*              handle,
+                              SerdStatementFlags flags,
+                              const SerdNode*    graph,
+                              const SerdNode*    subject,
+                              const SerdNode*    predicate,
+                              const SerdNode*    object,
+                              const SerdNode*    object_datatype,
+                              const SerdNode*    object_lang);
+
+/**
+   Write a statement with the base64 encoding of `body` as a literal object.
+
+   This is like turtle_writer_write_statement(), but the encoding is written a
+   line at a time directly into the output, so it is never stored as a whole.
+*/
+SerdStatus
+turtle_writer_write_base64(TurtleWriter*      writer,
+                           SerdStatementFlags flags,
+                           const SerdNode*    graph,
+                           const SerdNode*    subject,
+                           const SerdNode*    predicate,
+                           const void*        body,
+                           size_t             size,
+                           const SerdNode*    datatype);
+
+/// Finish an anonymous node, a SerdEndSink for a TurtleWriter handle
+SerdStatus
+turtle_writer_end_anon(void* handle, const SerdNode* node);
+
+/**
+   Finish the document and return the output.
+
+   The returned string is owned by the caller and must be freed with free().
+   The writer is left empty, but must still be cleaned up.
+
+   @return The output string, or null if writing failed.
+*/
+char*
+turtle_writer_finish(TurtleWriter* writer);
+
+/**
+   Finish the document and write any buffered output to the sink.
+
+   @return True on success, or false if writing failed.
+*/
+bool
+turtle_writer_finish_stream(TurtleWriter* writer);
+
+#endif /* SRATOM_SRC_TURTLE_H */
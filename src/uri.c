@@ -0,0 +1,179 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include "uri.h"
+
+#include "arena.h"
+#include "hex.h"
+
+#include <serd/serd.h>
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static size_t
+count_sink(const void* const buf, const size_t len, void* const stream)
+{
+  (void)buf;
+
+  *(size_t*)stream += len;
+  return len;
+}
+
+static size_t
+copy_sink(const void* const buf, const size_t len, void* const stream)
+{
+  char** const s = (char**)stream;
+
+  memcpy(*s, buf, len);
+  *s += len;
+  return len;
+}
+
+static void
+serialise(const SerdURI* const uri,
+          const SerdURI* const base,
+          const SerdSink       sink,
+          void* const          stream)
+{
+  if (base) {
+    serd_uri_serialise_relative(uri, base, base, sink, stream);
+  } else {
+    serd_uri_serialise(uri, sink, stream);
+  }
+}
+
+SerdNode
+uri_node(Arena* const         arena,
+         const SerdURI* const uri,
+         const SerdURI* const base)
+{
+  size_t len = 0U;
+  serialise(uri, base, count_sink, &len);
+
+  char* const buf = (char*)arena_alloc(arena, len + 1U);
+  if (!buf) {
+    return SERD_NODE_NULL;
+  }
+
+  char* s = buf;
+  serialise(uri, base, copy_sink, &s);
+  *s = '\0';
+
+  const SerdNode node = {(const uint8_t*)buf, len, len, 0, SERD_URI};
+  return node;
+}
+
+static bool
+is_windows_path(const char* const path)
+{
+  return isalpha((unsigned char)path[0]) &&
+         (path[1] == ':' || path[1] == '|') &&
+         (path[2] == '/' || path[2] == '\\');
+}
+
+static bool
+is_path_char(const char c)
+{
+  return isalnum((unsigned char)c) || (c && strchr("-._~:@/!$&'()*+,;=", c));
+}
+
+SerdNode
+uri_from_path(Arena* const arena, const char* const path)
+{
+  static const char* const hex_digits = "0123456789ABCDEF";
+
+  const bool   is_windows = is_windows_path(path);
+  const char*  prefix     = "";
+  const size_t path_len   = strlen(path);
+  if (is_windows) {
+    prefix = "file:///";
+  } else if (path[0] == '/') {
+    prefix = "file://";
+  }
+
+  // Measure the escaped length first to allocate the string at once
+  size_t len = strlen(prefix);
+  for (size_t i = 0U; i < path_len; ++i) {
+    const char c = path[i];
+    if (c == '%') {
+      len += 2U;
+    } else if ((is_windows && c == '\\') || is_path_char(c)) {
+      ++len;
+    } else {
+      len += 3U;
+    }
+  }
+
+  char* const buf = (char*)arena_alloc(arena, len + 1U);
+  if (!buf) {
+    return SERD_NODE_NULL;
+  }
+
+  char* s = buf;
+  memcpy(s, prefix, strlen(prefix));
+  s += strlen(prefix);
+
+  for (size_t i = 0U; i < path_len; ++i) {
+    const char c = path[i];
+    if (c == '%') {
+      *s++ = '%';
+      *s++ = '%';
+    } else if (is_windows && c == '\\') {
+      *s++ = '/';
+    } else if (is_path_char(c)) {
+      *s++ = c;
+    } else {
+      *s++ = '%';
+      *s++ = hex_digits[(uint8_t)c >> 4U];
+      *s++ = hex_digits[(uint8_t)c & 0x0FU];
+    }
+  }
+
+  *s = '\0';
+
+  const SerdNode node = {(const uint8_t*)buf, len, len, 0, SERD_URI};
+  return node;
+}
+
+char*
+uri_to_path(Arena* const arena, const char* const uri)
+{
+  const char* path = uri;
+  if (!strncmp(uri, "file://", 7)) {
+    // Skip the authority, which is empty or a hostname
+    if (!(path = strchr(uri + 7, '/'))) {
+      return NULL;
+    }
+  }
+
+  if (path[0] == '/' && is_windows_path(path + 1)) {
+    ++path;
+  }
+
+  char* const buf = (char*)arena_alloc(arena, strlen(path) + 1U);
+  if (!buf) {
+    return NULL;
+  }
+
+  char* s = buf;
+  for (const char* c = path; *c; ++c) {
+    if (*c != '%') {
+      *s++ = *c;
+    } else if (c[1] == '%') {
+      *s++ = '%';
+      ++c;
+    } else if (c[1] && c[2] && hex_decode((uint8_t*)s, c + 1, 2U)) {
+      ++s;
+      c += 2;
+    } else if (c[1]) {
+      c += c[2] ? 2 : 1; // Junk escape, ignore
+    }
+  }
+
+  *s = '\0';
+  return buf;
+}
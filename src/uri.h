@@ -0,0 +1,43 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#ifndef SRATOM_SRC_URI_H
+#define SRATOM_SRC_URI_H
+
+#include "arena.h"
+
+#include <serd/serd.h>
+
+/**
+   Return a URI node allocated in an arena.
+
+   @param arena Arena to allocate the string in.
+   @param uri URI to serialise.
+   @param base If non-null, the URI is written relative to this base if it is
+   within it, as with serd_node_new_relative_uri().
+   @return A new URI node, or a null node if allocation failed.
+*/
+SerdNode
+uri_node(Arena* arena, const SerdURI* uri, const SerdURI* base);
+
+/**
+   Return a file URI node for a path allocated in an arena.
+
+   This is equivalent to serd_node_new_file_uri() with escaping and no
+   hostname, so a relative path results in a relative URI reference.
+*/
+SerdNode
+uri_from_path(Arena* arena, const char* path);
+
+/**
+   Return the path of a file URI allocated in an arena.
+
+   This is equivalent to serd_file_uri_parse(), any hostname is ignored.
+
+   @return The decoded path, or null if the URI is invalid or allocation
+   failed.
+*/
+char*
+uri_to_path(Arena* arena, const char* uri);
+
+#endif /* SRATOM_SRC_URI_H */
@@ -0,0 +1,598 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/midi/midi.h>
+#include <lv2/urid/urid.h>
+#include <serd/serd.h>
+#include <sord/sord.h>
+#include <sratom/sratom.h>
+
+#include "clock.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_EG "http://example.org/"
+
+#define USTR(s) ((const uint8_t*)(s))
+
+#define N_URI_SLOTS 65536U
+
+/// Hashed URI map, since the O(n) test map would dominate large objects
+typedef struct {
+  char*    strings[N_URI_SLOTS]; ///< URI for each slot, or NULL
+  LV2_URID ids[N_URI_SLOTS];     ///< URID for each slot
+  char*    by_id[N_URI_SLOTS];   ///< URI for each ID, borrowed from strings
+  LV2_URID n_ids;                ///< Number of mapped URIs
+} BenchUris;
+
+typedef struct {
+  const char* name;  ///< Corpus name
+  LV2_Atom*   atom;  ///< Forged atom
+  size_t      count; ///< Number of atoms in corpus (including containers)
+} Corpus;
+
+typedef struct {
+  unsigned n_elems;  ///< Number of properties/elements/events
+  unsigned depth;    ///< Depth of nested tuples
+  unsigned n_reps;   ///< Number of timed repetitions per operation
+  size_t   n_chunk;  ///< Size of large chunk in bytes
+  bool     failed;   ///< Set if any operation failed
+  double*  times;    ///< Scratch array of per-repetition times
+  size_t   n_writes; ///< Statement counter for sratom_write sink
+} Options;
+
+typedef enum {
+  OP_TO_TURTLE,
+  OP_FROM_TURTLE,
+  OP_READER_READ,
+  OP_WRITE,
+  OP_READ
+} Operation;
+
+static const char* const op_names[] = {
+  "to_turtle",
+  "from_turtle",
+  "reader_read",
+  "write",
+  "read",
+};
+
+static uint32_t
+hash_string(const char* str)
+{
+  uint32_t h = 2166136261U; // FNV-1a
+  for (const char* s = str; *s; ++s) {
+    h = (h ^ (uint8_t)*s) * 16777619U;
+  }
+  return h;
+}
+
+static LV2_URID
+bench_map(LV2_URID_Map_Handle handle, const char* uri)
+{
+  BenchUris* const uris = (BenchUris*)handle;
+
+  uint32_t i = hash_string(uri) & (N_URI_SLOTS - 1U);
+  for (; uris->strings[i]; i = (i + 1U) & (N_URI_SLOTS - 1U)) {
+    if (!strcmp(uris->strings[i], uri)) {
+      return uris->ids[i];
+    }
+  }
+
+  // Failing to map would silently make every result meaningless
+  const size_t len = strlen(uri);
+  char* const  dup = (uris->n_ids + 1U < N_URI_SLOTS / 2U)
+                       ? (char*)malloc(len + 1U)
+                       : NULL;
+  if (!dup) {
+    fprintf(stderr, "error: Failed to map <%s>, corpus too large\n", uri);
+    exit(EXIT_FAILURE);
+  }
+
+  memcpy(dup, uri, len + 1U);
+
+  uris->strings[i]         = dup;
+  uris->ids[i]             = ++uris->n_ids;
+  uris->by_id[uris->n_ids] = dup;
+  return uris->n_ids;
+}
+
+static const char*
+bench_unmap(LV2_URID_Unmap_Handle handle, LV2_URID urid)
+{
+  const BenchUris* const uris = (const BenchUris*)handle;
+
+  return (urid > 0U && urid <= uris->n_ids) ? uris->by_id[urid] : NULL;
+}
+
+static void
+free_bench_uris(BenchUris* const uris)
+{
+  for (uint32_t i = 0U; i < N_URI_SLOTS; ++i) {
+    free(uris->strings[i]);
+  }
+
+  free(uris);
+}
+
+static int
+compare_doubles(const void* const a, const void* const b)
+{
+  const double x = *(const double*)a;
+  const double y = *(const double*)b;
+  return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+static double
+percentile(const double* const sorted, const unsigned n, const unsigned pct)
+{
+  const unsigned i = (unsigned)(((uint64_t)(n - 1U) * pct + 50U) / 100U);
+  return sorted[i];
+}
+
+static void
+start_forge(LV2_Atom_Forge* const forge,
+            LV2_URID_Map* const   map,
+            SerdChunk* const      chunk)
+{
+  lv2_atom_forge_init(forge, map);
+  lv2_atom_forge_set_sink(forge, sratom_forge_sink, sratom_forge_deref, chunk);
+}
+
+static Corpus
+forge_object(LV2_URID_Map* const map, const Options* const opts)
+{
+  SerdChunk      chunk = {NULL, 0};
+  LV2_Atom_Forge forge;
+  start_forge(&forge, map, &chunk);
+
+  const LV2_URID eg_Object = map->map(map->handle, NS_EG "Object");
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_object(&forge, &frame, 0U, eg_Object);
+
+  char key[64];
+  for (unsigned i = 0U; i < opts->n_elems; ++i) {
+    snprintf(key, sizeof(key), NS_EG "p%08u", i);
+    lv2_atom_forge_key(&forge, map->map(map->handle, key));
+    switch (i % 4U) {
+    case 0U:
+      lv2_atom_forge_int(&forge, (int32_t)i);
+      break;
+    case 1U:
+      lv2_atom_forge_float(&forge, (float)i * 0.25f);
+      break;
+    case 2U:
+      lv2_atom_forge_string(&forge, "value", 5U);
+      break;
+    default:
+      lv2_atom_forge_bool(&forge, i & 8U);
+      break;
+    }
+  }
+
+  lv2_atom_forge_pop(&forge, &frame);
+
+  const Corpus corpus = {"object", (LV2_Atom*)chunk.buf, opts->n_elems + 1U};
+  return corpus;
+}
+
+static Corpus
+forge_vector(LV2_URID_Map* const  map,
+             const Options* const opts,
+             const char* const    name,
+             const bool           floats)
+{
+  SerdChunk      chunk = {NULL, 0};
+  LV2_Atom_Forge forge;
+  start_forge(&forge, map, &chunk);
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_vector_head(&forge,
+                             &frame,
+                             floats ? sizeof(float) : sizeof(int32_t),
+                             floats ? forge.Float : forge.Int);
+
+  for (unsigned i = 0U; i < opts->n_elems; ++i) {
+    if (floats) {
+      const float value = (float)i / (float)opts->n_elems;
+      lv2_atom_forge_raw(&forge, &value, sizeof(value));
+    } else {
+      const int32_t value = (int32_t)i;
+      lv2_atom_forge_raw(&forge, &value, sizeof(value));
+    }
+  }
+
+  lv2_atom_forge_pop(&forge, &frame);
+  lv2_atom_forge_pad(&forge, opts->n_elems * 4U);
+
+  const Corpus corpus = {name, (LV2_Atom*)chunk.buf, opts->n_elems + 1U};
+  return corpus;
+}
+
+static Corpus
+forge_sequence(LV2_URID_Map* const  map,
+               const Options* const opts,
+               const char* const    name,
+               const bool           beats)
+{
+  SerdChunk      chunk = {NULL, 0};
+  LV2_Atom_Forge forge;
+  start_forge(&forge, map, &chunk);
+
+  const LV2_URID midi_MidiEvent = map->map(map->handle, LV2_MIDI__MidiEvent);
+  const LV2_URID atom_beatTime  = map->map(map->handle, LV2_ATOM__beatTime);
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_sequence_head(&forge, &frame, beats ? atom_beatTime : 0U);
+
+  for (unsigned i = 0U; i < opts->n_elems; ++i) {
+    const uint8_t ev[3] = {
+      (uint8_t)((i & 1U) ? 0x80U : 0x90U),
+      (uint8_t)(i & 0x7FU),
+      0x40U,
+    };
+
+    if (beats) {
+      lv2_atom_forge_beat_time(&forge, (double)i * 0.125);
+    } else {
+      lv2_atom_forge_frame_time(&forge, (int64_t)i * 16);
+    }
+
+    lv2_atom_forge_atom(&forge, sizeof(ev), midi_MidiEvent);
+    lv2_atom_forge_raw(&forge, ev, sizeof(ev));
+    lv2_atom_forge_pad(&forge, sizeof(ev));
+  }
+
+  lv2_atom_forge_pop(&forge, &frame);
+
+  const Corpus corpus = {
+    name, (LV2_Atom*)chunk.buf, (2U * opts->n_elems) + 1U};
+  return corpus;
+}
+
+static void
+forge_tuple_level(LV2_Atom_Forge* const forge, const unsigned depth)
+{
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(forge, &frame);
+  lv2_atom_forge_int(forge, (int32_t)depth);
+  lv2_atom_forge_string(forge, "level", 5U);
+  if (depth > 1U) {
+    forge_tuple_level(forge, depth - 1U);
+  }
+  lv2_atom_forge_pop(forge, &frame);
+}
+
+static Corpus
+forge_tuple(LV2_URID_Map* const map, const Options* const opts)
+{
+  SerdChunk      chunk = {NULL, 0};
+  LV2_Atom_Forge forge;
+  start_forge(&forge, map, &chunk);
+
+  forge_tuple_level(&forge, opts->depth);
+
+  const Corpus corpus = {"tuple", (LV2_Atom*)chunk.buf, 3U * opts->depth};
+  return corpus;
+}
+
+static Corpus
+forge_chunk(LV2_URID_Map* const map, const Options* const opts)
+{
+  SerdChunk      chunk = {NULL, 0};
+  LV2_Atom_Forge forge;
+  start_forge(&forge, map, &chunk);
+
+  uint8_t* const data = (uint8_t*)malloc(opts->n_chunk);
+  if (!data) {
+    fprintf(stderr, "error: Failed to allocate chunk\n");
+    exit(EXIT_FAILURE);
+  }
+
+  for (size_t i = 0U; i < opts->n_chunk; ++i) {
+    data[i] = (uint8_t)((i * 31U) ^ (i >> 8U));
+  }
+
+  lv2_atom_forge_atom(&forge, (uint32_t)opts->n_chunk, forge.Chunk);
+  lv2_atom_forge_write(&forge, data, (uint32_t)opts->n_chunk);
+  free(data);
+
+  const Corpus corpus = {"chunk", (LV2_Atom*)chunk.buf, 1U};
+  return corpus;
+}
+
+static SerdStatus
+count_statement(void* const              handle,
+                const SerdStatementFlags flags,
+                const SerdNode* const    graph,
+                const SerdNode* const    subject,
+                const SerdNode* const    predicate,
+                const SerdNode* const    object,
+                const SerdNode* const    object_datatype,
+                const SerdNode* const    object_lang)
+{
+  (void)flags;
+  (void)graph;
+  (void)subject;
+  (void)predicate;
+  (void)object;
+  (void)object_datatype;
+  (void)object_lang;
+
+  ++((Options*)handle)->n_writes;
+  return SERD_SUCCESS;
+}
+
+static double
+run_once(const Operation       op,
+         Options* const        opts,
+         Sratom* const         sratom,
+         SratomReader* const   sratom_reader,
+         LV2_Atom_Forge* const forge,
+         LV2_URID_Unmap* const unmap,
+         const LV2_Atom* const atom,
+         const char* const     ttl,
+         SordWorld* const      world,
+         SordModel* const      model,
+         const SordNode* const root)
+{
+  static const char* const base_uri = "file:///tmp/bench/";
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+  const double   t = clock_now();
+
+  if (op == OP_TO_TURTLE) {
+    char* const str = sratom_to_turtle(sratom,
+                                       unmap,
+                                       base_uri,
+                                       &s,
+                                       &p,
+                                       atom->type,
+                                       atom->size,
+                                       LV2_ATOM_BODY_CONST(atom));
+    opts->failed |= !str;
+    free(str);
+  } else if (op == OP_FROM_TURTLE) {
+    LV2_Atom* const parsed = sratom_from_turtle(sratom, base_uri, &s, &p, ttl);
+    opts->failed |= !parsed;
+    free(parsed);
+  } else if (op == OP_READER_READ) {
+    LV2_Atom* const parsed =
+      sratom_reader_read_string(sratom_reader, base_uri, &s, &p, ttl);
+    opts->failed |= !parsed;
+    free(parsed);
+  } else if (op == OP_WRITE) {
+    sratom_set_sink(sratom, base_uri, count_statement, NULL, opts);
+    opts->failed |= !!sratom_write(sratom,
+                                   unmap,
+                                   0U,
+                                   &s,
+                                   &p,
+                                   atom->type,
+                                   atom->size,
+                                   LV2_ATOM_BODY_CONST(atom));
+  } else {
+    SerdChunk chunk = {NULL, 0};
+    lv2_atom_forge_set_sink(
+      forge, sratom_forge_sink, sratom_forge_deref, &chunk);
+    sratom_read(sratom, forge, world, model, root);
+    opts->failed |= !chunk.buf;
+    free((void*)chunk.buf);
+  }
+
+  return clock_now() - t;
+}
+
+static void
+bench_corpus(Options* const        opts,
+             LV2_URID_Map* const   map,
+             LV2_URID_Unmap* const unmap,
+             const Corpus          corpus)
+{
+  static const char* const base_uri = "file:///tmp/bench/";
+
+  Sratom* const  sratom = sratom_new(map);
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, map);
+
+  // Prepare Turtle text and a loaded model for the reading benchmarks
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  char* const ttl = sratom_to_turtle(sratom,
+                                     unmap,
+                                     base_uri,
+                                     &s,
+                                     &p,
+                                     corpus.atom->type,
+                                     corpus.atom->size,
+                                     LV2_ATOM_BODY_CONST(corpus.atom));
+  if (!ttl) {
+    fprintf(stderr, "error: Failed to serialize corpus %s\n", corpus.name);
+    opts->failed = true;
+    sratom_free(sratom);
+    return;
+  }
+
+  SerdNode    base   = serd_node_from_string(SERD_URI, USTR(base_uri));
+  SerdEnv*    env    = serd_env_new(&base);
+  SordWorld*  world  = sord_world_new();
+  SordModel*  model  = sord_new(world, SORD_SPO, false);
+  SerdReader* reader = sord_new_reader(model, env, SERD_TURTLE, NULL);
+  serd_reader_read_string(reader, USTR(ttl));
+  serd_reader_free(reader);
+
+  SordNode* const ss   = sord_new_uri(world, USTR(NS_EG "s"));
+  SordNode* const sp   = sord_new_uri(world, USTR(NS_EG "p"));
+  SordNode* const root = sord_get(model, ss, sp, NULL, NULL);
+  if (!root) {
+    fprintf(stderr, "error: Failed to load corpus %s\n", corpus.name);
+    opts->failed = true;
+  }
+
+  sratom_bind_world(sratom, world);
+
+  SratomReader* const sratom_reader = sratom_reader_new(sratom);
+  if (!sratom_reader) {
+    fprintf(stderr, "error: Failed to create reader\n");
+    opts->failed = true;
+  }
+
+  const size_t n_bytes = lv2_atom_total_size(corpus.atom);
+  for (unsigned o = OP_TO_TURTLE; root && sratom_reader && o <= OP_READ; ++o) {
+    for (unsigned r = 0U; r < opts->n_reps; ++r) {
+      opts->times[r] = run_once((Operation)o,
+                                opts,
+                                sratom,
+                                sratom_reader,
+                                &forge,
+                                unmap,
+                                corpus.atom,
+                                ttl,
+                                world,
+                                model,
+                                root);
+    }
+
+    double total = 0.0;
+    for (unsigned r = 0U; r < opts->n_reps; ++r) {
+      total += opts->times[r];
+    }
+
+    qsort(opts->times, opts->n_reps, sizeof(double), compare_doubles);
+
+    const double mean = total / opts->n_reps;
+    printf("%-8s %-12s %10zu %8zu %10.1f %10.1f %10.2f %12.0f\n",
+           corpus.name,
+           op_names[o],
+           n_bytes,
+           corpus.count,
+           percentile(opts->times, opts->n_reps, 50U) * 1.0e6,
+           percentile(opts->times, opts->n_reps, 99U) * 1.0e6,
+           ((double)n_bytes / mean) / (1024.0 * 1024.0),
+           (double)corpus.count / mean);
+  }
+
+  sratom_reader_free(sratom_reader);
+  sratom_unbind_world(sratom);
+  sord_node_free(world, root);
+  sord_node_free(world, sp);
+  sord_node_free(world, ss);
+  sord_free(model);
+  sord_world_free(world);
+  serd_env_free(env);
+  free(ttl);
+  sratom_free(sratom);
+}
+
+static int
+print_usage(const char* const name, const bool error)
+{
+  FILE* const os = error ? stderr : stdout;
+  fprintf(os, "Usage: %s [OPTION]...\n", name);
+  fprintf(os, "Benchmark sratom serialization on generated atom corpora.\n\n");
+  fprintf(os, "  -c BYTES  Size of chunk corpus (default: 1048576)\n");
+  fprintf(os, "  -d DEPTH  Depth of nested tuple corpus (default: 32)\n");
+  fprintf(os, "  -h        Display this help and exit\n");
+  fprintf(os, "  -n COUNT  Number of elements per corpus (default: 4096)\n");
+  fprintf(os, "  -r COUNT  Number of repetitions (default: 64)\n");
+  return error ? 1 : 0;
+}
+
+static unsigned long
+parse_count(const char* const str, bool* const error)
+{
+  char*               end = NULL;
+  const unsigned long n   = strtoul(str, &end, 10);
+  *error |= (!n || *end);
+  return n;
+}
+
+int
+main(int argc, char** argv)
+{
+  Options opts = {4096U, 32U, 64U, 1048576U, false, NULL, 0U};
+
+  bool error = false;
+  int  a     = 1;
+  for (; a < argc && argv[a][0] == '-'; ++a) {
+    if (argv[a][1] == 'h') {
+      return print_usage(argv[0], false);
+    }
+
+    if (argv[a][2] || a + 1 >= argc) {
+      return print_usage(argv[0], true);
+    }
+
+    const char* const arg = argv[++a];
+    switch (argv[a - 1][1]) {
+    case 'c':
+      opts.n_chunk = parse_count(arg, &error);
+      break;
+    case 'd':
+      opts.depth = (unsigned)parse_count(arg, &error);
+      break;
+    case 'n':
+      opts.n_elems = (unsigned)parse_count(arg, &error);
+      break;
+    case 'r':
+      opts.n_reps = (unsigned)parse_count(arg, &error);
+      break;
+    default:
+      return print_usage(argv[0], true);
+    }
+  }
+
+  if (error || a < argc) {
+    return print_usage(argv[0], true);
+  }
+
+  BenchUris* const uris  = (BenchUris*)calloc(1, sizeof(BenchUris));
+  LV2_URID_Map     map   = {uris, bench_map};
+  LV2_URID_Unmap   unmap = {uris, bench_unmap};
+
+  opts.times = (double*)calloc(opts.n_reps, sizeof(double));
+  if (!uris || !opts.times) {
+    fprintf(stderr, "error: Failed to allocate memory\n");
+    free(opts.times);
+    free(uris);
+    return 1;
+  }
+
+  const Corpus corpora[] = {
+    forge_object(&map, &opts),
+    forge_vector(&map, &opts, "ivector", false),
+    forge_vector(&map, &opts, "fvector", true),
+    forge_sequence(&map, &opts, "fseq", false),
+    forge_sequence(&map, &opts, "bseq", true),
+    forge_tuple(&map, &opts),
+    forge_chunk(&map, &opts),
+  };
+
+  printf("%-8s %-12s %10s %8s %10s %10s %10s %12s\n",
+         "corpus",
+         "operation",
+         "bytes",
+         "atoms",
+         "p50_us",
+         "p99_us",
+         "MB/s",
+         "atoms/s");
+
+  for (size_t i = 0U; i < sizeof(corpora) / sizeof(Corpus); ++i) {
+    bench_corpus(&opts, &map, &unmap, corpora[i]);
+    free(corpora[i].atom);
+  }
+
+  free(opts.times);
+  free_bench_uris(uris);
+  return opts.failed ? 1 : 0;
+}
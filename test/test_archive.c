@@ -0,0 +1,243 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#undef NDEBUG
+
+#include "forge_test_object.h"
+#include "test_uri_map.h"
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/urid/urid.h>
+#include <serd/serd.h>
+#include <sratom/sratom.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_EG "http://example.org/"
+#define NS_RDF "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+
+#define USTR(s) ((const uint8_t*)(s))
+
+/// A URI map that checks that loading maps each URI only once
+typedef struct {
+  Uris     uris;      ///< Underlying URI map
+  bool     counting;  ///< True while loading an archive
+  unsigned n_mapped;  ///< Number of URIs mapped while counting
+  char*    seen[128]; ///< URIs mapped while counting
+} CountingUris;
+
+static LV2_URID
+counting_map(LV2_URID_Map_Handle handle, const char* uri)
+{
+  CountingUris* const counter = (CountingUris*)handle;
+
+  if (counter->counting) {
+    for (unsigned i = 0U; i < counter->n_mapped; ++i) {
+      assert(strcmp(counter->seen[i], uri));
+    }
+
+    assert(counter->n_mapped < sizeof(counter->seen) / sizeof(char*));
+    const size_t len  = strlen(uri);
+    char* const  copy = (char*)calloc(1U, len + 1U);
+    memcpy(copy, uri, len + 1U);
+    counter->seen[counter->n_mapped++] = copy;
+  }
+
+  return urid_map(&counter->uris, uri);
+}
+
+static void
+free_counting_uris(CountingUris* const counter)
+{
+  for (unsigned i = 0U; i < counter->n_mapped; ++i) {
+    free(counter->seen[i]);
+  }
+
+  free_uris(&counter->uris);
+}
+
+static char*
+to_turtle(Sratom* const         sratom,
+          LV2_URID_Unmap* const unmap,
+          const LV2_Atom* const atom)
+{
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "obj"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  return sratom_to_turtle(
+    sratom, unmap, NS_EG, &s, &p, atom->type, atom->size, LV2_ATOM_BODY(atom));
+}
+
+static void
+test_round_trip(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[144];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  forge_test_object(&forge, &map, &uris, 0U);
+
+  char* const expected = to_turtle(sratom, &unmap, buf);
+  assert(expected);
+
+  size_t      size    = 0U;
+  void* const archive = sratom_to_archive(sratom, &unmap, buf, &size);
+  assert(archive);
+  assert(size > buf->size);
+  assert(!(size % 8U));
+
+  // Load with a different map, so the URIDs are different
+  CountingUris   counter = {{NULL, 0}, false, 0U, {NULL}};
+  LV2_URID_Map   map2    = {&counter, counting_map};
+  LV2_URID_Unmap unmap2  = {&counter.uris, urid_unmap};
+  counting_map(&counter, NS_EG "unrelated");
+
+  Sratom* const sratom2 = sratom_new(&map2);
+
+  counter.counting             = true;
+  const LV2_Atom* const loaded = sratom_from_archive(sratom2, archive, size);
+  counter.counting             = false;
+  assert(loaded);
+  assert(loaded->type != buf->type);
+  assert(loaded->size == buf->size);
+  assert(counter.n_mapped > 0U);
+
+  char* const actual = to_turtle(sratom2, &unmap2, loaded);
+  assert(actual);
+  assert(!strcmp(actual, expected));
+
+  free(actual);
+  free(archive);
+  free(expected);
+  sratom_free(sratom2);
+  free_counting_uris(&counter);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_turtle_conversion(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "obj"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[144];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  forge_test_object(&forge, &map, &uris, 0U);
+
+  char* const expected = to_turtle(sratom, &unmap, buf);
+  assert(expected);
+
+  // Atom => Archive => Turtle
+  size_t      size    = 0U;
+  void* const archive = sratom_to_archive(sratom, &unmap, buf, &size);
+  assert(archive);
+
+  char* const from_archive =
+    sratom_archive_to_turtle(sratom, &unmap, NS_EG, &s, &p, archive, size);
+  assert(from_archive);
+  assert(!strcmp(from_archive, expected));
+
+  // Conversion doesn't modify the archive, so it can still be loaded
+  assert(sratom_from_archive(sratom, archive, size));
+
+  // Turtle => Archive => Turtle
+  size_t      size2    = 0U;
+  void* const archive2 = sratom_turtle_to_archive(
+    sratom, &unmap, NS_EG, &s, &p, expected, &size2);
+  assert(archive2);
+  assert(size2);
+
+  char* const round_tripped =
+    sratom_archive_to_turtle(sratom, &unmap, NS_EG, &s, &p, archive2, size2);
+  assert(round_tripped);
+  assert(!strcmp(round_tripped, expected));
+
+  free(round_tripped);
+  free(archive2);
+  free(from_archive);
+  free(archive);
+  free(expected);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_bad_archives(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[4];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_urid(&forge, urid_map(&uris, NS_EG "value"));
+
+  size_t         size    = 0U;
+  uint8_t* const archive =
+    (uint8_t*)sratom_to_archive(sratom, &unmap, buf, &size);
+  assert(archive);
+
+  uint8_t* const copy = (uint8_t*)malloc(size);
+
+  // Too small for a header
+  memcpy(copy, archive, size);
+  assert(!sratom_from_archive(sratom, copy, 4U));
+
+  // Bad magic
+  memcpy(copy, archive, size);
+  copy[0] = 'X';
+  assert(!sratom_from_archive(sratom, copy, size));
+
+  // Truncated atom
+  memcpy(copy, archive, size);
+  assert(!sratom_from_archive(sratom, copy, size - 8U));
+
+  // URID that is out of range of the URI table
+  const uint32_t bad_index = 99U;
+  memcpy(copy, archive, size);
+  memcpy(copy + size - 8U, &bad_index, sizeof(bad_index));
+  assert(!sratom_from_archive(sratom, copy, size));
+
+  // Valid archive
+  memcpy(copy, archive, size);
+  const LV2_Atom* const atom = sratom_from_archive(sratom, copy, size);
+  assert(atom);
+  assert(atom->type == forge.URID);
+  assert(((const LV2_Atom_URID*)atom)->body == urid_map(&uris, NS_EG "value"));
+
+  free(copy);
+  free(archive);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+int
+main(void)
+{
+  test_round_trip();
+  test_turtle_conversion();
+  test_bad_archives();
+  return 0;
+}
@@ -0,0 +1,527 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#undef NDEBUG
+
+#include "forge_test_object.h"
+#include "test_uri_map.h"
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/atom/util.h>
+#include <lv2/patch/patch.h>
+#include <lv2/urid/urid.h>
+#include <serd/serd.h>
+#include <sratom/sratom.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_EG "http://example.org/"
+#define NS_RDF "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+
+#define USTR(s) ((const uint8_t*)(s))
+
+typedef struct {
+  Uris           uris;
+  LV2_URID_Map   map;
+  LV2_URID_Unmap unmap;
+  LV2_Atom_Forge forge;
+  Sratom*        sratom;
+  LV2_URID       eg_a;
+  LV2_URID       eg_b;
+  LV2_URID       eg_c;
+  LV2_URID       eg_d;
+  LV2_URID       eg_obj;
+  LV2_URID       eg_Type;
+  LV2_URID       eg_OtherType;
+  LV2_URID       patch_Patch;
+  LV2_URID       patch_add;
+  LV2_URID       patch_remove;
+  LV2_URID       patch_subject;
+  LV2_URID       patch_wildcard;
+} Fixture;
+
+static void
+setup(Fixture* const f)
+{
+  memset(f, 0, sizeof(Fixture));
+  f->map.handle   = &f->uris;
+  f->map.map      = urid_map;
+  f->unmap.handle = &f->uris;
+  f->unmap.unmap  = urid_unmap;
+  lv2_atom_forge_init(&f->forge, &f->map);
+  f->sratom = sratom_new(&f->map);
+
+  f->eg_a           = urid_map(&f->uris, NS_EG "a");
+  f->eg_b           = urid_map(&f->uris, NS_EG "b");
+  f->eg_c           = urid_map(&f->uris, NS_EG "c");
+  f->eg_d           = urid_map(&f->uris, NS_EG "d");
+  f->eg_obj         = urid_map(&f->uris, NS_EG "obj");
+  f->eg_Type        = urid_map(&f->uris, NS_EG "Type");
+  f->eg_OtherType   = urid_map(&f->uris, NS_EG "OtherType");
+  f->patch_Patch    = urid_map(&f->uris, LV2_PATCH__Patch);
+  f->patch_add      = urid_map(&f->uris, LV2_PATCH__add);
+  f->patch_remove   = urid_map(&f->uris, LV2_PATCH__remove);
+  f->patch_subject  = urid_map(&f->uris, LV2_PATCH__subject);
+  f->patch_wildcard = urid_map(&f->uris, LV2_PATCH__wildcard);
+}
+
+static void
+teardown(Fixture* const f)
+{
+  sratom_free(f->sratom);
+  free_uris(&f->uris);
+}
+
+static void
+set_buffer(Fixture* const f, LV2_Atom* const buf, const size_t size)
+{
+  lv2_atom_forge_set_buffer(&f->forge, (uint8_t*)buf, size);
+}
+
+/// Return the object value of a property, or null if it is missing
+static const LV2_Atom_Object*
+get_object(const LV2_Atom_Object* const object, const LV2_URID key)
+{
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(&object->body);
+       !lv2_atom_object_is_end(&object->body, object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    if (p->key == key) {
+      return (const LV2_Atom_Object*)&p->value;
+    }
+  }
+
+  return NULL;
+}
+
+static unsigned
+count_properties(const LV2_Atom_Object* const object)
+{
+  unsigned n = 0U;
+  for (const LV2_Atom_Property_Body* p = lv2_atom_object_begin(&object->body);
+       !lv2_atom_object_is_end(&object->body, object->atom.size, p);
+       p = lv2_atom_object_next(p)) {
+    ++n;
+  }
+
+  return n;
+}
+
+/// Forge {a: 1, b: "x", c: 2.0}
+static void
+forge_old(Fixture* const f, LV2_Atom* const buf, const size_t size)
+{
+  LV2_Atom_Forge_Frame frame;
+  set_buffer(f, buf, size);
+  lv2_atom_forge_object(&f->forge, &frame, f->eg_obj, f->eg_Type);
+  lv2_atom_forge_key(&f->forge, f->eg_a);
+  lv2_atom_forge_int(&f->forge, 1);
+  lv2_atom_forge_key(&f->forge, f->eg_b);
+  lv2_atom_forge_string(&f->forge, "x", 1U);
+  lv2_atom_forge_key(&f->forge, f->eg_c);
+  lv2_atom_forge_double(&f->forge, 2.0);
+  lv2_atom_forge_pop(&f->forge, &frame);
+}
+
+/// Forge {a: 1, c: 2.0, b: "y", d: true}
+static void
+forge_new(Fixture* const  f,
+          LV2_Atom* const buf,
+          const size_t    size,
+          const LV2_URID  otype)
+{
+  LV2_Atom_Forge_Frame frame;
+  set_buffer(f, buf, size);
+  lv2_atom_forge_object(&f->forge, &frame, f->eg_obj, otype);
+  lv2_atom_forge_key(&f->forge, f->eg_a);
+  lv2_atom_forge_int(&f->forge, 1);
+  lv2_atom_forge_key(&f->forge, f->eg_c);
+  lv2_atom_forge_double(&f->forge, 2.0);
+  lv2_atom_forge_key(&f->forge, f->eg_b);
+  lv2_atom_forge_string(&f->forge, "y", 1U);
+  lv2_atom_forge_key(&f->forge, f->eg_d);
+  lv2_atom_forge_bool(&f->forge, true);
+  lv2_atom_forge_pop(&f->forge, &frame);
+}
+
+static void
+test_forge_delta(void)
+{
+  Fixture f;
+  setup(&f);
+
+  LV2_Atom old_object[64];
+  LV2_Atom new_object[64];
+  LV2_Atom patch[64];
+  LV2_Atom result[64];
+  forge_old(&f, old_object, sizeof(old_object));
+  forge_new(&f, new_object, sizeof(new_object), f.eg_Type);
+
+  // Only the changed and added properties are in the patch
+  set_buffer(&f, patch, sizeof(patch));
+  assert(sratom_forge_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            (const LV2_Atom_Object*)new_object));
+
+  const LV2_Atom_Object* const obj = (const LV2_Atom_Object*)patch;
+  assert(obj->body.otype == f.patch_Patch);
+
+  const LV2_Atom_Object* const remove = get_object(obj, f.patch_remove);
+  const LV2_Atom_Object* const add    = get_object(obj, f.patch_add);
+  assert(remove);
+  assert(add);
+  assert(!remove->body.otype);
+  assert(!add->body.otype);
+  assert(count_properties(remove) == 1U);
+  assert(count_properties(add) == 2U);
+
+  const LV2_Atom_URID* const subject =
+    (const LV2_Atom_URID*)get_object(obj, f.patch_subject);
+  assert(subject);
+  assert(subject->atom.type == f.forge.URID);
+  assert(subject->body == f.eg_obj);
+
+  // Applying the patch to the old object gives the new one
+  set_buffer(&f, result, sizeof(result));
+  assert(sratom_apply_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            obj));
+  assert(lv2_atom_equals(result, new_object));
+
+  // The result doesn't fit in a smaller buffer
+  set_buffer(&f, result, lv2_atom_total_size(new_object) - 8U);
+  assert(!sratom_apply_delta(f.sratom,
+                             &f.forge,
+                             (const LV2_Atom_Object*)old_object,
+                             obj));
+  assert(!f.forge.stack);
+
+  // The patch doesn't fit in a smaller buffer either
+  set_buffer(&f, result, lv2_atom_total_size((const LV2_Atom*)patch) - 8U);
+  assert(!sratom_forge_delta(f.sratom,
+                             &f.forge,
+                             (const LV2_Atom_Object*)old_object,
+                             (const LV2_Atom_Object*)new_object));
+  assert(!f.forge.stack);
+
+  teardown(&f);
+}
+
+static void
+test_unchanged(void)
+{
+  Fixture f;
+  setup(&f);
+
+  LV2_Atom object[144];
+  LV2_Atom patch[64];
+  LV2_Atom result[144];
+  set_buffer(&f, object, sizeof(object));
+  forge_test_object(&f.forge, &f.map, &f.uris, f.eg_obj);
+
+  // The patch for an unchanged object is empty
+  set_buffer(&f, patch, sizeof(patch));
+  assert(sratom_forge_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)object,
+                            (const LV2_Atom_Object*)object));
+
+  const LV2_Atom_Object* const obj = (const LV2_Atom_Object*)patch;
+  assert(!count_properties(get_object(obj, f.patch_remove)));
+  assert(!count_properties(get_object(obj, f.patch_add)));
+
+  // Applying it gives the same object
+  set_buffer(&f, result, sizeof(result));
+  assert(sratom_apply_delta(
+    f.sratom, &f.forge, (const LV2_Atom_Object*)object, obj));
+  assert(lv2_atom_equals(result, object));
+
+  teardown(&f);
+}
+
+static void
+test_changed_type(void)
+{
+  Fixture f;
+  setup(&f);
+
+  LV2_Atom old_object[64];
+  LV2_Atom new_object[64];
+  LV2_Atom patch[64];
+  LV2_Atom result[64];
+  forge_old(&f, old_object, sizeof(old_object));
+  forge_new(&f, new_object, sizeof(new_object), f.eg_OtherType);
+
+  set_buffer(&f, patch, sizeof(patch));
+  assert(sratom_forge_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            (const LV2_Atom_Object*)new_object));
+
+  const LV2_Atom_Object* const obj = (const LV2_Atom_Object*)patch;
+  assert(get_object(obj, f.patch_remove)->body.otype == f.eg_Type);
+  assert(get_object(obj, f.patch_add)->body.otype == f.eg_OtherType);
+
+  set_buffer(&f, result, sizeof(result));
+  assert(sratom_apply_delta(
+    f.sratom, &f.forge, (const LV2_Atom_Object*)old_object, obj));
+  assert(lv2_atom_equals(result, new_object));
+
+  teardown(&f);
+}
+
+static void
+test_repeated_keys(void)
+{
+  Fixture f;
+  setup(&f);
+
+  // Old has two equal properties and new has one, so one is removed
+  LV2_Atom             old_object[64];
+  LV2_Atom_Forge_Frame frame;
+  set_buffer(&f, old_object, sizeof(old_object));
+  lv2_atom_forge_object(&f.forge, &frame, 0U, 0U);
+  lv2_atom_forge_key(&f.forge, f.eg_a);
+  lv2_atom_forge_int(&f.forge, 1);
+  lv2_atom_forge_key(&f.forge, f.eg_a);
+  lv2_atom_forge_int(&f.forge, 1);
+  lv2_atom_forge_key(&f.forge, f.eg_a);
+  lv2_atom_forge_int(&f.forge, 2);
+  lv2_atom_forge_pop(&f.forge, &frame);
+
+  LV2_Atom new_object[64];
+  set_buffer(&f, new_object, sizeof(new_object));
+  lv2_atom_forge_object(&f.forge, &frame, 0U, 0U);
+  lv2_atom_forge_key(&f.forge, f.eg_a);
+  lv2_atom_forge_int(&f.forge, 1);
+  lv2_atom_forge_key(&f.forge, f.eg_a);
+  lv2_atom_forge_int(&f.forge, 2);
+  lv2_atom_forge_pop(&f.forge, &frame);
+
+  LV2_Atom patch[64];
+  set_buffer(&f, patch, sizeof(patch));
+  assert(sratom_forge_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            (const LV2_Atom_Object*)new_object));
+
+  const LV2_Atom_Object* const obj = (const LV2_Atom_Object*)patch;
+  assert(!get_object(obj, f.patch_subject));
+  assert(count_properties(get_object(obj, f.patch_remove)) == 1U);
+  assert(!count_properties(get_object(obj, f.patch_add)));
+
+  LV2_Atom result[64];
+  set_buffer(&f, result, sizeof(result));
+  assert(sratom_apply_delta(
+    f.sratom, &f.forge, (const LV2_Atom_Object*)old_object, obj));
+  assert(lv2_atom_equals(result, new_object));
+
+  teardown(&f);
+}
+
+static void
+test_wildcard(void)
+{
+  Fixture f;
+  setup(&f);
+
+  LV2_Atom old_object[64];
+  forge_old(&f, old_object, sizeof(old_object));
+
+  // Remove every value of eg:b and eg:c, and add eg:d
+  LV2_Atom             patch[64];
+  LV2_Atom_Forge_Frame patch_frame;
+  LV2_Atom_Forge_Frame frame;
+  set_buffer(&f, patch, sizeof(patch));
+  lv2_atom_forge_object(&f.forge, &patch_frame, 0U, f.patch_Patch);
+  lv2_atom_forge_key(&f.forge, f.patch_remove);
+  lv2_atom_forge_object(&f.forge, &frame, 0U, 0U);
+  lv2_atom_forge_key(&f.forge, f.eg_b);
+  lv2_atom_forge_urid(&f.forge, f.patch_wildcard);
+  lv2_atom_forge_key(&f.forge, f.eg_c);
+  lv2_atom_forge_urid(&f.forge, f.patch_wildcard);
+  lv2_atom_forge_pop(&f.forge, &frame);
+  lv2_atom_forge_key(&f.forge, f.patch_add);
+  lv2_atom_forge_object(&f.forge, &frame, 0U, 0U);
+  lv2_atom_forge_key(&f.forge, f.eg_d);
+  lv2_atom_forge_bool(&f.forge, true);
+  lv2_atom_forge_pop(&f.forge, &frame);
+  lv2_atom_forge_pop(&f.forge, &patch_frame);
+
+  LV2_Atom result[64];
+  set_buffer(&f, result, sizeof(result));
+  assert(sratom_apply_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            (const LV2_Atom_Object*)patch));
+
+  const LV2_Atom_Object* const obj = (const LV2_Atom_Object*)result;
+  assert(obj->body.id == f.eg_obj);
+  assert(obj->body.otype == f.eg_Type);
+  assert(count_properties(obj) == 2U);
+  assert(get_object(obj, f.eg_a));
+  assert(get_object(obj, f.eg_d));
+
+  teardown(&f);
+}
+
+static void
+test_bad_patch(void)
+{
+  Fixture f;
+  setup(&f);
+
+  LV2_Atom old_object[64];
+  forge_old(&f, old_object, sizeof(old_object));
+
+  LV2_Atom result[64];
+
+  // An object that isn't a patch
+  set_buffer(&f, result, sizeof(result));
+  assert(!sratom_apply_delta(f.sratom,
+                             &f.forge,
+                             (const LV2_Atom_Object*)old_object,
+                             (const LV2_Atom_Object*)old_object));
+
+  // A patch:add that isn't an object
+  LV2_Atom             patch[64];
+  LV2_Atom_Forge_Frame frame;
+  set_buffer(&f, patch, sizeof(patch));
+  lv2_atom_forge_object(&f.forge, &frame, 0U, f.patch_Patch);
+  lv2_atom_forge_key(&f.forge, f.patch_add);
+  lv2_atom_forge_int(&f.forge, 1);
+  lv2_atom_forge_pop(&f.forge, &frame);
+
+  set_buffer(&f, result, sizeof(result));
+  assert(!sratom_apply_delta(f.sratom,
+                             &f.forge,
+                             (const LV2_Atom_Object*)old_object,
+                             (const LV2_Atom_Object*)patch));
+
+  // Something that isn't an object
+  const LV2_Atom_Int number = {{sizeof(int32_t), f.forge.Int}, 1};
+  set_buffer(&f, result, sizeof(result));
+  assert(!sratom_forge_delta(f.sratom,
+                             &f.forge,
+                             (const LV2_Atom_Object*)old_object,
+                             (const LV2_Atom_Object*)&number));
+
+  teardown(&f);
+}
+
+typedef struct {
+  unsigned n_statements;
+} StatementCounter;
+
+static SerdStatus
+count_statement(void* const              handle,
+                const SerdStatementFlags flags,
+                const SerdNode* const    graph,
+                const SerdNode* const    subject,
+                const SerdNode* const    predicate,
+                const SerdNode* const    object,
+                const SerdNode* const    object_datatype,
+                const SerdNode* const    object_lang)
+{
+  (void)flags;
+  (void)graph;
+  (void)subject;
+  (void)predicate;
+  (void)object;
+  (void)object_datatype;
+  (void)object_lang;
+
+  ++((StatementCounter*)handle)->n_statements;
+  return SERD_SUCCESS;
+}
+
+static void
+test_write_delta(void)
+{
+  Fixture f;
+  setup(&f);
+
+  LV2_Atom old_object[64];
+  LV2_Atom new_object[64];
+  forge_old(&f, old_object, sizeof(old_object));
+  forge_new(&f, new_object, sizeof(new_object), f.eg_Type);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "change"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  // Writing is the same as writing the forged patch
+  StatementCounter counter = {0U};
+  sratom_set_sink(f.sratom, NULL, count_statement, NULL, &counter);
+  assert(!sratom_write_delta(f.sratom,
+                             &f.unmap,
+                             0U,
+                             &s,
+                             &p,
+                             (const LV2_Atom_Object*)old_object,
+                             (const LV2_Atom_Object*)new_object));
+
+  LV2_Atom patch[64];
+  set_buffer(&f, patch, sizeof(patch));
+  assert(sratom_forge_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            (const LV2_Atom_Object*)new_object));
+
+  const unsigned n_statements = counter.n_statements;
+  assert(n_statements);
+  counter.n_statements = 0U;
+  assert(!sratom_write(f.sratom,
+                       &f.unmap,
+                       0U,
+                       &s,
+                       &p,
+                       patch->type,
+                       patch->size,
+                       LV2_ATOM_BODY(patch)));
+  assert(counter.n_statements == n_statements);
+
+  // A patch read back from Turtle can be applied
+  char* const ttl = sratom_to_turtle(f.sratom,
+                                     &f.unmap,
+                                     NS_EG,
+                                     &s,
+                                     &p,
+                                     patch->type,
+                                     patch->size,
+                                     LV2_ATOM_BODY(patch));
+  assert(ttl);
+
+  LV2_Atom* const parsed = sratom_from_turtle(f.sratom, NS_EG, &s, &p, ttl);
+  assert(parsed);
+
+  LV2_Atom result[64];
+  set_buffer(&f, result, sizeof(result));
+  assert(sratom_apply_delta(f.sratom,
+                            &f.forge,
+                            (const LV2_Atom_Object*)old_object,
+                            (const LV2_Atom_Object*)parsed));
+  assert(lv2_atom_equals(result, new_object));
+
+  free(parsed);
+  free(ttl);
+  teardown(&f);
+}
+
+int
+main(void)
+{
+  test_forge_delta();
+  test_unchanged();
+  test_changed_type();
+  test_repeated_keys();
+  test_wildcard();
+  test_bad_patch();
+  test_write_delta();
+  return 0;
+}
@@ -0,0 +1,913 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#undef NDEBUG
+
+#include "test_uri_map.h"
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/atom/util.h>
+#include <lv2/midi/midi.h>
+#include <lv2/urid/urid.h>
+#include <serd/serd.h>
+#include <sord/sord.h>
+#include <sratom/sratom.h>
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_EG "http://example.org/"
+
+#define USTR(s) ((const uint8_t*)(s))
+
+static void
+check_read(const char* const     ttl,
+           const LV2_Atom* const expected,
+           LV2_URID_Map* const   map)
+{
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  Sratom* const   sratom = sratom_new(map);
+  LV2_Atom* const atom   = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+
+  assert(atom);
+  assert(lv2_atom_equals(atom, expected));
+
+  free(atom);
+  sratom_free(sratom);
+}
+
+// Not written by sratom, so read by loading the document into a model
+static void
+test_named_blank(void)
+{
+  Uris         uris = {NULL, 0};
+  LV2_URID_Map map  = {&uris, urid_map};
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[8];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  lv2_atom_forge_int(&forge, 1);
+  lv2_atom_forge_bool(&forge, true);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  check_read("@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+             "@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n"
+             "<http://example.org/s> <http://example.org/p> _:t .\n"
+             "_:t a atom:Tuple ; rdf:value ( 1 true ) .\n",
+             buf,
+             &map);
+
+  free_uris(&uris);
+}
+
+// Long lists are read without recursing for every element
+static void
+test_long_list(void)
+{
+  static const unsigned n_elems = 100000U;
+
+  Uris           uris = {NULL, 0};
+  LV2_URID_Map   map  = {&uris, urid_map};
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, &map);
+
+  static const char* const head =
+    "@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+    "@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n"
+    "<http://example.org/s> <http://example.org/p> _:t .\n"
+    "_:t a atom:Tuple ; rdf:value (";
+
+  const size_t len = strlen(head);
+  char* const  ttl = (char*)calloc(1, len + (n_elems * 8U) + 8U);
+  char*        end = ttl + len;
+  memcpy(ttl, head, len);
+  for (unsigned i = 0U; i < n_elems; ++i) {
+    end += sprintf(end, " %u", i);
+  }
+  memcpy(end, " ) .\n", 6);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  Sratom* const   sratom = sratom_new(&map);
+  LV2_Atom* const atom   = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+  assert(atom);
+  assert(atom->type == forge.Tuple);
+
+  int32_t n = 0;
+  LV2_ATOM_TUPLE_FOREACH ((const LV2_Atom_Tuple*)atom, i) {
+    assert(((const LV2_Atom_Int*)i)->body == n++);
+  }
+  assert(n == (int32_t)n_elems);
+  free(atom);
+
+  // A cyclic list is read until the number of statements is exhausted
+  LV2_Atom* const cyclic =
+    sratom_from_turtle(sratom,
+                       NS_EG,
+                       &s,
+                       &p,
+                       "@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+                       "@prefix rdf: "
+                       "<http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n"
+                       "<http://example.org/s> <http://example.org/p> _:t .\n"
+                       "_:t a atom:Tuple ; rdf:value _:c .\n"
+                       "_:c rdf:first 1 ; rdf:rest _:c .\n");
+  assert(cyclic);
+  assert(cyclic->type == forge.Tuple);
+  free(cyclic);
+
+  sratom_free(sratom);
+  free(ttl);
+  free_uris(&uris);
+}
+
+// Properties of anonymous nodes are read in document order
+static void
+test_property_order(void)
+{
+  Uris           uris    = {NULL, 0};
+  LV2_URID_Map   map     = {&uris, urid_map};
+  const LV2_URID eg_a    = urid_map(&uris, NS_EG "a");
+  const LV2_URID eg_b    = urid_map(&uris, NS_EG "b");
+  const LV2_URID eg_Type = urid_map(&uris, NS_EG "Type");
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[8];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_object(&forge, &frame, 0, eg_Type);
+  lv2_atom_forge_key(&forge, eg_b);
+  lv2_atom_forge_string(&forge, "b", 1);
+  lv2_atom_forge_key(&forge, eg_a);
+  lv2_atom_forge_string(&forge, "a", 1);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  check_read("@prefix eg: <http://example.org/> .\n"
+             "eg:s eg:p [ a eg:Type ; eg:b \"b\" ; eg:a \"a\" ] .\n",
+             buf,
+             &map);
+
+  free_uris(&uris);
+}
+
+static void
+test_datatypes(void)
+{
+  Uris           uris    = {NULL, 0};
+  LV2_URID_Map   map     = {&uris, urid_map};
+  const LV2_URID eg_Type = urid_map(&uris, NS_EG "Type");
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[8];
+  lv2_atom_forge_init(&forge, &map);
+
+  // Integers and decimals are read as the corresponding atom types
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_int(&forge, 42);
+  check_read("@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n"
+             "<s> <p> \"42\"^^xsd:integer .\n",
+             buf,
+             &map);
+
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_float(&forge, 1.5f);
+  check_read("<s> <p> 1.5 .\n", buf, &map);
+
+  // Other datatypes are read as literals, even with a similar URI
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_literal(&forge, "42", 2, eg_Type, 0);
+  check_read("<s> <p> \"42\"^^<Type> .\n", buf, &map);
+
+  const LV2_URID xsd_in =
+    urid_map(&uris, "http://www.w3.org/2001/XMLSchema#in");
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_literal(&forge, "42", 2, xsd_in, 0);
+  check_read("@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n"
+             "<s> <p> \"42\"^^xsd:in .\n",
+             buf,
+             &map);
+
+  free_uris(&uris);
+}
+
+static void
+test_midi(void)
+{
+  Uris           uris           = {NULL, 0};
+  LV2_URID_Map   map            = {&uris, urid_map};
+  LV2_URID_Unmap unmap          = {&uris, urid_unmap};
+  const LV2_URID midi_MidiEvent = urid_map(&uris, LV2_MIDI__MidiEvent);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  // A long SysEx message with every byte value
+  uint8_t sysex[258];
+  sysex[0] = 0xF0;
+  for (unsigned i = 0U; i < 256U; ++i) {
+    sysex[i + 1U] = (uint8_t)i;
+  }
+  sysex[257] = 0xF7;
+
+  Sratom* const sratom = sratom_new(&map);
+  char* const   ttl    = sratom_to_turtle(
+    sratom, &unmap, NS_EG, &s, &p, midi_MidiEvent, sizeof(sysex), sysex);
+
+  assert(ttl);
+  assert(strstr(ttl, "\"F000010203"));
+
+  LV2_Atom* const atom = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+  assert(atom);
+  assert(atom->type == midi_MidiEvent);
+  assert(atom->size == sizeof(sysex));
+  assert(!memcmp(LV2_ATOM_BODY(atom), sysex, sizeof(sysex)));
+  free(atom);
+  free(ttl);
+
+  // Lower case digits are accepted
+  const uint8_t   note_on[] = {0x90, 0x3C, 0x7F};
+  LV2_Atom* const lower     = sratom_from_turtle(
+    sratom,
+    NS_EG,
+    &s,
+    &p,
+    "<s> <p> \"903c7f\"^^<http://lv2plug.in/ns/ext/midi#MidiEvent> .\n");
+
+  assert(lower);
+  assert(lower->type == midi_MidiEvent);
+  assert(lower->size == sizeof(note_on));
+  assert(!memcmp(LV2_ATOM_BODY(lower), note_on, sizeof(note_on)));
+  free(lower);
+  sratom_free(sratom);
+
+  // Invalid hex is read as a literal rather than decoded
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[8];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_literal(&forge, "90XY7F", 6, midi_MidiEvent, 0);
+  check_read(
+    "<s> <p> \"90XY7F\"^^<http://lv2plug.in/ns/ext/midi#MidiEvent> .\n",
+    buf,
+    &map);
+
+  free_uris(&uris);
+}
+
+static void
+test_base64(void)
+{
+  Uris           uris       = {NULL, 0};
+  LV2_URID_Map   map        = {&uris, urid_map};
+  LV2_URID_Unmap unmap      = {&uris, urid_unmap};
+  const LV2_URID atom_Chunk = urid_map(&uris, LV2_ATOM__Chunk);
+  const LV2_URID atom_Int   = urid_map(&uris, LV2_ATOM__Int);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  // A chunk long enough to be written on several lines
+  uint8_t chunk[1000];
+  for (unsigned i = 0U; i < sizeof(chunk); ++i) {
+    chunk[i] = (uint8_t)((i * 7U) + (i >> 8U));
+  }
+
+  Sratom* const sratom = sratom_new(&map);
+  char* const   ttl    = sratom_to_turtle(
+    sratom, &unmap, NS_EG, &s, &p, atom_Chunk, sizeof(chunk), chunk);
+
+  assert(ttl);
+  assert(strchr(strstr(ttl, "\"\"\""), '\n'));
+
+  LV2_Atom* const atom = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+  assert(atom);
+  assert(atom->type == atom_Chunk);
+  assert(atom->size == sizeof(chunk));
+  assert(!memcmp(LV2_ATOM_BODY(atom), chunk, sizeof(chunk)));
+  free(atom);
+  free(ttl);
+  sratom_free(sratom);
+
+  // Whitespace and padding are ignored
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[8];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_atom(&forge, 5U, atom_Chunk);
+  lv2_atom_forge_write(&forge, "hello", 5U);
+  check_read("<s> <p> \"aGVs\\nbG8=\"^^"
+             "<http://www.w3.org/2001/XMLSchema#base64Binary> .\n",
+             buf,
+             &map);
+
+  // Trailing bytes that don't make a whole vector element are dropped
+  const int32_t elems[] = {0x01010101, 0x02020202};
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_vector(&forge, sizeof(int32_t), atom_Int, 2U, elems);
+  check_read("<s> <p> [\n"
+             "  a <http://lv2plug.in/ns/ext/atom#Vector> ;\n"
+             "  <http://lv2plug.in/ns/ext/atom#childType> "
+             "<http://lv2plug.in/ns/ext/atom#Int> ;\n"
+             "  <http://www.w3.org/1999/02/22-rdf-syntax-ns#value> "
+             "\"AQEBAQICAgID\"^^"
+             "<http://www.w3.org/2001/XMLSchema#base64Binary>\n"
+             "] .\n",
+             buf,
+             &map);
+
+  // A text vector is truncated before an invalid element
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_vector(&forge, sizeof(int32_t), atom_Int, 2U, elems);
+  check_read("<s> <p> [\n"
+             "  a <http://lv2plug.in/ns/ext/atom#Vector> ;\n"
+             "  <http://lv2plug.in/ns/ext/atom#childType> "
+             "<http://lv2plug.in/ns/ext/atom#Int> ;\n"
+             "  <http://www.w3.org/1999/02/22-rdf-syntax-ns#value> "
+             "\"16843009 33686018 3x 4\"\n"
+             "] .\n",
+             buf,
+             &map);
+
+  free_uris(&uris);
+}
+
+static void
+test_compact_sequence(void)
+{
+  Uris           uris           = {NULL, 0};
+  LV2_URID_Map   map            = {&uris, urid_map};
+  LV2_URID_Unmap unmap          = {&uris, urid_unmap};
+  const LV2_URID atom_beatTime  = urid_map(&uris, LV2_ATOM__beatTime);
+  const LV2_URID midi_MidiEvent = urid_map(&uris, LV2_MIDI__MidiEvent);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[64];
+  lv2_atom_forge_init(&forge, &map);
+
+  // Frame times are written as differences from the previous event
+  LV2_Atom_Forge_Frame frame;
+  const float          values[] = {0.5f, 1.5f, -2.0f};
+  const int64_t        times[]  = {10, 20, 25};
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_sequence_head(&forge, &frame, 0);
+  for (unsigned i = 0U; i < 3U; ++i) {
+    lv2_atom_forge_frame_time(&forge, times[i]);
+    lv2_atom_forge_float(&forge, values[i]);
+  }
+  lv2_atom_forge_pop(&forge, &frame);
+
+  Sratom* const sratom = sratom_new(&map);
+  sratom_set_sequence_encoding(sratom, SRATOM_SEQUENCE_ENCODING_COMPACT);
+
+  char* const ttl = sratom_to_turtle(
+    sratom, &unmap, NS_EG, &s, &p, buf->type, buf->size, LV2_ATOM_BODY(buf));
+
+  assert(ttl);
+  assert(strstr(ttl, "\"10 0.5 10 1.5 5 -2.0\""));
+  assert(strstr(ttl, "<http://lv2plug.in/ns/extensions/units#frame>"));
+
+  LV2_Atom* const atom = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+  assert(atom);
+  assert(lv2_atom_equals(atom, buf));
+  free(atom);
+  free(ttl);
+
+  // A MIDI recording is much smaller than as a list
+  LV2_Atom recording[256];
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)recording, sizeof(recording));
+  lv2_atom_forge_sequence_head(&forge, &frame, 0);
+  for (unsigned i = 0U; i < 64U; ++i) {
+    const uint8_t note[] = {0x90, (uint8_t)i, 0x40};
+    lv2_atom_forge_frame_time(&forge, (int64_t)i * 96);
+    lv2_atom_forge_atom(&forge, sizeof(note), midi_MidiEvent);
+    lv2_atom_forge_write(&forge, note, sizeof(note));
+  }
+  lv2_atom_forge_pop(&forge, &frame);
+
+  char* const compact = sratom_to_turtle(sratom,
+                                         &unmap,
+                                         NS_EG,
+                                         &s,
+                                         &p,
+                                         recording->type,
+                                         recording->size,
+                                         LV2_ATOM_BODY(recording));
+
+  sratom_set_sequence_encoding(sratom, SRATOM_SEQUENCE_ENCODING_LIST);
+  char* const list = sratom_to_turtle(sratom,
+                                      &unmap,
+                                      NS_EG,
+                                      &s,
+                                      &p,
+                                      recording->type,
+                                      recording->size,
+                                      LV2_ATOM_BODY(recording));
+
+  assert(compact);
+  assert(list);
+  assert(strstr(compact, "\"0 900040 96 900140 96 900240"));
+  assert(strlen(compact) * 8U < strlen(list));
+
+  LV2_Atom* const parsed = sratom_from_turtle(sratom, NS_EG, &s, &p, compact);
+  assert(parsed);
+  assert(lv2_atom_equals(parsed, recording));
+  free(parsed);
+  free(list);
+  free(compact);
+  sratom_free(sratom);
+
+  // Reading stops at the first invalid event
+  const uint8_t note_on[] = {0x90, 0x3C, 0x7F};
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_sequence_head(&forge, &frame, atom_beatTime);
+  lv2_atom_forge_beat_time(&forge, 1.0);
+  lv2_atom_forge_atom(&forge, sizeof(note_on), midi_MidiEvent);
+  lv2_atom_forge_write(&forge, note_on, sizeof(note_on));
+  lv2_atom_forge_pop(&forge, &frame);
+  check_read("<s> <p> [\n"
+             "  a <http://lv2plug.in/ns/ext/atom#Sequence> ;\n"
+             "  <http://lv2plug.in/ns/ext/atom#childType> "
+             "<http://lv2plug.in/ns/ext/midi#MidiEvent> ;\n"
+             "  <http://lv2plug.in/ns/ext/atom#timeUnit> "
+             "<http://lv2plug.in/ns/extensions/units#beat> ;\n"
+             "  <http://www.w3.org/1999/02/22-rdf-syntax-ns#value> "
+             "\"1.0 903c7f 2.5 80XX00 3.0 803C00\"\n"
+             "] .\n",
+             buf,
+             &map);
+
+  free_uris(&uris);
+}
+
+static void
+test_numbers(void)
+{
+  Uris           uris  = {NULL, 0};
+  LV2_URID_Map   map   = {&uris, urid_map};
+  LV2_URID_Unmap unmap = {&uris, urid_unmap};
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  static const double doubles[] = {
+    0.1 + 0.2, 1.0e23, 5.0e-324, DBL_MAX, -DBL_MIN, 123456789.125, -0.0};
+
+  static const float floats[] = {
+    0.1f, 16777216.0f, 1.0e-45f, FLT_MAX, -FLT_MIN, 3.4028235e38f};
+
+  Sratom* const sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[64];
+  lv2_atom_forge_init(&forge, &map);
+
+  // Every value reads back exactly, in both lists and text vectors
+  for (unsigned e = 0U; e < 2U; ++e) {
+    sratom_set_vector_encoding(sratom,
+                               e ? SRATOM_VECTOR_ENCODING_TEXT
+                                 : SRATOM_VECTOR_ENCODING_LIST);
+
+    LV2_Atom_Forge_Frame frame;
+    lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+    lv2_atom_forge_tuple(&forge, &frame);
+    lv2_atom_forge_vector(&forge,
+                          sizeof(double),
+                          forge.Double,
+                          sizeof(doubles) / sizeof(double),
+                          doubles);
+    lv2_atom_forge_vector(&forge,
+                          sizeof(float),
+                          forge.Float,
+                          sizeof(floats) / sizeof(float),
+                          floats);
+    lv2_atom_forge_pop(&forge, &frame);
+
+    char* const ttl = sratom_to_turtle(
+      sratom, &unmap, NS_EG, &s, &p, buf->type, buf->size, LV2_ATOM_BODY(buf));
+
+    assert(ttl);
+
+    LV2_Atom* const atom = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+    assert(atom);
+    assert(lv2_atom_equals(atom, buf));
+    free(atom);
+    free(ttl);
+  }
+
+  sratom_free(sratom);
+
+  // Numbers are parsed regardless of spelling
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_double(&forge, 1500.0);
+  check_read("<s> <p> \"+1.5e3\"^^"
+             "<http://www.w3.org/2001/XMLSchema#double> .\n",
+             buf,
+             &map);
+
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_float(&forge, (float)INFINITY);
+  check_read("<s> <p> \"INF\"^^"
+             "<http://www.w3.org/2001/XMLSchema#float> .\n",
+             buf,
+             &map);
+
+  free_uris(&uris);
+}
+
+static void
+test_bad_syntax(void)
+{
+  Uris         uris   = {NULL, 0};
+  LV2_URID_Map map    = {&uris, urid_map};
+  Sratom*      sratom = sratom_new(&map);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  assert(!sratom_from_turtle(sratom, NS_EG, &s, &p, "<http://example.org/s"));
+
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_reader(void)
+{
+  Uris           uris = {NULL, 0};
+  LV2_URID_Map   map  = {&uris, urid_map};
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, &map);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  Sratom* const       sratom = sratom_new(&map);
+  SratomReader* const reader = sratom_reader_new(sratom);
+  assert(reader);
+
+  // Read several documents with the same reader, including a bad one
+  for (int32_t i = 0; i < 4; ++i) {
+    char ttl[64];
+    snprintf(ttl, sizeof(ttl), "<s> <p> %d .\n", i);
+    if (i == 2) {
+      assert(!sratom_reader_read_string(reader, NS_EG, &s, &p, "<s> <p"));
+    }
+
+    LV2_Atom* const atom =
+      sratom_reader_read_string(reader, NS_EG, &s, &p, ttl);
+
+    assert(atom);
+    assert(atom->type == forge.Int);
+    assert(((const LV2_Atom_Int*)atom)->body == i);
+    free(atom);
+  }
+
+  sratom_reader_free(reader);
+
+  // A reader copies the environment, so documents don't add prefixes to it
+  SerdEnv* const env = serd_env_new(NULL);
+  serd_env_set_prefix_from_strings(env, USTR("eg"), USTR(NS_EG));
+  sratom_set_env(sratom, env);
+
+  SratomReader* const env_reader = sratom_reader_new(sratom);
+  assert(env_reader);
+
+  static const char* const docs[] = {
+    "@prefix x: <http://example.org/> .\neg:s x:p 4 .\n",
+    "eg:s x:p 5 .\n",
+  };
+
+  for (int32_t i = 0; i < 2; ++i) {
+    LV2_Atom* const atom =
+      sratom_reader_read_string(env_reader, NS_EG, &s, &p, docs[i]);
+
+    assert(atom);
+    assert(atom->type == forge.Int);
+    assert(((const LV2_Atom_Int*)atom)->body == 4 + i);
+    free(atom);
+  }
+
+  const SerdNode x_p = serd_node_from_string(SERD_CURIE, USTR("x:p"));
+  assert(!serd_env_expand_node(env, &x_p).buf);
+
+  sratom_reader_free(env_reader);
+  sratom_free(sratom);
+  serd_env_free(env);
+  free_uris(&uris);
+}
+
+/// Write a string to a file and read it back with sratom_from_turtle_file()
+static LV2_Atom*
+read_file(Sratom* const          sratom,
+          const char* const      ttl,
+          SratomReadStats* const stats)
+{
+  static const char* const path = "sratom_test_read_file.ttl";
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  FILE* const  file = fopen(path, "wb");
+  const size_t len  = strlen(ttl);
+  assert(file);
+  assert(fwrite(ttl, 1U, len, file) == len);
+  assert(!fclose(file));
+
+  LV2_Atom* const atom =
+    sratom_from_turtle_file(sratom, NS_EG, &s, &p, path, stats);
+
+  assert(!remove(path));
+  return atom;
+}
+
+static void
+test_from_turtle_file(void)
+{
+  static const unsigned n_elems = 100000U;
+
+  Uris           uris = {NULL, 0};
+  LV2_URID_Map   map  = {&uris, urid_map};
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, &map);
+
+  // A document much larger than a page, which is read in a single pass
+  static const char* const head =
+    "@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+    "@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n"
+    "<http://example.org/s> <http://example.org/p> [\n"
+    "\ta atom:Tuple ;\n"
+    "\trdf:value (";
+
+  const size_t head_len = strlen(head);
+  char* const  ttl      = (char*)calloc(1, head_len + (n_elems * 8U) + 8U);
+  char*        end      = ttl + head_len;
+  memcpy(ttl, head, head_len);
+  for (unsigned i = 0U; i < n_elems; ++i) {
+    end += sprintf(end, " %u", i);
+  }
+  memcpy(end, " )\n] .\n", 8);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  Sratom* const   sratom   = sratom_new(&map);
+  LV2_Atom* const expected = sratom_from_turtle(sratom, NS_EG, &s, &p, ttl);
+  assert(expected);
+  assert(expected->type == forge.Tuple);
+
+  SratomReadStats stats = {0U, -1.0};
+  LV2_Atom* const atom  = read_file(sratom, ttl, &stats);
+  assert(atom);
+  assert(lv2_atom_equals(atom, expected));
+  assert(stats.n_bytes == strlen(ttl));
+  assert(stats.seconds >= 0.0);
+  free(atom);
+
+  // Statistics are optional
+  LV2_Atom* const quiet = read_file(sratom, ttl, NULL);
+  assert(quiet);
+  assert(lv2_atom_equals(quiet, expected));
+  free(quiet);
+
+  // Bad syntax
+  assert(!read_file(sratom, "<http://example.org/s", &stats));
+
+  // Missing file
+  assert(!sratom_from_turtle_file(
+    sratom, NS_EG, &s, &p, "sratom_test_missing.ttl", &stats));
+  assert(!stats.n_bytes);
+
+  // A document that needs a model is parsed twice
+  static const char* const named =
+    "@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+    "@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n"
+    "<http://example.org/s> <http://example.org/p> _:t .\n"
+    "_:t a atom:Tuple ; rdf:value ( 1 true ) .\n";
+
+  LV2_Atom* const tuple = read_file(sratom, named, &stats);
+  assert(tuple);
+  assert(tuple->type == forge.Tuple);
+  assert(stats.n_bytes == 2U * strlen(named));
+  free(tuple);
+
+  free(expected);
+  sratom_free(sratom);
+  free(ttl);
+  free_uris(&uris);
+}
+
+static LV2_Atom*
+read_model(Sratom* const         sratom,
+           LV2_URID_Map* const   map,
+           SordWorld* const      world,
+           SordModel* const      model,
+           const SordNode* const node)
+{
+  SratomForgeBuffer buffer;
+  assert(!sratom_forge_buffer_init(&buffer, 0U));
+
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, map);
+  lv2_atom_forge_set_sink(
+    &forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &buffer);
+
+  sratom_read(sratom, &forge, world, model, node);
+  assert(buffer.len);
+  return (LV2_Atom*)buffer.buf;
+}
+
+static void
+test_bind_world(void)
+{
+  Uris         uris = {NULL, 0};
+  LV2_URID_Map map  = {&uris, urid_map};
+
+  SordWorld* const  world  = sord_world_new();
+  SordModel* const  model  = sord_new(world, SORD_SPO, false);
+  SerdEnv* const    env    = serd_env_new(NULL);
+  SerdReader* const reader = sord_new_reader(model, env, SERD_TURTLE, NULL);
+  assert(!serd_reader_read_string(
+    reader,
+    USTR("@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n"
+         "<http://example.org/s> <http://example.org/p> [\n"
+         "  a <http://lv2plug.in/ns/ext/atom#Tuple> ;\n"
+         "  rdf:value ( 1 true )\n"
+         "] .\n")));
+
+  SordNode* const s    = sord_new_uri(world, USTR(NS_EG "s"));
+  SordNode* const p    = sord_new_uri(world, USTR(NS_EG "p"));
+  SordNode* const node = sord_get(model, s, p, NULL, NULL);
+  assert(node);
+
+  // Read without a bound world, then repeatedly with one
+  Sratom* const   sratom   = sratom_new(&map);
+  LV2_Atom* const expected = read_model(sratom, &map, world, model, node);
+
+  sratom_bind_world(sratom, world);
+  for (unsigned i = 0U; i < 2U; ++i) {
+    LV2_Atom* const atom = read_model(sratom, &map, world, model, node);
+    assert(lv2_atom_equals(atom, expected));
+    free(atom);
+  }
+
+  // Reading from another world doesn't disturb the bound nodes
+  SordWorld* const other = sord_world_new();
+  SordModel* const empty = sord_new(other, SORD_SPO, false);
+  SordNode* const  o     = sord_new_uri(other, USTR(NS_EG "o"));
+  free(read_model(sratom, &map, other, empty, o));
+  sord_node_free(other, o);
+  sord_free(empty);
+  sord_world_free(other);
+
+  LV2_Atom* const atom = read_model(sratom, &map, world, model, node);
+  assert(lv2_atom_equals(atom, expected));
+  free(atom);
+
+  sratom_unbind_world(sratom);
+  sratom_unbind_world(sratom);
+  sratom_free(sratom);
+
+  free(expected);
+  sord_node_free(world, node);
+  sord_node_free(world, p);
+  sord_node_free(world, s);
+  serd_reader_free(reader);
+  serd_env_free(env);
+  sord_free(model);
+  sord_world_free(world);
+  free_uris(&uris);
+}
+
+static void
+test_urid_cache(void)
+{
+  Uris         uris = {NULL, 0};
+  LV2_URID_Map map  = {&uris, urid_map};
+
+  SordWorld* const  world  = sord_world_new();
+  SordModel* const  model  = sord_new(world, SORD_SPO, false);
+  SerdEnv* const    env    = serd_env_new(NULL);
+  SerdReader* const reader = sord_new_reader(model, env, SERD_TURTLE, NULL);
+  assert(!serd_reader_read_string(
+    reader,
+    USTR("@prefix eg: <http://example.org/> .\n"
+         "eg:s eg:p [ a eg:Type ; eg:a 1 , 2 ; eg:b eg:Type ;\n"
+         "  eg:c \"x\"@en , \"y\"@en ] .\n")));
+
+  SordNode* const s    = sord_new_uri(world, USTR(NS_EG "s"));
+  SordNode* const p    = sord_new_uri(world, USTR(NS_EG "p"));
+  SordNode* const node = sord_get(model, s, p, NULL, NULL);
+  assert(node);
+
+  Sratom* const sratom = sratom_new(&map);
+  assert(!sratom_urid_cache_stats(sratom).hits);
+  assert(!sratom_urid_cache_stats(sratom).misses);
+
+  // Each URI and the language is mapped once per read
+  for (unsigned i = 1U; i <= 2U; ++i) {
+    free(read_model(sratom, &map, world, model, node));
+
+    const SratomCacheStats stats = sratom_urid_cache_stats(sratom);
+    assert(stats.misses == 5U * i);
+    assert(stats.hits == 5U * i);
+  }
+
+  sratom_free(sratom);
+  sord_node_free(world, node);
+  sord_node_free(world, p);
+  sord_node_free(world, s);
+  serd_reader_free(reader);
+  serd_env_free(env);
+  sord_free(model);
+  sord_world_free(world);
+  free_uris(&uris);
+}
+
+static void
+test_forge_buffer(void)
+{
+  Uris           uris = {NULL, 0};
+  LV2_URID_Map   map  = {&uris, urid_map};
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, &map);
+
+  SratomForgeBuffer buffer;
+  assert(!sratom_forge_buffer_init(&buffer, 16U));
+  assert(buffer.cap >= 16U);
+  lv2_atom_forge_set_sink(
+    &forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &buffer);
+
+  // Forge a tuple much larger than the initial capacity
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  for (int32_t i = 0; i < 1000; ++i) {
+    lv2_atom_forge_int(&forge, i);
+  }
+  lv2_atom_forge_pop(&forge, &frame);
+
+  const LV2_Atom* const tuple = (const LV2_Atom*)buffer.buf;
+  assert(buffer.len == sizeof(LV2_Atom) + tuple->size);
+  assert(buffer.cap >= buffer.len);
+
+  int32_t n = 0;
+  LV2_ATOM_TUPLE_FOREACH ((const LV2_Atom_Tuple*)tuple, i) {
+    assert(((const LV2_Atom_Int*)i)->body == n++);
+  }
+  assert(n == 1000);
+
+  // Clearing keeps the memory for the next atom
+  const uint8_t* const buf = buffer.buf;
+  const size_t         cap = buffer.cap;
+  sratom_forge_buffer_clear(&buffer);
+  lv2_atom_forge_set_sink(
+    &forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &buffer);
+  lv2_atom_forge_string(&forge, "reused", strlen("reused"));
+  assert(buffer.buf == buf);
+  assert(buffer.cap == cap);
+  assert(!strcmp((const char*)LV2_ATOM_BODY(buffer.buf), "reused"));
+
+  sratom_forge_buffer_cleanup(&buffer);
+  assert(!buffer.buf);
+  assert(!buffer.len);
+  assert(!buffer.cap);
+  free_uris(&uris);
+}
+
+int
+main(void)
+{
+  test_named_blank();
+  test_long_list();
+  test_property_order();
+  test_datatypes();
+  test_midi();
+  test_base64();
+  test_compact_sequence();
+  test_numbers();
+  test_bad_syntax();
+  test_reader();
+  test_from_turtle_file();
+  test_bind_world();
+  test_urid_cache();
+  test_forge_buffer();
+  return 0;
+}
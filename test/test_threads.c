@@ -0,0 +1,485 @@
+// Copyright 2026 David Robillard <d@drobilla.net>
+// SPDX-License-Identifier: ISC
+
+#undef NDEBUG
+
+#include "forge_test_object.h"
+#include "test_uri_map.h"
+
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include <lv2/atom/util.h>
+#include <lv2/urid/urid.h>
+#include <serd/serd.h>
+#include <sord/sord.h>
+#include <sratom/sratom.h>
+
+#include <pthread.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS_EG "http://example.org/"
+#define NS_RDF "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+
+#define USTR(s) ((const uint8_t*)(s))
+
+#define N_THREADS 4U
+#define N_ITERATIONS 64U
+#define N_ENTRIES 37U
+#define N_SUBJECTS 29U
+
+static const char* const base_uri = "file:///tmp/base/";
+
+/// URI map shared by all threads, which must be thread-safe
+typedef struct {
+  pthread_mutex_t mutex;
+  Uris            uris;
+} SharedUris;
+
+/// Everything shared between the threads, which only read it
+typedef struct {
+  Sratom*         sratom;
+  LV2_URID_Map*   map;
+  LV2_URID_Unmap* unmap;
+  const LV2_Atom* atom;
+  const char*     turtle;
+  const LV2_Atom* tuple;
+} Shared;
+
+static LV2_URID
+shared_map(LV2_URID_Map_Handle handle, const char* uri)
+{
+  SharedUris* const shared = (SharedUris*)handle;
+
+  pthread_mutex_lock(&shared->mutex);
+  const LV2_URID urid = urid_map(&shared->uris, uri);
+  pthread_mutex_unlock(&shared->mutex);
+  return urid;
+}
+
+static const char*
+shared_unmap(LV2_URID_Unmap_Handle handle, LV2_URID urid)
+{
+  SharedUris* const shared = (SharedUris*)handle;
+
+  pthread_mutex_lock(&shared->mutex);
+  const char* const uri = urid_unmap(&shared->uris, urid);
+  pthread_mutex_unlock(&shared->mutex);
+  return uri;
+}
+
+static SerdStatus
+check_statement(void* const              handle,
+                const SerdStatementFlags flags,
+                const SerdNode* const    graph,
+                const SerdNode* const    subject,
+                const SerdNode* const    predicate,
+                const SerdNode* const    object,
+                const SerdNode* const    object_datatype,
+                const SerdNode* const    object_lang)
+{
+  (void)handle;
+  (void)flags;
+  (void)graph;
+  (void)object_datatype;
+  (void)object_lang;
+
+  assert(subject && subject->buf);
+  assert(predicate && predicate->buf);
+  assert(object && object->buf);
+  return SERD_SUCCESS;
+}
+
+static void*
+run(void* const arg)
+{
+  const Shared* const shared = (const Shared*)arg;
+  Sratom* const       sratom = shared->sratom;
+  const LV2_Atom*     atom   = shared->atom;
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  for (unsigned i = 0U; i < N_ITERATIONS; ++i) {
+    // Write to the shared sink
+    assert(!sratom_write(sratom,
+                         shared->unmap,
+                         0U,
+                         &s,
+                         &p,
+                         atom->type,
+                         atom->size,
+                         LV2_ATOM_BODY_CONST(atom)));
+
+    // Write to a string and read it back with the single-pass reader
+    char* const str = sratom_to_turtle(sratom,
+                                       shared->unmap,
+                                       base_uri,
+                                       &s,
+                                       &p,
+                                       atom->type,
+                                       atom->size,
+                                       LV2_ATOM_BODY_CONST(atom));
+
+    assert(str);
+    assert(!strcmp(str, shared->turtle));
+
+    LV2_Atom* const parsed = sratom_from_turtle(sratom, base_uri, &s, &p, str);
+    assert(parsed);
+    assert(lv2_atom_equals(parsed, atom));
+    free(parsed);
+    free(str);
+
+    // Read a document that needs a model
+    LV2_Atom* const tuple = sratom_from_turtle(
+      sratom,
+      base_uri,
+      &s,
+      &p,
+      "@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+      "<http://example.org/s> rdf:value _:t .\n"
+      "_:t a atom:Tuple ; rdf:value ( 1 true ) .\n");
+
+    assert(tuple);
+    assert(lv2_atom_equals(tuple, shared->tuple));
+    free(tuple);
+  }
+
+  return NULL;
+}
+
+static void
+test_concurrent(Shared* const shared)
+{
+  pthread_t threads[N_THREADS];
+  for (unsigned i = 0U; i < N_THREADS; ++i) {
+    assert(!pthread_create(&threads[i], NULL, run, shared));
+  }
+
+  for (unsigned i = 0U; i < N_THREADS; ++i) {
+    assert(!pthread_join(threads[i], NULL));
+  }
+}
+
+static void
+test_write_batch(const Shared* const shared)
+{
+  static const unsigned thread_counts[] = {0U, 1U, 2U, 3U, 8U, 64U};
+
+  const LV2_Atom* const atom = shared->atom;
+
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  // Write each entry separately for reference
+  char             uris[N_ENTRIES][32];
+  SerdNode         subjects[N_ENTRIES];
+  SratomBatchEntry entries[N_ENTRIES];
+  char*            expected[N_ENTRIES];
+  size_t           document_len = 0U;
+  for (unsigned i = 0U; i < N_ENTRIES; ++i) {
+    snprintf(uris[i], sizeof(uris[i]), NS_EG "s%u", i);
+    subjects[i] = serd_node_from_string(SERD_URI, USTR(uris[i]));
+
+    // Some entries have no subject and predicate, so the atom is the subject
+    const bool             anon    = !(i % 3U);
+    const SerdNode* const  subject = anon ? NULL : &subjects[i];
+    const SerdNode* const  pred    = anon ? NULL : &p;
+    const SratomBatchEntry entry   = {subject, pred, atom, NULL};
+    entries[i]                     = entry;
+
+    expected[i] = sratom_to_turtle(shared->sratom,
+                                   shared->unmap,
+                                   base_uri,
+                                   subject,
+                                   pred,
+                                   atom->type,
+                                   atom->size,
+                                   LV2_ATOM_BODY_CONST(atom));
+
+    assert(expected[i]);
+    document_len += strlen(expected[i]) + 1U;
+  }
+
+  // Join the reference strings into a document
+  char* const expected_document = (char*)calloc(document_len + 1U, 1U);
+  for (unsigned i = 0U; i < N_ENTRIES; ++i) {
+    if (i) {
+      strcat(expected_document, "\n");
+    }
+    strcat(expected_document, expected[i]);
+  }
+
+  for (size_t t = 0U; t < sizeof(thread_counts) / sizeof(unsigned); ++t) {
+    const unsigned n_threads = thread_counts[t];
+
+    // Write separate strings
+    assert(!sratom_write_batch(shared->sratom,
+                               shared->unmap,
+                               base_uri,
+                               n_threads,
+                               N_ENTRIES,
+                               entries,
+                               NULL));
+
+    for (unsigned i = 0U; i < N_ENTRIES; ++i) {
+      assert(entries[i].turtle);
+      assert(!strcmp(entries[i].turtle, expected[i]));
+      free(entries[i].turtle);
+      entries[i].turtle = NULL;
+    }
+
+    // Write a single document
+    char* document = NULL;
+    assert(!sratom_write_batch(shared->sratom,
+                               shared->unmap,
+                               base_uri,
+                               n_threads,
+                               N_ENTRIES,
+                               entries,
+                               &document));
+
+    assert(document);
+    assert(!strcmp(document, expected_document));
+    for (unsigned i = 0U; i < N_ENTRIES; ++i) {
+      assert(!entries[i].turtle);
+    }
+
+    free(document);
+  }
+
+  // Write an empty batch
+  char* document = NULL;
+  assert(!sratom_write_batch(
+    shared->sratom, shared->unmap, base_uri, 4U, 0U, entries, &document));
+  assert(document);
+  assert(!strcmp(document, ""));
+  free(document);
+
+  free(expected_document);
+  for (unsigned i = 0U; i < N_ENTRIES; ++i) {
+    free(expected[i]);
+  }
+}
+
+/// Arguments for a thread that reads every subject with sratom_read()
+typedef struct {
+  Sratom*                  sratom;
+  const LV2_Atom_Forge*    forge;
+  SordWorld*               world;
+  SordModel*               model;
+  const SordNode* const*   subjects;
+  const SratomForgeBuffer* expected;
+} ReadArgs;
+
+static void*
+run_read(void* const arg)
+{
+  const ReadArgs* const args  = (const ReadArgs*)arg;
+  LV2_Atom_Forge        forge = *args->forge;
+
+  SratomForgeBuffer buffer;
+  assert(!sratom_forge_buffer_init(&buffer, 0U));
+  lv2_atom_forge_set_sink(
+    &forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &buffer);
+
+  for (unsigned n = 0U; n < N_ITERATIONS / 8U; ++n) {
+    for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+      const SratomForgeBuffer* const expected = &args->expected[i];
+
+      sratom_forge_buffer_clear(&buffer);
+      sratom_read(
+        args->sratom, &forge, args->world, args->model, args->subjects[i]);
+
+      assert(buffer.len == expected->len);
+      assert(lv2_atom_equals((const LV2_Atom*)buffer.buf,
+                             (const LV2_Atom*)expected->buf));
+    }
+  }
+
+  sratom_forge_buffer_cleanup(&buffer);
+  return NULL;
+}
+
+/// Check that reading subjects in parallel matches reading them serially
+static void
+check_read_many(Sratom* const                sratom,
+                LV2_Atom_Forge* const        forge,
+                SordWorld* const             world,
+                SordModel* const             model,
+                const SordNode* const* const subjects)
+{
+  static const unsigned thread_counts[] = {0U, 1U, 2U, 3U, 8U, 64U};
+
+  // Read each subject serially for reference
+  SratomForgeBuffer expected[N_SUBJECTS];
+  for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+    assert(!sratom_forge_buffer_init(&expected[i], 0U));
+    lv2_atom_forge_set_sink(
+      forge, sratom_forge_buffer_sink, sratom_forge_buffer_deref, &expected[i]);
+    sratom_read(sratom, forge, world, model, subjects[i]);
+    assert(expected[i].len);
+  }
+
+  // Read every subject from several threads at once
+  const ReadArgs args = {sratom, forge, world, model, subjects, expected};
+  pthread_t      threads[N_THREADS];
+  for (unsigned i = 0U; i < N_THREADS; ++i) {
+    assert(!pthread_create(&threads[i], NULL, run_read, (void*)&args));
+  }
+
+  for (unsigned i = 0U; i < N_THREADS; ++i) {
+    assert(!pthread_join(threads[i], NULL));
+  }
+
+  SratomForgeBuffer buffers[N_SUBJECTS];
+  for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+    assert(!sratom_forge_buffer_init(&buffers[i], 0U));
+  }
+
+  for (size_t t = 0U; t < sizeof(thread_counts) / sizeof(unsigned); ++t) {
+    assert(!sratom_read_many(
+      sratom, world, model, thread_counts[t], N_SUBJECTS, subjects, buffers));
+
+    for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+      const LV2_Atom* const atom = (const LV2_Atom*)buffers[i].buf;
+      assert(buffers[i].len == expected[i].len);
+      assert(lv2_atom_equals(atom, (const LV2_Atom*)expected[i].buf));
+    }
+  }
+
+  for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+    sratom_forge_buffer_cleanup(&buffers[i]);
+    sratom_forge_buffer_cleanup(&expected[i]);
+  }
+}
+
+static void
+test_read_many(const Shared* const shared)
+{
+  // Write a document with many subjects with lists and nested objects
+  char   document[8192];
+  size_t len = (size_t)snprintf(
+    document,
+    sizeof(document),
+    "@prefix atom: <http://lv2plug.in/ns/ext/atom#> .\n"
+    "@prefix eg: <http://example.org/> .\n"
+    "@prefix rdf: <http://www.w3.org/1999/02/22-rdf-syntax-ns#> .\n");
+
+  for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+    len += (size_t)snprintf(
+      document + len,
+      sizeof(document) - len,
+      "eg:s%u a eg:Thing ;\n"
+      "  eg:index %u ;\n"
+      "  eg:list ( %u \"two\" eg:s%u ) ;\n"
+      "  eg:child [ a atom:Tuple ; rdf:value ( %u true ) ] .\n",
+      i,
+      i,
+      i,
+      (i + 1U) % N_SUBJECTS,
+      i * 2U);
+  }
+
+  assert(len < sizeof(document));
+
+  // Load it into a model
+  SordWorld* const  world  = sord_world_new();
+  SordModel* const  model  = sord_new(world, SORD_SPO, false);
+  SerdEnv* const    env    = serd_env_new(NULL);
+  SerdReader* const reader = sord_new_reader(model, env, SERD_TURTLE, NULL);
+  assert(!serd_reader_read_string(reader, USTR(document)));
+
+  SordNode* subjects[N_SUBJECTS];
+  for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+    char uri[32];
+    snprintf(uri, sizeof(uri), NS_EG "s%u", i);
+    subjects[i] = sord_new_uri(world, USTR(uri));
+  }
+
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, shared->map);
+
+  // Read with vocabulary nodes created for the call, then bound ones
+  Sratom* const sratom = shared->sratom;
+  check_read_many(
+    sratom, &forge, world, model, (const SordNode* const*)subjects);
+
+  sratom_bind_world(sratom, world);
+  check_read_many(
+    sratom, &forge, world, model, (const SordNode* const*)subjects);
+  sratom_unbind_world(sratom);
+
+  for (unsigned i = 0U; i < N_SUBJECTS; ++i) {
+    sord_node_free(world, subjects[i]);
+  }
+
+  serd_reader_free(reader);
+  serd_env_free(env);
+  sord_free(model);
+  sord_world_free(world);
+}
+
+int
+main(void)
+{
+  SharedUris uris = {PTHREAD_MUTEX_INITIALIZER, {NULL, 0}};
+
+  LV2_URID_Map   map   = {&uris, shared_map};
+  LV2_URID_Unmap unmap = {&uris, shared_unmap};
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, &map);
+
+  // Forge the atoms to write and read
+  LV2_Atom atom[144];
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)atom, sizeof(atom));
+  forge_test_object(&forge, &map, &uris.uris, 0U);
+
+  LV2_Atom             tuple[8];
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)tuple, sizeof(tuple));
+  lv2_atom_forge_tuple(&forge, &frame);
+  lv2_atom_forge_int(&forge, 1);
+  lv2_atom_forge_bool(&forge, true);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  // Configure a serializer to share between threads
+  SerdEnv* const env = serd_env_new(NULL);
+  serd_env_set_prefix_from_strings(env, USTR("eg"), USTR(NS_EG));
+  serd_env_set_prefix_from_strings(env, USTR("rdf"), USTR(NS_RDF));
+
+  Sratom* const sratom = sratom_new(&map);
+  sratom_set_env(sratom, env);
+  sratom_set_sink(sratom, base_uri, check_statement, NULL, NULL);
+
+  // Write the expected string in a single thread
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  char* const turtle = sratom_to_turtle(sratom,
+                                        &unmap,
+                                        base_uri,
+                                        &s,
+                                        &p,
+                                        atom->type,
+                                        atom->size,
+                                        LV2_ATOM_BODY_CONST(atom));
+
+  assert(turtle);
+
+  Shared shared = {sratom, &map, &unmap, atom, turtle, tuple};
+  test_concurrent(&shared);
+  test_write_batch(&shared);
+  test_read_many(&shared);
+
+  free(turtle);
+  sratom_free(sratom);
+  serd_env_free(env);
+  free_uris(&uris.uris);
+  pthread_mutex_destroy(&uris.mutex);
+  return 0;
+}
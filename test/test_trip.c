@@ -12,6 +12,7 @@
 #include <sratom/sratom.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,7 +30,12 @@ test_fail(const char* const msg)
 }
 
 static int
-test(SerdEnv* env, const char* base_uri, bool top_level, bool pretty_numbers)
+test(SerdEnv*               env,
+     const char*            base_uri,
+     bool                   top_level,
+     bool                   pretty_numbers,
+     SratomVectorEncoding   vector_encoding,
+     SratomSequenceEncoding sequence_encoding)
 {
   Uris           uris  = {NULL, 0};
   LV2_URID_Map   map   = {&uris, urid_map};
@@ -40,6 +46,8 @@ test(SerdEnv* env, const char* base_uri, bool top_level, bool pretty_numbers)
   Sratom* sratom = sratom_new(&map);
   sratom_set_env(sratom, env);
   sratom_set_pretty_numbers(sratom, pretty_numbers);
+  sratom_set_vector_encoding(sratom, vector_encoding);
+  sratom_set_sequence_encoding(sratom, sequence_encoding);
   sratom_set_object_mode(sratom,
                          top_level ? SRATOM_OBJECT_MODE_BLANK_SUBJECT
                                    : SRATOM_OBJECT_MODE_BLANK);
@@ -106,25 +114,104 @@ test(SerdEnv* env, const char* base_uri, bool top_level, bool pretty_numbers)
   return 0;
 }
 
+/// Write a number with pretty numbers and check the type it is read back as
 static int
-test_env(SerdEnv* env)
+check_pretty_number(Sratom* const         sratom,
+                    LV2_URID_Unmap* const unmap,
+                    const LV2_Atom* const atom)
 {
-  if (test(env, "file:///tmp/base/", false, false) || //
-      test(env, "file:///tmp/base/", true, false) ||  //
-      test(env, "file:///tmp/base/", false, true) ||  //
-      test(env, "file:///tmp/base/", true, true) ||   //
-      test(env, "http://example.org/", true, true)) {
+  SerdNode s = serd_node_from_string(SERD_URI, USTR("http://example.org/obj"));
+  SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_RDF "value"));
+
+  char* const str = sratom_to_turtle(sratom,
+                                     unmap,
+                                     "http://example.org/",
+                                     &s,
+                                     &p,
+                                     atom->type,
+                                     atom->size,
+                                     LV2_ATOM_BODY_CONST(atom));
+
+  LV2_Atom* const parsed =
+    sratom_from_turtle(sratom, "http://example.org/", &s, &p, str);
+
+  const bool equal = parsed && lv2_atom_equals(parsed, atom);
+
+  free(parsed);
+  free(str);
+  return equal ? 0 : test_fail("Pretty number read back as another type");
+}
+
+static int
+test_pretty_numbers(void)
+{
+  static const float  floats[]  = {3.0f, 0.25f, 1e-7f, 1.5e20f};
+  static const double doubles[] = {1e-300, 2.5e300};
+
+  Uris           uris  = {NULL, 0};
+  LV2_URID_Map   map   = {&uris, urid_map};
+  LV2_URID_Unmap unmap = {&uris, urid_unmap};
+  LV2_Atom_Forge forge;
+  lv2_atom_forge_init(&forge, &map);
+
+  Sratom* sratom = sratom_new(&map);
+  sratom_set_pretty_numbers(sratom, true);
+
+  int      st = 0;
+  LV2_Atom buf[4];
+  for (size_t i = 0U; !st && i < sizeof(floats) / sizeof(float); ++i) {
+    lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+    lv2_atom_forge_float(&forge, floats[i]);
+    st = check_pretty_number(sratom, &unmap, buf);
+  }
+
+  // Doubles that need an exponent are written bare, and stay doubles
+  for (size_t i = 0U; !st && i < sizeof(doubles) / sizeof(double); ++i) {
+    lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+    lv2_atom_forge_double(&forge, doubles[i]);
+    st = check_pretty_number(sratom, &unmap, buf);
+  }
+
+  sratom_free(sratom);
+  free_uris(&uris);
+  return st;
+}
+
+static int
+test_env(SerdEnv* env, SratomVectorEncoding vec, SratomSequenceEncoding seq)
+{
+  if (test(env, "file:///tmp/base/", false, false, vec, seq) || //
+      test(env, "file:///tmp/base/", true, false, vec, seq) ||  //
+      test(env, "file:///tmp/base/", false, true, vec, seq) ||  //
+      test(env, "file:///tmp/base/", true, true, vec, seq) ||   //
+      test(env, "http://example.org/", true, true, vec, seq)) {
     return 1;
   }
 
   return 0;
 }
 
+static int
+test_encodings(SerdEnv* env)
+{
+  static const SratomSequenceEncoding list = SRATOM_SEQUENCE_ENCODING_LIST;
+
+  return test_env(env, SRATOM_VECTOR_ENCODING_LIST, list) ||
+         test_env(env, SRATOM_VECTOR_ENCODING_TEXT, list) ||
+         test_env(env, SRATOM_VECTOR_ENCODING_BASE64, list) ||
+         test_env(
+           env, SRATOM_VECTOR_ENCODING_LIST, SRATOM_SEQUENCE_ENCODING_COMPACT);
+}
+
 int
 main(void)
 {
+  if (test_pretty_numbers()) {
+    return 1;
+  }
+
   // Test with no environment
-  if (test_env(NULL)) {
+  if (test_encodings(NULL)) {
     return 1;
   }
 
@@ -133,7 +220,7 @@ main(void)
   serd_env_set_prefix_from_strings(
     env, (const uint8_t*)"eg", (const uint8_t*)"http://example.org/");
 
-  test_env(env);
+  test_encodings(env);
   serd_env_free(env);
 
   return 0;
@@ -8,16 +8,21 @@
 
 #include <lv2/atom/atom.h>
 #include <lv2/atom/forge.h>
+#include <lv2/atom/util.h>
 #include <lv2/urid/urid.h>
 #include <serd/serd.h>
 #include <sratom/sratom.h>
 
 #include <assert.h>
+#include <math.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define NS_EG "http://example.org/"
+#define NS_RDF "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
 
 #define USTR(s) ((const uint8_t*)(s))
 
@@ -95,7 +100,7 @@ test_bare_literal(void)
   check_turtle(sratom,
                &unmap,
                buf,
-               "<http://example.org/s>\n\t<http://example.org/p> \"test\" .\n");
+               "<s>\n\t<p> \"test\" .\n");
 
   sratom_free(sratom);
   free_uris(&uris);
@@ -119,13 +124,636 @@ test_uri(void)
   check_turtle(sratom,
                &unmap,
                buf,
-               "<http://example.org/s>\n\t<http://example.org/p> "
-               "<http://example.org/o> .\n");
+               "<s>\n\t<p> "
+               "<o> .\n");
 
   sratom_free(sratom);
   free_uris(&uris);
 }
 
+// Check that paths are escaped like serd_node_new_file_uri()
+static void
+test_path(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[8];
+  lv2_atom_forge_init(&forge, &map);
+
+  // Backslashes are only separators in Windows paths
+  static const char* const path = "/a\\b c%";
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_path(&forge, path, strlen(path));
+  check_turtle(sratom,
+               &unmap,
+               buf,
+               "<s>\n\t<p> "
+               "<file:///a%5Cb%20c%%> .\n");
+
+  static const char* const windows_path = "C:\\a\\b";
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  lv2_atom_forge_path(&forge, windows_path, strlen(windows_path));
+  check_turtle(sratom,
+               &unmap,
+               buf,
+               "<s>\n\t<p> "
+               "<file:///C:/a/b> .\n");
+
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_nested(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[16];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  lv2_atom_forge_string(&forge, "say \"hi\"", 8);
+  lv2_atom_forge_bool(&forge, true);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  check_turtle(sratom,
+               &unmap,
+               buf,
+               "<s>\n"
+               "\t<p> [\n"
+               "\t\ta <http://lv2plug.in/ns/ext/atom#Tuple> ;\n"
+               "\t\t<http://www.w3.org/1999/02/22-rdf-syntax-ns#value> (\n"
+               "\t\t\t\"\"\"say \"hi\\\"\"\"\"\n"
+               "\t\t\ttrue\n"
+               "\t\t)\n"
+               "\t] .\n");
+
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+// Check that URIs in the base directory are written relative to it
+static void
+test_relative_uris(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[32];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  static const char* const objects[] = {NS_EG "dir/o",
+                                        NS_EG "dir/sub/o",
+                                        NS_EG "dir/a:b",
+                                        NS_EG "dir/?q",
+                                        NS_EG "o"};
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  for (size_t i = 0U; i < sizeof(objects) / sizeof(objects[0]); ++i) {
+    lv2_atom_forge_uri(&forge, objects[i], (uint32_t)strlen(objects[i]));
+  }
+  lv2_atom_forge_pop(&forge, &frame);
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "dir/s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  char* const ttl = sratom_to_turtle(sratom,
+                                     &unmap,
+                                     NS_EG "dir/base",
+                                     &s,
+                                     &p,
+                                     buf->type,
+                                     buf->size,
+                                     LV2_ATOM_BODY(buf));
+
+  // Other URIs, and those that would mean something else, are written whole
+  assert(ttl);
+  assert(!strcmp(ttl,
+                 "<s>\n"
+                 "\t<http://example.org/p> [\n"
+                 "\t\ta <http://lv2plug.in/ns/ext/atom#Tuple> ;\n"
+                 "\t\t<http://www.w3.org/1999/02/22-rdf-syntax-ns#value> (\n"
+                 "\t\t\t<o>\n"
+                 "\t\t\t<sub/o>\n"
+                 "\t\t\t<http://example.org/dir/a:b>\n"
+                 "\t\t\t<http://example.org/dir/?q>\n"
+                 "\t\t\t<http://example.org/o>\n"
+                 "\t\t)\n"
+                 "\t] .\n"));
+
+  free(ttl);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static char*
+to_string(Sratom* const         sratom,
+          LV2_URID_Unmap* const unmap,
+          const LV2_Atom* const atom,
+          const SerdSyntax      syntax,
+          const SerdStyle       style)
+{
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  return sratom_to_string(sratom,
+                          unmap,
+                          NS_EG,
+                          &s,
+                          &p,
+                          atom->type,
+                          atom->size,
+                          LV2_ATOM_BODY_CONST(atom),
+                          syntax,
+                          style);
+}
+
+static void
+test_syntaxes(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[16];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  lv2_atom_forge_string(&forge, "say \"hi\"", 8);
+  lv2_atom_forge_bool(&forge, true);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  // Every statement is written in full, with each list node linked once
+  char* const nt = to_string(sratom, &unmap, buf, SERD_NTRIPLES, 0);
+  assert(nt);
+  assert(!strcmp(nt,
+                 "<http://example.org/s> <http://example.org/p> _:t0 .\n"
+                 "_:t0 <http://www.w3.org/1999/02/22-rdf-syntax-ns#type> "
+                 "<http://lv2plug.in/ns/ext/atom#Tuple> .\n"
+                 "_:t0 <http://www.w3.org/1999/02/22-rdf-syntax-ns#value> "
+                 "_:l1 .\n"
+                 "_:l1 <http://www.w3.org/1999/02/22-rdf-syntax-ns#first> "
+                 "\"say \\\"hi\\\"\" .\n"
+                 "_:l1 <http://www.w3.org/1999/02/22-rdf-syntax-ns#rest> "
+                 "_:l2 .\n"
+                 "_:l2 <http://www.w3.org/1999/02/22-rdf-syntax-ns#first> "
+                 "\"true\"^^<http://www.w3.org/2001/XMLSchema#boolean> .\n"
+                 "_:l2 <http://www.w3.org/1999/02/22-rdf-syntax-ns#rest> "
+                 "<http://www.w3.org/1999/02/22-rdf-syntax-ns#nil> .\n"));
+
+  // Labels are numbered per document, so writing again gives the same output
+  char* const nt2 = to_string(sratom, &unmap, buf, SERD_NTRIPLES, 0);
+  assert(nt2);
+  assert(!strcmp(nt2, nt));
+
+  // Statements are in the default graph, so N-Quads is the same
+  char* const nq = to_string(sratom, &unmap, buf, SERD_NQUADS, 0);
+  assert(nq);
+  assert(!strcmp(nq, nt));
+
+  // Turtle without abbreviation still uses short forms for terms
+  char* const ttl = to_string(sratom, &unmap, buf, SERD_TURTLE, 0);
+  assert(ttl);
+  assert(strstr(ttl, "_:t0 a <http://lv2plug.in/ns/ext/atom#Tuple> .\n"));
+  assert(strstr(ttl, " true .\n_:l2 "));
+  assert(strstr(ttl, " () .\n"));
+  assert(!strchr(ttl, '['));
+
+  // Unsupported syntax
+  assert(!to_string(sratom, &unmap, buf, (SerdSyntax)0, 0));
+
+  free(ttl);
+  free(nq);
+  free(nt2);
+  free(nt);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_ntriples_round_trip(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[1024];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  forge_test_object(&forge, &map, &uris, 0U);
+
+  char* const nt = to_string(sratom, &unmap, buf, SERD_NTRIPLES, 0);
+  assert(nt);
+
+  // Every line is a complete statement
+  for (const char* line = nt; *line;) {
+    const char* const end = strchr(line, '\n');
+    assert(end);
+    assert(end - line > 2);
+    assert(!strncmp(end - 2, " .", 2));
+    assert(line[0] == '<' || line[0] == '_');
+    line = end + 1;
+  }
+
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  LV2_Atom* const parsed = sratom_from_turtle(sratom, NS_EG, &s, &p, nt);
+  assert(parsed);
+  assert(lv2_atom_equals(parsed, buf));
+
+  free(parsed);
+  free(nt);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+typedef struct {
+  Uris*    uris;
+  unsigned n_unmaps;
+} CountingUris;
+
+static const char*
+counting_unmap(LV2_URID_Unmap_Handle handle, const LV2_URID urid)
+{
+  CountingUris* const counting = (CountingUris*)handle;
+  ++counting->n_unmaps;
+  return urid_unmap(counting->uris, urid);
+}
+
+static void
+test_numbers(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[16];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  lv2_atom_forge_float(&forge, 0.1f);
+  lv2_atom_forge_double(&forge, 1.0e-7);
+  lv2_atom_forge_double(&forge, -(double)INFINITY);
+  lv2_atom_forge_long(&forge, INT64_MIN);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  // Numbers are written with the fewest digits that read back exactly
+  check_turtle(sratom,
+               &unmap,
+               buf,
+               "<s>\n"
+               "\t<p> [\n"
+               "\t\ta <http://lv2plug.in/ns/ext/atom#Tuple> ;\n"
+               "\t\t<http://www.w3.org/1999/02/22-rdf-syntax-ns#value> (\n"
+               "\t\t\t\"0.1\"^^<http://www.w3.org/2001/XMLSchema#float>\n"
+               "\t\t\t1.0E-7\n"
+               "\t\t\t\"-INF\"^^<http://www.w3.org/2001/XMLSchema#double>\n"
+               "\t\t\t\"-9223372036854775808\"^^"
+               "<http://www.w3.org/2001/XMLSchema#long>\n"
+               "\t\t)\n"
+               "\t] .\n");
+
+  // Pretty numbers keep special values typed
+  sratom_set_pretty_numbers(sratom, true);
+  check_turtle(sratom,
+               &unmap,
+               buf,
+               "<s>\n"
+               "\t<p> [\n"
+               "\t\ta <http://lv2plug.in/ns/ext/atom#Tuple> ;\n"
+               "\t\t<http://www.w3.org/1999/02/22-rdf-syntax-ns#value> (\n"
+               "\t\t\t0.1\n"
+               "\t\t\t1.0E-7\n"
+               "\t\t\t\"-INF\"^^<http://www.w3.org/2001/XMLSchema#double>\n"
+               "\t\t\t-9223372036854775808\n"
+               "\t\t)\n"
+               "\t] .\n");
+
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_unmap_cache(void)
+{
+  Uris           uris     = {NULL, 0};
+  CountingUris   counting = {&uris, 0U};
+  LV2_URID_Map   map      = {&uris, urid_map};
+  LV2_URID_Unmap unmap    = {&counting, counting_unmap};
+  const LV2_URID eg_a     = urid_map(&uris, NS_EG "a");
+  const LV2_URID eg_b     = urid_map(&uris, NS_EG "b");
+  const LV2_URID eg_Type  = urid_map(&uris, NS_EG "Type");
+  Sratom* const  sratom   = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[16];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_object(&forge, &frame, 0, eg_Type);
+  lv2_atom_forge_key(&forge, eg_a);
+  lv2_atom_forge_urid(&forge, eg_b);
+  lv2_atom_forge_key(&forge, eg_b);
+  lv2_atom_forge_urid(&forge, eg_a);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  static const char* const expected =
+    "<s>\n"
+    "\t<p> [\n"
+    "\t\ta <Type> ;\n"
+    "\t\t<a> <b> ;\n"
+    "\t\t<b> <a>\n"
+    "\t] .\n";
+
+  // Each URID is only unmapped the first time it's written
+  check_turtle(sratom, &unmap, buf, expected);
+  assert(counting.n_unmaps == 3U);
+  check_turtle(sratom, &unmap, buf, expected);
+  assert(counting.n_unmaps == 3U);
+
+  // Using a different unmap flushes the cache
+  CountingUris   other       = {&uris, 0U};
+  LV2_URID_Unmap other_unmap = {&other, counting_unmap};
+  check_turtle(sratom, &other_unmap, buf, expected);
+  assert(other.n_unmaps == 3U);
+
+  // Clearing the cache unmaps everything again with the same unmap
+  sratom_clear_unmap_cache(sratom);
+  check_turtle(sratom, &other_unmap, buf, expected);
+  assert(other.n_unmaps == 6U);
+  check_turtle(sratom, &other_unmap, buf, expected);
+  assert(other.n_unmaps == 6U);
+
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static char*
+to_turtle(Sratom* const         sratom,
+          LV2_URID_Unmap* const unmap,
+          const LV2_Atom* const atom)
+{
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  return sratom_to_turtle(sratom,
+                          unmap,
+                          "file:///tmp/base/",
+                          &s,
+                          &p,
+                          atom->type,
+                          atom->size,
+                          LV2_ATOM_BODY(atom));
+}
+
+static void
+test_temporaries(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[1024];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  forge_test_object(&forge, &map, &uris, 0U);
+
+  // A chunk much larger than the arena's initial block
+  const uint32_t  size  = 8192U;
+  LV2_Atom* const chunk = (LV2_Atom*)malloc(sizeof(LV2_Atom) + size);
+  uint8_t* const  body  = (uint8_t*)(chunk + 1);
+
+  chunk->size = size;
+  chunk->type = forge.Chunk;
+  for (uint32_t i = 0U; i < size; ++i) {
+    body[i] = (uint8_t)i;
+  }
+
+  // Temporaries are reused between calls without changing the output
+  char* const first       = to_turtle(sratom, &unmap, buf);
+  char* const first_chunk = to_turtle(sratom, &unmap, chunk);
+  assert(first);
+  assert(first_chunk);
+  for (unsigned i = 0U; i < 3U; ++i) {
+    char* const ttl       = to_turtle(sratom, &unmap, buf);
+    char* const chunk_ttl = to_turtle(sratom, &unmap, chunk);
+    assert(ttl && !strcmp(ttl, first));
+    assert(chunk_ttl && !strcmp(chunk_ttl, first_chunk));
+    free(chunk_ttl);
+    free(ttl);
+  }
+
+  free(first_chunk);
+  free(first);
+  free(chunk);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+typedef struct {
+  char*  buf;       ///< Everything written so far
+  size_t len;       ///< Length of buf in bytes
+  size_t max_write; ///< Length of the largest single write
+  size_t limit;     ///< Number of bytes to accept before failing
+} OutputContext;
+
+static size_t
+on_output(const void* const buf, const size_t len, void* const stream)
+{
+  OutputContext* const ctx = (OutputContext*)stream;
+  if (ctx->len + len > ctx->limit) {
+    return 0U;
+  }
+
+  ctx->buf = (char*)realloc(ctx->buf, ctx->len + len + 1U);
+  memcpy(ctx->buf + ctx->len, buf, len);
+  ctx->len += len;
+  ctx->buf[ctx->len] = '\0';
+  if (len > ctx->max_write) {
+    ctx->max_write = len;
+  }
+
+  return len;
+}
+
+static void
+check_stream(Sratom* const         sratom,
+             LV2_URID_Unmap* const unmap,
+             const LV2_Atom* const atom)
+{
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+
+  char* const expected = to_turtle(sratom, unmap, atom);
+  assert(expected);
+
+  // Written in small pieces to the sink
+  OutputContext ctx = {NULL, 0U, 0U, SIZE_MAX};
+  assert(!sratom_write_to_stream(sratom,
+                                 unmap,
+                                 "file:///tmp/base/",
+                                 &s,
+                                 &p,
+                                 atom->type,
+                                 atom->size,
+                                 LV2_ATOM_BODY_CONST(atom),
+                                 on_output,
+                                 &ctx));
+
+  assert(ctx.buf);
+  assert(!strcmp(ctx.buf, expected));
+  assert(ctx.max_write <= 4096U);
+
+  // Written to a file
+  FILE* const file = tmpfile();
+  assert(file);
+  assert(!sratom_write_to_file(sratom,
+                               unmap,
+                               "file:///tmp/base/",
+                               &s,
+                               &p,
+                               atom->type,
+                               atom->size,
+                               LV2_ATOM_BODY_CONST(atom),
+                               file));
+
+  const size_t len  = strlen(expected);
+  char* const  text = (char*)calloc(len + 2U, 1U);
+  rewind(file);
+  assert(fread(text, 1U, len + 1U, file) == len);
+  assert(!strcmp(text, expected));
+  free(text);
+  fclose(file);
+
+  // Failing to write part of the output is an error
+  for (size_t limit = 0U; limit < ctx.len; limit += ctx.len / 7U + 1U) {
+    OutputContext short_ctx = {NULL, 0U, 0U, limit};
+    assert(sratom_write_to_stream(sratom,
+                                  unmap,
+                                  "file:///tmp/base/",
+                                  &s,
+                                  &p,
+                                  atom->type,
+                                  atom->size,
+                                  LV2_ATOM_BODY_CONST(atom),
+                                  on_output,
+                                  &short_ctx));
+    free(short_ctx.buf);
+  }
+
+  free(ctx.buf);
+  free(expected);
+}
+
+static void
+test_write_to_stream(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[1024];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+  forge_test_object(&forge, &map, &uris, 0U);
+
+  // A chunk with an encoding much larger than the output buffer
+  const uint32_t  size  = 262144U;
+  LV2_Atom* const chunk = (LV2_Atom*)malloc(sizeof(LV2_Atom) + size);
+  uint8_t* const  body  = (uint8_t*)(chunk + 1);
+
+  chunk->size = size;
+  chunk->type = forge.Chunk;
+  for (uint32_t i = 0U; i < size; ++i) {
+    body[i] = (uint8_t)(i * 7U);
+  }
+
+  check_stream(sratom, &unmap, buf);
+  check_stream(sratom, &unmap, chunk);
+
+  free(chunk);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
+static void
+test_chunk_lines(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  Sratom* const  sratom = sratom_new(&map);
+
+  // Three full lines of zeros, which are 76 'A' characters each
+  LV2_Atom chunk[23];
+  memset(chunk, 0, sizeof(chunk));
+  chunk->size = 3U * 57U;
+  chunk->type = map.map(map.handle, LV2_ATOM__Chunk);
+
+  char line[77];
+  memset(line, 'A', 76U);
+  line[76] = '\0';
+
+  char expected[512];
+  snprintf(expected,
+           sizeof(expected),
+           "<http://example.org/s> <http://example.org/p> \"%s\\n%s\\n%s\""
+           "^^<http://www.w3.org/2001/XMLSchema#base64Binary> .\n",
+           line,
+           line,
+           line);
+
+  char* const nt = to_string(sratom, &unmap, chunk, SERD_NTRIPLES, 0);
+  assert(nt);
+  assert(!strcmp(nt, expected));
+
+  snprintf(expected,
+           sizeof(expected),
+           "\"\"\"%s\n%s\n%s\"\"\"",
+           line,
+           line,
+           line);
+  char* const ttl = to_turtle(sratom, &unmap, chunk);
+  assert(ttl);
+  assert(strstr(ttl, expected));
+
+  free(ttl);
+  free(nt);
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
 static void
 test_bad_language(void)
 {
@@ -157,6 +785,85 @@ test_bad_language(void)
   free_uris(&uris);
 }
 
+/// The state of a list written to on_list_statement()
+typedef struct {
+  char     node[16]; ///< Label of the next list node, or empty
+  unsigned n_elems;  ///< Number of elements so far
+  bool     ended;    ///< True if rdf:nil has been reached
+} ListContext;
+
+static SerdStatus
+on_list_statement(void* const              handle,
+                  const SerdStatementFlags flags,
+                  const SerdNode* const    graph,
+                  const SerdNode* const    subject,
+                  const SerdNode* const    predicate,
+                  const SerdNode* const    object,
+                  const SerdNode* const    object_datatype,
+                  const SerdNode* const    object_lang)
+{
+  (void)flags;
+  (void)graph;
+  (void)object_datatype;
+  (void)object_lang;
+
+  ListContext* const ctx  = (ListContext*)handle;
+  const char* const  pred = (const char*)predicate->buf;
+
+  if (!strcmp(pred, NS_RDF "first")) {
+    assert(!strcmp((const char*)subject->buf, ctx->node));
+    ++ctx->n_elems;
+  } else if (!strcmp(pred, NS_RDF "rest") && object->type == SERD_URI) {
+    assert(!strcmp((const char*)subject->buf, ctx->node));
+    assert(!strcmp((const char*)object->buf, NS_RDF "nil"));
+    ctx->ended = true;
+  } else if (object->type == SERD_BLANK) {
+    // The first or next list node, which must be new
+    assert(strcmp((const char*)subject->buf, (const char*)object->buf));
+    assert(strcmp((const char*)object->buf, ctx->node));
+    assert(object->n_bytes < sizeof(ctx->node));
+    memcpy(ctx->node, object->buf, object->n_bytes + 1U);
+  }
+
+  return SERD_SUCCESS;
+}
+
+static void
+test_list_links(void)
+{
+  Uris           uris   = {NULL, 0};
+  LV2_URID_Map   map    = {&uris, urid_map};
+  LV2_URID_Unmap unmap  = {&uris, urid_unmap};
+  ListContext    ctx    = {{0}, 0U, false};
+  Sratom* const  sratom = sratom_new(&map);
+
+  sratom_set_sink(sratom, NS_EG, on_list_statement, NULL, &ctx);
+
+  LV2_Atom_Forge forge;
+  LV2_Atom       buf[16];
+  lv2_atom_forge_init(&forge, &map);
+  lv2_atom_forge_set_buffer(&forge, (uint8_t*)buf, sizeof(buf));
+
+  LV2_Atom_Forge_Frame frame;
+  lv2_atom_forge_tuple(&forge, &frame);
+  lv2_atom_forge_int(&forge, 1);
+  lv2_atom_forge_int(&forge, 2);
+  lv2_atom_forge_int(&forge, 3);
+  lv2_atom_forge_pop(&forge, &frame);
+
+  // Each list node is linked to the next by rdf:rest, ending with rdf:nil
+  const SerdNode s = serd_node_from_string(SERD_URI, USTR(NS_EG "s"));
+  const SerdNode p = serd_node_from_string(SERD_URI, USTR(NS_EG "p"));
+  assert(!sratom_write(
+    sratom, &unmap, 0U, &s, &p, buf->type, buf->size, LV2_ATOM_BODY(buf)));
+
+  assert(ctx.n_elems == 3U);
+  assert(ctx.ended);
+
+  sratom_free(sratom);
+  free_uris(&uris);
+}
+
 static void
 test_bad_vector_child_size(void)
 {
@@ -229,7 +936,18 @@ main(void)
 {
   test_bare_literal();
   test_uri();
+  test_path();
+  test_relative_uris();
+  test_nested();
+  test_syntaxes();
+  test_ntriples_round_trip();
+  test_numbers();
+  test_unmap_cache();
+  test_temporaries();
+  test_write_to_stream();
+  test_chunk_lines();
   test_bad_language();
+  test_list_links();
   test_bad_vector_child_size();
   test_write_errors();
   return 0;